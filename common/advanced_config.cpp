@@ -75,6 +75,7 @@ static const wxChar ShowRouterDebugGraphics[] = wxT( "ShowRouterDebugGraphics" )
 static const wxChar EnableRouterDump[] = wxT( "EnableRouterDump" );
 static const wxChar HyperZoom[] = wxT( "HyperZoom" );
 static const wxChar CompactFileSave[] = wxT( "CompactSave" );
+static const wxChar BoardFillCache[] = wxT( "BoardFillCache" );
 static const wxChar DrawArcAccuracy[] = wxT( "DrawArcAccuracy" );
 static const wxChar DrawArcCenterStartEndMaxAngle[] = wxT( "DrawArcCenterStartEndMaxAngle" );
 static const wxChar MaxTangentTrackAngleDeviation[] = wxT( "MaxTangentTrackAngleDeviation" );
@@ -253,6 +254,7 @@ ADVANCED_CFG::ADVANCED_CFG()
     m_ShowEventCounters         = false;
     m_AllowManualCanvasScale    = false;
     m_CompactSave               = false;
+    m_BoardFillCache            = false;
     m_UpdateUIEventInterval     = 0;
     m_ShowRepairSchematic       = false;
     m_EnableDesignBlocks        = true;
@@ -397,6 +399,9 @@ void ADVANCED_CFG::loadSettings( wxConfigBase& aCfg )
     configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::CompactFileSave,
                                                 &m_CompactSave, m_CompactSave ) );
 
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::BoardFillCache,
+                                                &m_BoardFillCache, m_BoardFillCache ) );
+
     configParams.push_back( new PARAM_CFG_DOUBLE( true, AC_KEYS::DrawArcAccuracy,
                                                   &m_DrawArcAccuracy, m_DrawArcAccuracy,
                                                   0.0, 100000.0 ) );
@@ -22,6 +22,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <algorithm>
 #include <charconv>
 #include <cstdarg>
 #include <cstdio>
@@ -29,6 +30,7 @@
 #include <cctype>
 
 #include <dsnlexer.h>
+#include <math/util.h>
 #include <wx/translation.h>
 
 #define FMT_CLIPBOARD       _( "clipboard" )
@@ -382,6 +384,71 @@ void DSNLEXER::NeedRIGHT()
 }
 
 
+void DSNLEXER::SkipList()
+{
+    const char* cur = next;
+    int         depth = 1;
+
+    prevTok = curTok;
+
+    while( true )
+    {
+        if( cur >= limit )
+        {
+            if( readLine() == 0 )
+            {
+                curTok = DSN_EOF;
+                curOffset = 0;
+                next = start;
+                Expecting( DSN_RIGHT );
+            }
+
+            cur = start;
+
+            while( cur < limit && isSpace( *cur ) )
+                ++cur;
+
+            // Comment lines, as in NextTok()
+            if( cur < limit && *cur == '#' )
+                cur = limit;
+
+            continue;
+        }
+
+        char c = *cur++;
+
+        if( c == '(' )
+        {
+            ++depth;
+        }
+        else if( c == ')' )
+        {
+            if( --depth == 0 )
+                break;
+        }
+        else if( c == stringDelimiter )
+        {
+            // Quoted strings do not span lines, and may hold parentheses
+            while( cur < limit && *cur != stringDelimiter )
+            {
+                if( !specctraMode && *cur == '\\' && cur + 1 < limit )
+                    ++cur;
+
+                ++cur;
+            }
+
+            if( cur < limit )
+                ++cur;
+        }
+    }
+
+    curText = ')';
+    curTok = DSN_RIGHT;
+    curOffset = cur - 1 - start;
+    next = cur;
+}
+
+
 void DSNLEXER::NeedBAR()
 {
     int tok = NextTok();
@@ -788,11 +855,12 @@ L_read:
     }           // specctraMode
 
     // non-quoted token, read it into curText.
-    curText.clear();
-
     head = cur;
+
     while( head<limit && !isSep( *head ) )
-        curText += *head++;
+        ++head;
+
+    curText.assign( cur, head );
 
     if( isNumber( curText.c_str(), curText.c_str() + curText.size() ) )
     {
@@ -899,3 +967,78 @@ double DSNLEXER::parseDouble()
     return dval;
 #endif
 }
+
+
+int DSNLEXER::parseScaledInt( double aScale, double aLimit )
+{
+    static constexpr double powersOf10[] = { 1, 10, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9 };
+
+    // A uint64_t holds any 19 digit number
+    static constexpr int maxDigits = 19;
+
+    int decimals = -1;
+
+    for( int ii = 0; ii < (int) std::size( powersOf10 ); ++ii )
+    {
+        if( powersOf10[ii] == aScale )
+            decimals = ii;
+    }
+
+    const char* cp = curText.c_str();
+
+    while( std::isspace( (unsigned char) *cp ) )
+        cp++;
+
+    bool negative = *cp == '-';
+
+    if( negative )
+        cp++;
+
+    uint64_t mantissa = 0;
+    int      digits = 0;        // significant digits in the mantissa
+    int      fracDigits = 0;
+    bool     anyDigit = false;
+    bool     roundUp = false;
+
+    for( ; *cp >= '0' && *cp <= '9'; ++cp, anyDigit = true )
+    {
+        if( mantissa != 0 || *cp != '0' )
+            digits++;
+
+        mantissa = mantissa * 10 + ( *cp - '0' );
+
+        if( digits + decimals > maxDigits )
+            break;
+    }
+
+    if( *cp == '.' )
+    {
+        for( ++cp; *cp >= '0' && *cp <= '9'; ++cp, anyDigit = true )
+        {
+            // Only the first digit past the internal unit matters for rounding half away
+            // from zero
+            if( fracDigits == decimals )
+                roundUp = *cp >= '5';
+
+            if( fracDigits < decimals )
+                mantissa = mantissa * 10 + ( *cp - '0' );
+
+            if( fracDigits <= decimals )
+                fracDigits++;
+        }
+    }
+
+    // Exponents, signs from_chars() would reject, overflows, etc.
+    if( decimals < 0 || *cp || !anyDigit )
+        return KiROUND( std::clamp( parseDouble() * aScale, -aLimit, aLimit ) );
+
+    for( ; fracDigits < decimals; ++fracDigits )
+        mantissa *= 10;
+
+    if( roundUp )
+        mantissa++;
+
+    double value = negative ? -double( mantissa ) : double( mantissa );
+
+    return KiROUND( std::clamp( value, -aLimit, aLimit ) );
+}
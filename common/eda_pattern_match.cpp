@@ -476,23 +476,29 @@ bool EDA_COMBINED_MATCHER::StartsWith( const wxString& aTerm )
 }
 
 
+void SEARCH_TERM::Normalize()
+{
+    if( Normalized )
+        return;
+
+    Text = Text.MakeLower().Trim( false ).Trim( true );
+
+    // Don't cause KiCad to hang if someone accidentally pastes the PCB or schematic
+    // into the search box.
+    if( Text.Length() > 1000 )
+        Text = Text.Left( 1000 );
+
+    Normalized = true;
+}
+
+
 int EDA_COMBINED_MATCHER::ScoreTerms( std::vector<SEARCH_TERM>& aWeightedTerms )
 {
     int score = 0;
 
     for( SEARCH_TERM& term : aWeightedTerms )
     {
-        if( !term.Normalized )
-        {
-            term.Text = term.Text.MakeLower().Trim( false ).Trim( true );
-
-            // Don't cause KiCad to hang if someone accidentally pastes the PCB or schematic
-            // into the search box.
-            if( term.Text.Length() > 1000 )
-                term.Text = term.Text.Left( 1000 );
-
-            term.Normalized = true;
-        }
+        term.Normalize();
 
         int found_pos = EDA_PATTERN_NOT_FOUND;
         int matchers_fired = 0;
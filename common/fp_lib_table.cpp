@@ -372,6 +372,18 @@ const FOOTPRINT* FP_LIB_TABLE::GetEnumeratedFootprint( const wxString& aNickname
 }
 
 
+bool FP_LIB_TABLE::GetFootprintSummary( const wxString& aNickname,
+                                        const wxString& aFootprintName,
+                                        FOOTPRINT_SUMMARY& aSummary )
+{
+    const FP_LIB_TABLE_ROW* row = FindRow( aNickname, true );
+    wxASSERT( row->plugin );
+
+    return row->plugin->GetFootprintSummary( row->GetFullURI( true ), aFootprintName, aSummary,
+                                             row->GetProperties() );
+}
+
+
 bool FP_LIB_TABLE::FootprintExists( const wxString& aNickname, const wxString& aFootprintName )
 {
     try
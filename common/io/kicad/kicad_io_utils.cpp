@@ -66,6 +66,30 @@ void FormatStreamData( OUTPUTFORMATTER& aOut, const wxStreamBuffer& aStream )
 }
 
 
+// Configuration
+static constexpr char quoteChar = '"';
+static constexpr char indentChar = '\t';
+static constexpr int  indentSize = 1;
+
+// In order to visually compress PCB files, it is helpful to special-case long lists of (xy ...)
+// lists, which we allow to exist on a single line until we reach column 99.
+static constexpr int  xySpecialCaseColumnLimit = 99;
+
+// If whitespace occurs inside a list after this threshold, it will be converted into a newline
+// and the indentation will be increased.  This is mainly used for image and group objects,
+// which contain potentially long sets of string tokens within a single list.
+static constexpr int  consecutiveTokenWrapThreshold = 72;
+
+// The longest keyword of the lists kept on a single line in compact mode
+static constexpr size_t shortFormKeywordMaxLength = 6;
+
+
+static bool isWhitespace( const char aChar )
+{
+    return ( aChar == ' ' || aChar == '\t' || aChar == '\n' || aChar == '\r' );
+}
+
+
 /*
  * Formatting rules:
  * - All extra (non-indentation) whitespace is trimmed
@@ -88,218 +112,222 @@ void FormatStreamData( OUTPUTFORMATTER& aOut, const wxStreamBuffer& aStream )
  */
 void Prettify( std::string& aSource, bool aCompactSave )
 {
-    // Configuration
-    const char quoteChar = '"';
-    const char indentChar = '\t';
-    const int  indentSize = 1;
+    PRETTIFIER  prettifier( aCompactSave );
+    std::string formatted;
 
-    // In order to visually compress PCB files, it is helpful to special-case long lists of (xy ...)
-    // lists, which we allow to exist on a single line until we reach column 99.
-    const int  xySpecialCaseColumnLimit = 99;
+    formatted.reserve( aSource.length() );
 
-    // If whitespace occurs inside a list after this threshold, it will be converted into a newline
-    // and the indentation will be increased.  This is mainly used for image and group objects,
-    // which contain potentially long sets of string tokens within a single list.
-    const int  consecutiveTokenWrapThreshold = 72;
+    prettifier.Process( aSource.data(), aSource.length(), formatted );
+    prettifier.Finish( formatted );
 
-    std::string formatted;
-    formatted.reserve( aSource.length() );
+    aSource = std::move( formatted );
+}
 
-    auto cursor = aSource.begin();
-    auto seek = cursor;
-
-    int  listDepth = 0;
-    char lastNonWhitespace = 0;
-    bool inQuote = false;
-    bool hasInsertedSpace = false;
-    bool inMultiLineList = false;
-    bool inXY = false;
-    bool inShortForm = false;
-    int  shortFormDepth = 0;
-    int  column = 0;
-    int  backslashCount = 0;    // Count of successive backslash read since any other char
-
-    auto isWhitespace = []( const char aChar )
-            {
-                return ( aChar == ' ' || aChar == '\t' || aChar == '\n' || aChar == '\r' );
-            };
 
-    auto nextNonWhitespace =
-            [&]( std::string::iterator aIt )
-            {
-                seek = aIt;
+PRETTIFIER::PRETTIFIER( bool aCompactSave ) :
+        m_compactSave( aCompactSave ),
+        m_empty( true ),
+        m_listDepth( 0 ),
+        m_lastNonWhitespace( 0 ),
+        m_inQuote( false ),
+        m_hasInsertedSpace( false ),
+        m_inMultiLineList( false ),
+        m_inXY( false ),
+        m_inShortForm( false ),
+        m_shortFormDepth( 0 ),
+        m_column( 0 ),
+        m_backslashCount( 0 )
+{
+}
 
-                while( seek != aSource.end() && isWhitespace( *seek ) )
-                    seek++;
 
-                if( seek == aSource.end() )
-                    return (char)0;
+void PRETTIFIER::Process( const char* aText, size_t aCount, std::string& aOut )
+{
+    m_pending.append( aText, aCount );
+    drain( false, aOut );
+}
 
-                return *seek;
-            };
 
-    auto isXY =
-            [&]( std::string::iterator aIt )
-            {
-                seek = aIt;
+void PRETTIFIER::Finish( std::string& aOut )
+{
+    drain( true, aOut );
 
-                if( ++seek == aSource.end() || *seek != 'x' )
-                    return false;
+    // newline required at end of line / file for POSIX compliance. Keeps git diffs clean.
+    aOut += '\n';
+}
 
-                if( ++seek == aSource.end() || *seek != 'y' )
-                    return false;
 
-                if( ++seek == aSource.end() || *seek != ' ' )
-                    return false;
+void PRETTIFIER::drain( bool aFinal, std::string& aOut )
+{
+    size_t idx = 0;
 
-                return true;
-            };
+    while( idx < m_pending.length() && processChar( idx, aFinal, aOut ) )
+        idx++;
+
+    m_pending.erase( 0, idx );
+}
 
-    auto isShortForm =
-            [&]( std::string::iterator aIt )
-            {
-                seek = aIt;
-                std::string token;
 
-                while( ++seek != aSource.end() && isalpha( *seek ) )
-                    token += *seek;
+bool PRETTIFIER::processChar( size_t aIdx, bool aFinal, std::string& aOut )
+{
+    const char   cursor = m_pending[aIdx];
+    const size_t outLength = aOut.length();
+
+    if( isWhitespace( cursor ) && !m_inQuote )
+    {
+        size_t seek = aIdx;
 
-                return token == "font" || token == "stroke" || token == "fill"
-                        || token == "offset" || token == "rotate" || token == "scale";
-            };
+        while( seek < m_pending.length() && isWhitespace( m_pending[seek] ) )
+            seek++;
+
+        if( seek == m_pending.length() && !aFinal )
+            return false;
+
+        char next = seek < m_pending.length() ? m_pending[seek] : 0;
+
+        if( !m_hasInsertedSpace             // Only permit one space between chars
+            && m_listDepth > 0              // Do not permit spaces in outer list
+            && m_lastNonWhitespace != '('   // Remove extra space after start of list
+            && next != ')'                  // Remove extra space before end of list
+            && next != '(' )                // Remove extra space before newline
+        {
+            if( m_inXY || m_column < consecutiveTokenWrapThreshold )
+            {
+                // Note that we only insert spaces here, no matter what kind of whitespace is
+                // in the input.  Newlines will be inserted as needed by the logic below.
+                aOut.push_back( ' ' );
+                m_column++;
+            }
+            else if( m_inShortForm )
+            {
+                aOut.push_back( ' ' );
+            }
+            else
+            {
+                aOut.push_back( '\n' );
+                aOut.append( m_listDepth * indentSize, indentChar );
+                m_column = m_listDepth * indentSize;
+                m_inMultiLineList = true;
+            }
 
-    while( cursor != aSource.end() )
+            m_hasInsertedSpace = true;
+        }
+    }
+    else
     {
-        char next = nextNonWhitespace( cursor );
+        m_hasInsertedSpace = false;
 
-        if( isWhitespace( *cursor ) && !inQuote )
+        if( cursor == '(' && !m_inQuote )
         {
-            if( !hasInsertedSpace           // Only permit one space between chars
-                && listDepth > 0            // Do not permit spaces in outer list
-                && lastNonWhitespace != '(' // Remove extra space after start of list
-                && next != ')'              // Remove extra space before end of list
-                && next != '(' )            // Remove extra space before newline
+            // Look ahead for the keyword of the list, until it is known not to be a short form
+            // keyword
+            size_t seek = aIdx + 1;
+
+            while( seek < m_pending.length() && isalpha( (unsigned char) m_pending[seek] )
+                   && seek - aIdx <= shortFormKeywordMaxLength + 1 )
+            {
+                seek++;
+            }
+
+            if( seek == m_pending.length() && !aFinal )
+                return false;
+
+            std::string_view keyword( m_pending.data() + aIdx + 1, seek - aIdx - 1 );
+
+            bool currentIsXY = m_pending.compare( aIdx + 1, 3, "xy " ) == 0;
+            bool currentIsShortForm = m_compactSave
+                                      && ( keyword == "font" || keyword == "stroke"
+                                           || keyword == "fill" || keyword == "offset"
+                                           || keyword == "rotate" || keyword == "scale" );
+
+            if( m_empty )
+            {
+                aOut.push_back( '(' );
+                m_column++;
+            }
+            else if( m_inXY && currentIsXY && m_column < xySpecialCaseColumnLimit )
             {
-                if( inXY || column < consecutiveTokenWrapThreshold )
-                {
-                    // Note that we only insert spaces here, no matter what kind of whitespace is
-                    // in the input.  Newlines will be inserted as needed by the logic below.
-                    formatted.push_back( ' ' );
-                    column++;
-                }
-                else if( inShortForm )
-                {
-                    formatted.push_back( ' ' );
-                }
-                else
-                {
-                    formatted += fmt::format( "\n{}",
-                                              std::string( listDepth * indentSize, indentChar ) );
-                    column = listDepth * indentSize;
-                    inMultiLineList = true;
-                }
-
-                hasInsertedSpace = true;
+                // List-of-points special case
+                aOut += " (";
+                m_column += 2;
             }
+            else if( m_inShortForm )
+            {
+                aOut += " (";
+                m_column += 2;
+            }
+            else
+            {
+                aOut.push_back( '\n' );
+                aOut.append( m_listDepth * indentSize, indentChar );
+                aOut.push_back( '(' );
+                m_column = m_listDepth * indentSize + 1;
+            }
+
+            m_inXY = currentIsXY;
+
+            if( currentIsShortForm )
+            {
+                m_inShortForm = true;
+                m_shortFormDepth = m_listDepth;
+            }
+
+            m_listDepth++;
         }
-        else
+        else if( cursor == ')' && !m_inQuote )
         {
-            hasInsertedSpace = false;
+            if( m_listDepth > 0 )
+                m_listDepth--;
 
-            if( *cursor == '(' && !inQuote )
+            if( m_inShortForm )
             {
-                bool currentIsXY = isXY( cursor );
-                bool currentIsShortForm = aCompactSave && isShortForm( cursor );
-
-                if( formatted.empty() )
-                {
-                    formatted.push_back( '(' );
-                    column++;
-                }
-                else if( inXY && currentIsXY && column < xySpecialCaseColumnLimit )
-                {
-                    // List-of-points special case
-                    formatted += " (";
-                    column += 2;
-                }
-                else if( inShortForm )
-                {
-                    formatted += " (";
-                    column += 2;
-                }
-                else
-                {
-                    formatted += fmt::format( "\n{}(",
-                                              std::string( listDepth * indentSize, indentChar ) );
-                    column = listDepth * indentSize + 1;
-                }
-
-                inXY = currentIsXY;
-
-                if( currentIsShortForm )
-                {
-                    inShortForm = true;
-                    shortFormDepth = listDepth;
-                }
-
-                listDepth++;
+                aOut.push_back( ')' );
+                m_column++;
             }
-            else if( *cursor == ')' && !inQuote )
+            else if( m_lastNonWhitespace == ')' || m_inMultiLineList )
             {
-                if( listDepth > 0 )
-                    listDepth--;
-
-                if( inShortForm )
-                {
-                    formatted.push_back( ')' );
-                    column++;
-                }
-                else if( lastNonWhitespace == ')' || inMultiLineList )
-                {
-                    formatted += fmt::format( "\n{})",
-                                              std::string( listDepth * indentSize, indentChar ) );
-                    column = listDepth * indentSize + 1;
-                    inMultiLineList = false;
-                }
-                else
-                {
-                    formatted.push_back( ')' );
-                    column++;
-                }
-
-                if( shortFormDepth == listDepth )
-                {
-                    inShortForm = false;
-                    shortFormDepth = 0;
-                }
+                aOut.push_back( '\n' );
+                aOut.append( m_listDepth * indentSize, indentChar );
+                aOut.push_back( ')' );
+                m_column = m_listDepth * indentSize + 1;
+                m_inMultiLineList = false;
             }
             else
             {
-                // The output formatter escapes double-quotes (like \")
-                // But a corner case is a sequence like \\"
-                // therefore a '\' is attached to a '"' if a odd number of '\' is detected
-                if( *cursor == '\\' )
-                    backslashCount++;
-                else if( *cursor == quoteChar && ( backslashCount & 1 ) == 0 )
-                    inQuote = !inQuote;
-
-                if( *cursor != '\\' )
-                    backslashCount = 0;
-
-                formatted.push_back( *cursor );
-                column++;
+                aOut.push_back( ')' );
+                m_column++;
             }
 
-            lastNonWhitespace = *cursor;
+            if( m_shortFormDepth == m_listDepth )
+            {
+                m_inShortForm = false;
+                m_shortFormDepth = 0;
+            }
+        }
+        else
+        {
+            // The output formatter escapes double-quotes (like \")
+            // But a corner case is a sequence like \\"
+            // therefore a '\' is attached to a '"' if a odd number of '\' is detected
+            if( cursor == '\\' )
+                m_backslashCount++;
+            else if( cursor == quoteChar && ( m_backslashCount & 1 ) == 0 )
+                m_inQuote = !m_inQuote;
+
+            if( cursor != '\\' )
+                m_backslashCount = 0;
+
+            aOut.push_back( cursor );
+            m_column++;
         }
 
-        ++cursor;
+        m_lastNonWhitespace = cursor;
     }
 
-    // newline required at end of line / file for POSIX compliance. Keeps git diffs clean.
-    formatted += '\n';
+    if( aOut.length() != outLength )
+        m_empty = false;
 
-    aSource = std::move( formatted );
+    return true;
 }
 
 } // namespace KICAD_FORMAT
@@ -0,0 +1,42 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <kicommon.h>
+#include <wx/string.h>
+#include "job.h"
+
+class KICOMMON_API JOB_PCB_ROUTE : public JOB
+{
+public:
+    JOB_PCB_ROUTE();
+    wxString GetDefaultDescription() const override;
+    wxString GetSettingsDialogTitle() const override;
+
+    wxString m_filename;
+
+    /// Names of the nets to route; all nets when empty
+    std::vector<wxString> m_nets;
+
+    /// Number of shove mode passes over the connections the first pass could not route
+    int m_shoveRetries;
+
+    bool m_exitCodeUnrouted;
+};
@@ -48,7 +48,7 @@ std::unique_ptr<LINE_READER> FILE_LIB_TABLE_IO::GetReader( const wxString& aURI
     if( !fn.IsOk() || !fn.IsFileReadable() )
         return nullptr;
 
-    return std::make_unique<FILE_LINE_READER>( aURI );
+    return std::make_unique<MMAP_LINE_READER>( aURI );
 }
 
 
@@ -192,6 +192,7 @@ LIB_TREE_NODE_ITEM::LIB_TREE_NODE_ITEM( LIB_TREE_NODE* aParent, LIB_TREE_ITEM* a
 {
     m_Type = TYPE::ITEM;
     m_Parent = aParent;
+    m_TermsScore = -1;
 
     m_LibId.SetLibNickname( aItem->GetLibNickname() );
     m_LibId.SetLibItemName( aItem->GetName() );
@@ -212,6 +213,14 @@ LIB_TREE_NODE_ITEM::LIB_TREE_NODE_ITEM( LIB_TREE_NODE* aParent, LIB_TREE_ITEM* a
         for( int u = 1; u <= aItem->GetSubUnitCount(); ++u )
             AddUnit( aItem, u );
     }
+
+    LIB_TREE_SEARCH_INDEX::Invalidate();
+}
+
+
+LIB_TREE_NODE_ITEM::~LIB_TREE_NODE_ITEM()
+{
+    LIB_TREE_SEARCH_INDEX::Invalidate();
 }
 
 
@@ -240,6 +249,8 @@ void LIB_TREE_NODE_ITEM::Update( LIB_TREE_ITEM* aItem )
 
     for( int u = 1; u <= aItem->GetSubUnitCount(); ++u )
         AddUnit( aItem, u );
+
+    LIB_TREE_SEARCH_INDEX::Invalidate();
 }
 
 
@@ -249,7 +260,12 @@ void LIB_TREE_NODE_ITEM::UpdateScore( EDA_COMBINED_MATCHER* aMatcher, const wxSt
     // aMatcher test is additive, but if we don't match the given term at all, it nulls out
     if( aMatcher )
     {
-        int currentScore = aMatcher->ScoreTerms( m_SearchTerms );
+        int currentScore = m_TermsScore;
+
+        if( currentScore < 0 )
+            currentScore = aMatcher->ScoreTerms( m_SearchTerms );
+
+        m_TermsScore = -1;
 
         // This is a hack: the second phase of search in the adapter will look for a tokenized
         // LIB_ID and send the lib part down here.  While we generally want to prune ourselves
@@ -386,6 +402,10 @@ void LIB_TREE_NODE_ROOT::Clear()
 void LIB_TREE_NODE_ROOT::UpdateScore( EDA_COMBINED_MATCHER* aMatcher, const wxString& aLib,
                                       std::function<bool( LIB_TREE_NODE& aNode )>* aFilter )
 {
+    // Score the search terms of all the items at once, rather than one by one below
+    if( aMatcher )
+        m_searchIndex.ScoreItems( *this, aMatcher->GetPattern() );
+
     for( std::unique_ptr<LIB_TREE_NODE>& child: m_Children )
         child->UpdateScore( aMatcher, aLib, aFilter );
 }
@@ -0,0 +1,272 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <lib_tree_search_index.h>
+
+#include <memory>
+
+#include <eda_pattern_match.h>
+#include <lib_tree_model.h>
+#include <thread_pool.h>
+
+
+/// Below this many items, matching is not worth splitting over the thread pool
+static constexpr size_t PARALLEL_THRESHOLD = 2000;
+
+/// The number of patterns whose matching items are kept
+static constexpr size_t MAX_RECENT_MATCHES = 8;
+
+
+std::atomic<uint64_t> LIB_TREE_SEARCH_INDEX::s_revision( 1 );
+
+
+/**
+ * Call \a aFunc( start, end ) over [0, aCount), in parallel blocks if there are enough items.
+ */
+template <typename FUNC>
+static void forBlocks( size_t aCount, FUNC&& aFunc, size_t aBlocks = 0 )
+{
+    if( aCount < PARALLEL_THRESHOLD )
+    {
+        aFunc( 0, aCount );
+        return;
+    }
+
+    thread_pool& tp = GetKiCadThreadPool();
+
+    tp.parallelize_loop( aCount, aFunc, aBlocks ).wait();
+}
+
+
+/**
+ * Same as EDA_COMBINED_MATCHER::ScoreTerms() for a pattern which all matchers would find as a
+ * plain substring.
+ */
+static int scoreTerms( const std::vector<SEARCH_TERM>& aTerms, const wxString& aPattern )
+{
+    int score = 0;
+
+    for( const SEARCH_TERM& term : aTerms )
+    {
+        if( term.Text == aPattern )
+        {
+            score += 8 * term.Score;
+        }
+        else
+        {
+            int pos = term.Text.Find( aPattern );
+
+            if( pos == 0 )
+                score += 2 * term.Score;
+            else if( pos != wxNOT_FOUND )
+                score += term.Score;
+        }
+    }
+
+    return score;
+}
+
+
+bool LIB_TREE_SEARCH_INDEX::isLiteral( const wxString& aPattern )
+{
+    // EDA_COMBINED_MATCHER only finds something else than a substring with patterns which
+    // are regular expressions (starting with '/' or '^'), have wildcards, or are relational
+    // patterns (with '<', '=' or '>')
+    if( aPattern.IsEmpty() || aPattern.StartsWith( wxS( "/" ) )
+            || aPattern.StartsWith( wxS( "^" ) ) )
+    {
+        return false;
+    }
+
+    for( wxUniChar c : aPattern )
+    {
+        if( c == '*' || c == '?' || c == '<' || c == '=' || c == '>' )
+            return false;
+    }
+
+    return true;
+}
+
+
+LIB_TREE_SEARCH_INDEX::SIGNATURE LIB_TREE_SEARCH_INDEX::signature( const wxString& aText )
+{
+    SIGNATURE      sig = {};
+    const wchar_t* text = aText.wc_str();
+    size_t         len = aText.length();
+
+    for( size_t ii = 2; ii < len; ++ii )
+    {
+        uint64_t trigram = ( uint64_t( text[ii - 2] ) << 42 ) | ( uint64_t( text[ii - 1] ) << 21 )
+                           | uint64_t( text[ii] );
+        uint64_t bit = ( trigram * 0x9E3779B97F4A7C15ULL ) >> 54;   // 10 bits
+
+        sig[bit / 64] |= uint64_t( 1 ) << ( bit % 64 );
+    }
+
+    return sig;
+}
+
+
+void LIB_TREE_SEARCH_INDEX::build( LIB_TREE_NODE_ROOT& aRoot )
+{
+    m_items.clear();
+    m_recentMatches.clear();
+
+    for( std::unique_ptr<LIB_TREE_NODE>& lib : aRoot.m_Children )
+    {
+        for( std::unique_ptr<LIB_TREE_NODE>& child : lib->m_Children )
+        {
+            if( child->m_Type == LIB_TREE_NODE::TYPE::ITEM )
+                m_items.push_back( static_cast<LIB_TREE_NODE_ITEM*>( child.get() ) );
+        }
+    }
+
+    m_signatures.assign( m_items.size(), SIGNATURE() );
+
+    forBlocks( m_items.size(),
+               [&]( size_t aStart, size_t aEnd )
+               {
+                   for( size_t ii = aStart; ii < aEnd; ++ii )
+                   {
+                       for( SEARCH_TERM& term : m_items[ii]->m_SearchTerms )
+                       {
+                           term.Normalize();
+
+                           SIGNATURE termSig = signature( term.Text );
+
+                           for( size_t jj = 0; jj < termSig.size(); ++jj )
+                               m_signatures[ii][jj] |= termSig[jj];
+                       }
+                   }
+               } );
+
+    m_revision = s_revision;
+    m_built = true;
+}
+
+
+void LIB_TREE_SEARCH_INDEX::ScoreItems( LIB_TREE_NODE_ROOT& aRoot, const wxString& aPattern )
+{
+    if( !m_built || m_revision != s_revision )
+        build( aRoot );
+
+    for( LIB_TREE_NODE_ITEM* item : m_items )
+        item->m_TermsScore = 0;
+
+    if( isLiteral( aPattern ) )
+        scoreLiteral( aPattern );
+    else
+        scoreWithMatchers( aPattern );
+}
+
+
+void LIB_TREE_SEARCH_INDEX::scoreLiteral( const wxString& aPattern )
+{
+    // An item containing the pattern contains any part of it: the items matching a part of
+    // the pattern searched for before are the only candidates
+    const MATCHES* previous = nullptr;
+
+    for( const MATCHES& matches : m_recentMatches )
+    {
+        if( aPattern.Contains( matches.m_Pattern )
+                && ( !previous || matches.m_Items.size() < previous->m_Items.size() ) )
+        {
+            previous = &matches;
+        }
+    }
+
+    std::vector<int> candidates;
+
+    if( previous )
+    {
+        candidates.reserve( previous->m_Items.size() );
+
+        for( const auto& [index, score] : previous->m_Items )
+            candidates.push_back( index );
+    }
+    else
+    {
+        candidates.resize( m_items.size() );
+
+        for( size_t ii = 0; ii < m_items.size(); ++ii )
+            candidates[ii] = static_cast<int>( ii );
+    }
+
+    // Patterns shorter than a trigram have an empty signature, which all items match
+    SIGNATURE        patternSig = signature( aPattern );
+    std::vector<int> scores( candidates.size(), 0 );
+
+    forBlocks( candidates.size(),
+               [&]( size_t aStart, size_t aEnd )
+               {
+                   for( size_t ii = aStart; ii < aEnd; ++ii )
+                   {
+                       int              index = candidates[ii];
+                       const SIGNATURE& itemSig = m_signatures[index];
+                       bool             possible = true;
+
+                       for( size_t jj = 0; jj < patternSig.size() && possible; ++jj )
+                           possible = ( itemSig[jj] & patternSig[jj] ) == patternSig[jj];
+
+                       if( possible )
+                           scores[ii] = scoreTerms( m_items[index]->m_SearchTerms, aPattern );
+                   }
+               } );
+
+    MATCHES matches;
+    matches.m_Pattern = aPattern;
+
+    for( size_t ii = 0; ii < candidates.size(); ++ii )
+    {
+        if( scores[ii] > 0 )
+        {
+            m_items[candidates[ii]]->m_TermsScore = scores[ii];
+            matches.m_Items.emplace_back( candidates[ii], scores[ii] );
+        }
+    }
+
+    m_recentMatches.push_back( std::move( matches ) );
+
+    if( m_recentMatches.size() > MAX_RECENT_MATCHES )
+        m_recentMatches.pop_front();
+}
+
+
+void LIB_TREE_SEARCH_INDEX::scoreWithMatchers( const wxString& aPattern )
+{
+    // Matchers cannot be shared between threads, and cannot be built on worker threads either
+    // since setting their pattern changes the log level
+    size_t blocks = std::max<size_t>( 1, GetKiCadThreadPool().get_thread_count() );
+
+    std::vector<std::unique_ptr<EDA_COMBINED_MATCHER>> matchers;
+    std::atomic<size_t>                                nextMatcher( 0 );
+
+    for( size_t ii = 0; ii < blocks; ++ii )
+        matchers.push_back( std::make_unique<EDA_COMBINED_MATCHER>( aPattern, CTX_LIBITEM ) );
+
+    forBlocks( m_items.size(),
+               [&]( size_t aStart, size_t aEnd )
+               {
+                   EDA_COMBINED_MATCHER& matcher = *matchers[nextMatcher++];
+
+                   for( size_t ii = aStart; ii < aEnd; ++ii )
+                       m_items[ii]->m_TermsScore = matcher.ScoreTerms( m_items[ii]->m_SearchTerms );
+               },
+               blocks );
+}
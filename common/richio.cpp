@@ -24,6 +24,7 @@
 
 
 #include <cstdarg>
+#include <cstring>
 #include <config.h> // HAVE_FGETC_NOLOCK
 
 #include <kiplatform/io.h>
@@ -332,6 +333,114 @@ char* STRING_LINE_READER::ReadLine()
 }
 
 
+/**
+ * @return the length of the line starting at \a aNdx in \a aText, including its newline.
+ * @throw IO_ERROR if it is \a aMaxLength or more.
+ */
+static unsigned lineLength( const char* aText, size_t aSize, size_t aNdx, unsigned aMaxLength )
+{
+    const char* line = aText + aNdx;
+    const char* newline = static_cast<const char*>( memchr( line, '\n', aSize - aNdx ) );
+    size_t      length = newline ? newline - line + 1 : aSize - aNdx;
+
+    if( length >= aMaxLength )
+        THROW_IO_ERROR( _( "Line length exceeded" ) );
+
+    return static_cast<unsigned>( length );
+}
+
+
+const char* STRING_LINE_READER::ReadLineInPlace( unsigned& aLength )
+{
+    const char* line = m_lines.data() + m_ndx;
+
+    m_length = lineLength( m_lines.data(), m_lines.size(), m_ndx, m_maxLineLength );
+    m_ndx += m_length;
+    ++m_lineNum;      // this gets incremented even if no bytes were read
+
+    aLength = m_length;
+    return line;
+}
+
+
+MMAP_LINE_READER::MMAP_LINE_READER( const wxString& aFileName, unsigned aMaxLineLength ) :
+    LINE_READER( aMaxLineLength ),
+    m_data( nullptr ),
+    m_size( 0 ),
+    m_ndx( 0 ),
+    m_mapHandle( nullptr ),
+    m_mapped( false )
+{
+    m_source = aFileName;
+    m_data = KIPLATFORM::IO::MapFile( aFileName, m_size, m_mapHandle );
+
+    if( m_data )
+    {
+        m_mapped = true;
+        return;
+    }
+
+    // Empty files and special files cannot be mapped: read them instead
+    FILE* fp = KIPLATFORM::IO::SeqFOpen( aFileName, wxT( "rb" ) );
+
+    if( !fp )
+    {
+        wxString msg = wxString::Format( _( "Unable to open %s for reading." ),
+                                         aFileName.GetData() );
+        THROW_IO_ERROR( msg );
+    }
+
+    char   buf[8192];
+    size_t count;
+
+    while( ( count = fread( buf, 1, sizeof( buf ), fp ) ) > 0 )
+        m_buffer.append( buf, count );
+
+    fclose( fp );
+
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+}
+
+
+MMAP_LINE_READER::~MMAP_LINE_READER()
+{
+    if( m_mapped )
+        KIPLATFORM::IO::UnmapFile( m_data, m_size, m_mapHandle );
+}
+
+
+const char* MMAP_LINE_READER::ReadLineInPlace( unsigned& aLength )
+{
+    const char* line = m_data + m_ndx;
+
+    m_length = lineLength( m_data, m_size, m_ndx, m_maxLineLength );
+    m_ndx += m_length;
+    ++m_lineNum;      // this gets incremented even if no bytes were read
+
+    aLength = m_length;
+    return line;
+}
+
+
+char* MMAP_LINE_READER::ReadLine()
+{
+    unsigned length = lineLength( m_data, m_size, m_ndx, m_maxLineLength );
+
+    if( length + 1 > m_capacity )   // +1 for terminating nul
+        expandCapacity( length + 1 );
+
+    memcpy( m_line, m_data + m_ndx, length );
+    m_ndx += length;
+
+    m_length = length;
+    ++m_lineNum;      // this gets incremented even if no bytes were read
+    m_line[m_length] = 0;
+
+    return m_length ? m_line : nullptr;
+}
+
+
 INPUTSTREAM_LINE_READER::INPUTSTREAM_LINE_READER( wxInputStream* aStream,
                                                   const wxString& aSource ) :
     LINE_READER( LINE_READER_LINE_DEFAULT_MAX ),
@@ -603,15 +712,23 @@ void FILE_OUTPUTFORMATTER::write( const char* aOutBuf, int aCount )
 }
 
 
+/// Size of the blocks of prettified text written to the file
+static constexpr size_t PRETTIFIED_WRITE_SIZE = 256 * 1024;
+
+
 PRETTIFIED_FILE_OUTPUTFORMATTER::PRETTIFIED_FILE_OUTPUTFORMATTER( const wxString& aFileName,
                                                                   const wxChar* aMode,
                                                                   char aQuoteChar ) :
-        OUTPUTFORMATTER( OUTPUTFMTBUFZ, aQuoteChar )
+        OUTPUTFORMATTER( OUTPUTFMTBUFZ, aQuoteChar ),
+        m_prettifier( std::make_unique<KICAD_FORMAT::PRETTIFIER>(
+                ADVANCED_CFG::GetCfg().m_CompactSave ) )
 {
     m_fp = wxFopen( aFileName, aMode );
 
     if( !m_fp )
         THROW_IO_ERROR( strerror( errno ) );
+
+    m_buf.reserve( PRETTIFIED_WRITE_SIZE + OUTPUTFMTBUFZ );
 }
 
 
@@ -631,10 +748,8 @@ bool PRETTIFIED_FILE_OUTPUTFORMATTER::Finish()
     if( !m_fp )
         return false;
 
-    KICAD_FORMAT::Prettify( m_buf, ADVANCED_CFG::GetCfg().m_CompactSave );
-
-    if( fwrite( m_buf.c_str(), m_buf.length(), 1, m_fp ) != 1 )
-        THROW_IO_ERROR( strerror( errno ) );
+    m_prettifier->Finish( m_buf );
+    flush();
 
     fclose( m_fp );
     m_fp = nullptr;
@@ -645,5 +760,17 @@ bool PRETTIFIED_FILE_OUTPUTFORMATTER::Finish()
 
 void PRETTIFIED_FILE_OUTPUTFORMATTER::write( const char* aOutBuf, int aCount )
 {
-    m_buf.append( aOutBuf, aCount );
+    m_prettifier->Process( aOutBuf, aCount, m_buf );
+
+    if( m_buf.length() >= PRETTIFIED_WRITE_SIZE )
+        flush();
+}
+
+
+void PRETTIFIED_FILE_OUTPUTFORMATTER::flush()
+{
+    if( !m_buf.empty() && fwrite( m_buf.c_str(), m_buf.length(), 1, m_fp ) != 1 )
+        THROW_IO_ERROR( strerror( errno ) );
+
+    m_buf.clear();
 }
@@ -22,6 +22,7 @@
 
 #include <base_units.h>
 #include <charconv>
+#include <limits>
 #include <string_utils.h>
 #include <render_settings.h>
 #include <geometry/geometry_utils.h>
@@ -312,7 +313,8 @@ void STROKE_PARAMS_PARSER::ParseStroke( STROKE_PARAMS& aStroke )
         switch( token )
         {
         case T_width:
-            aStroke.SetWidth( KiROUND( parseDouble( "stroke width" ) * m_iuPerMM ) );
+            NeedNUMBER( "stroke width" );
+            aStroke.SetWidth( parseScaledInt( m_iuPerMM, std::numeric_limits<int>::max() ) );
             NeedRIGHT();
             break;
 
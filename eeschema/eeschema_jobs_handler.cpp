@@ -1064,6 +1064,9 @@ int EESCHEMA_JOBS_HANDLER::JobSymUpgrade( JOB* aJob )
     {
         SCH_IO_KICAD_SEXPR_LIB_CACHE schLibrary( fn.GetFullPath() );
 
+        // Format the symbols of large libraries on the thread pool
+        schLibrary.SetParallel( true );
+
         try
         {
             schLibrary.Load();
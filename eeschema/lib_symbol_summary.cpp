@@ -0,0 +1,146 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <lib_symbol_summary.h>
+
+#include <json_common.h>
+#include <json_conversions.h>
+#include <lib_symbol.h>
+
+
+LIB_SYMBOL_SUMMARY::LIB_SYMBOL_SUMMARY( LIB_SYMBOL& aSymbol ) :
+        m_libId( aSymbol.GetLIB_ID() ),
+        m_name( aSymbol.GetName() ),
+        m_description( aSymbol.GetDesc() ),
+        m_footprint( aSymbol.GetFootprint() ),
+        m_searchTerms( aSymbol.GetSearchTerms() ),
+        m_pinCount( aSymbol.GetPinCount() ),
+        m_unitCount( aSymbol.GetSubUnitCount() ),
+        m_isRoot( aSymbol.IsRoot() ),
+        m_isPower( aSymbol.IsPower() )
+{
+    aSymbol.GetChooserFields( m_chooserFields );
+
+    for( int unit = 1; unit <= m_unitCount; ++unit )
+    {
+        if( aSymbol.HasUnitDisplayName( unit ) )
+            m_unitDisplayNames[unit] = aSymbol.GetUnitDisplayName( unit );
+    }
+}
+
+
+void LIB_SYMBOL_SUMMARY::GetChooserFields( std::map<wxString, wxString>& aColumnMap )
+{
+    for( const auto& [name, text] : m_chooserFields )
+        aColumnMap[name] = text;
+}
+
+
+wxString LIB_SYMBOL_SUMMARY::GetUnitReference( int aUnit )
+{
+    return LIB_SYMBOL::LetterSubReference( aUnit, 'A' );
+}
+
+
+wxString LIB_SYMBOL_SUMMARY::GetUnitDisplayName( int aUnit )
+{
+    auto it = m_unitDisplayNames.find( aUnit );
+
+    if( it != m_unitDisplayNames.end() )
+        return it->second;
+    else
+        return wxString::Format( _( "Unit %s" ), GetUnitReference( aUnit ) );
+}
+
+
+void to_json( nlohmann::json& aJson, const LIB_SYMBOL_SUMMARY& aSummary )
+{
+    // The library nickname is not stored: it depends on the library table the library is in
+    aJson = nlohmann::json::object();
+
+    aJson["name"] = aSummary.m_name;
+    aJson["description"] = aSummary.m_description;
+    aJson["footprint"] = aSummary.m_footprint;
+    aJson["pin_count"] = aSummary.m_pinCount;
+    aJson["unit_count"] = aSummary.m_unitCount;
+    aJson["root"] = aSummary.m_isRoot;
+    aJson["power"] = aSummary.m_isPower;
+
+    nlohmann::json fields = nlohmann::json::array();
+
+    for( const auto& [name, text] : aSummary.m_chooserFields )
+        fields.push_back( { { "name", name }, { "text", text } } );
+
+    aJson["fields"] = fields;
+
+    nlohmann::json units = nlohmann::json::array();
+
+    for( const auto& [unit, name] : aSummary.m_unitDisplayNames )
+        units.push_back( { { "unit", unit }, { "name", name } } );
+
+    aJson["units"] = units;
+
+    nlohmann::json terms = nlohmann::json::array();
+
+    for( const SEARCH_TERM& term : aSummary.m_searchTerms )
+        terms.push_back( { { "text", term.Text }, { "score", term.Score } } );
+
+    aJson["search_terms"] = terms;
+}
+
+
+void from_json( const nlohmann::json& aJson, LIB_SYMBOL_SUMMARY& aSummary )
+{
+    aSummary.m_name = aJson.at( "name" ).get<wxString>();
+    aSummary.m_libId = LIB_ID( wxEmptyString, aSummary.m_name );
+    aSummary.m_description = aJson.at( "description" ).get<wxString>();
+    aSummary.m_footprint = aJson.at( "footprint" ).get<wxString>();
+    aSummary.m_pinCount = aJson.at( "pin_count" ).get<int>();
+    aSummary.m_unitCount = aJson.at( "unit_count" ).get<int>();
+    aSummary.m_isRoot = aJson.at( "root" ).get<bool>();
+    aSummary.m_isPower = aJson.at( "power" ).get<bool>();
+
+    aSummary.m_chooserFields.clear();
+
+    for( const nlohmann::json& field : aJson.at( "fields" ) )
+    {
+        wxString name = field.at( "name" ).get<wxString>();
+        aSummary.m_chooserFields[name] = field.at( "text" ).get<wxString>();
+    }
+
+    aSummary.m_unitDisplayNames.clear();
+
+    for( const nlohmann::json& unit : aJson.at( "units" ) )
+    {
+        int unitNumber = unit.at( "unit" ).get<int>();
+        aSummary.m_unitDisplayNames[unitNumber] = unit.at( "name" ).get<wxString>();
+    }
+
+    aSummary.m_searchTerms.clear();
+
+    for( const nlohmann::json& term : aJson.at( "search_terms" ) )
+    {
+        aSummary.m_searchTerms.emplace_back( term.at( "text" ).get<wxString>(),
+                                             term.at( "score" ).get<int>() );
+    }
+}
@@ -0,0 +1,89 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef LIB_SYMBOL_SUMMARY_H
+#define LIB_SYMBOL_SUMMARY_H
+
+#include <map>
+#include <vector>
+
+#include <lib_id.h>
+#include <lib_tree_item.h>
+#include <nlohmann/json_fwd.hpp>
+
+class LIB_SYMBOL;
+
+
+/**
+ * What the symbol choosers show of a library symbol.
+ *
+ * Libraries can keep the summaries of their symbols in an index, to fill the choosers without
+ * parsing the symbols.  The symbol itself is then only loaded when it is previewed or placed.
+ */
+class LIB_SYMBOL_SUMMARY : public LIB_TREE_ITEM
+{
+public:
+    LIB_SYMBOL_SUMMARY() = default;
+
+    explicit LIB_SYMBOL_SUMMARY( LIB_SYMBOL& aSymbol );
+
+    LIB_ID GetLIB_ID() const override { return m_libId; }
+    wxString GetName() const override { return m_name; }
+    wxString GetLibNickname() const override { return m_libId.GetLibNickname(); }
+    wxString GetDesc() override { return m_description; }
+
+    void GetChooserFields( std::map<wxString, wxString>& aColumnMap ) override;
+
+    std::vector<SEARCH_TERM> GetSearchTerms() override { return m_searchTerms; }
+
+    bool IsRoot() const override { return m_isRoot; }
+    wxString GetFootprint() override { return m_footprint; }
+    int GetPinCount() override { return m_pinCount; }
+    int GetSubUnitCount() const override { return m_unitCount; }
+
+    wxString GetUnitReference( int aUnit ) override;
+    wxString GetUnitDisplayName( int aUnit ) override;
+    bool HasUnitDisplayName( int aUnit ) override { return m_unitDisplayNames.count( aUnit ) == 1; }
+
+    bool IsPower() const { return m_isPower; }
+
+    void SetLibId( const LIB_ID& aLibId ) { m_libId = aLibId; }
+
+    friend void to_json( nlohmann::json& aJson, const LIB_SYMBOL_SUMMARY& aSummary );
+    friend void from_json( const nlohmann::json& aJson, LIB_SYMBOL_SUMMARY& aSummary );
+
+private:
+    LIB_ID                       m_libId;
+    wxString                     m_name;
+    wxString                     m_description;
+    wxString                     m_footprint;
+    std::map<wxString, wxString> m_chooserFields;
+    std::vector<SEARCH_TERM>     m_searchTerms;
+    std::map<int, wxString>      m_unitDisplayNames;
+    int                          m_pinCount = 0;
+    int                          m_unitCount = 0;
+    bool                         m_isRoot = true;
+    bool                         m_isPower = false;
+};
+
+#endif // LIB_SYMBOL_SUMMARY_H
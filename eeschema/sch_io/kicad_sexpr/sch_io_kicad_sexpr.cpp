@@ -21,7 +21,9 @@
  */
 
 #include <algorithm>
+#include <fstream>
 
+#include <wx/ffile.h>
 #include <wx/log.h>
 #include <wx/mstream.h>
 
@@ -31,7 +33,12 @@
 #include <ee_selection.h>
 #include <font/fontconfig.h>
 #include <io/kicad/kicad_io_utils.h>
+#include <json_common.h>
+#include <json_conversions.h>
+#include <lib_symbol_summary.h>
 #include <locale_io.h>
+#include <mmh3_hash.h>
+#include <paths.h>
 #include <progress_reporter.h>
 #include <schematic.h>
 #include <schematic_lexer.h>
@@ -68,6 +75,26 @@ using namespace TSCHEMATIC_T;
                        reader.LineNumber(), pos - reader.Line() )
 
 
+/// Bump when the content of the symbol library indexes changes
+static constexpr int SYMBOL_INDEX_VERSION = 1;
+
+
+/**
+ * @return the path of the index of a symbol library, in the user cache folder.
+ */
+static wxString symbolIndexPath( const wxString& aLibPath )
+{
+    MMH3_HASH hash;
+
+    hash.add( std::string( aLibPath.ToUTF8() ) );
+
+    wxFileName fn( PATHS::GetUserCachePath(), hash.digest().ToString(), wxT( "json" ) );
+    fn.AppendDir( wxT( "symbol-index" ) );
+
+    return fn.GetFullPath();
+}
+
+
 SCH_IO_KICAD_SEXPR::SCH_IO_KICAD_SEXPR() : SCH_IO( wxS( "Eeschema s-expression" ) )
 {
     init( nullptr );
@@ -293,7 +320,7 @@ void SCH_IO_KICAD_SEXPR::loadHierarchy( const SCH_SHEET_PATH& aParentSheetPath,
 
 void SCH_IO_KICAD_SEXPR::loadFile( const wxString& aFileName, SCH_SHEET* aSheet )
 {
-    FILE_LINE_READER reader( aFileName );
+    MMAP_LINE_READER reader( aFileName );
 
     size_t lineCount = 0;
 
@@ -304,10 +331,8 @@ void SCH_IO_KICAD_SEXPR::loadFile( const wxString& aFileName, SCH_SHEET* aSheet
         if( !m_progressReporter->KeepRefreshing() )
             THROW_IO_ERROR( _( "Open cancelled by user." ) );
 
-        while( reader.ReadLine() )
-            lineCount++;
-
-        reader.Rewind();
+        std::string_view text = reader.GetText();
+        lineCount = std::count( text.begin(), text.end(), '\n' );
     }
 
     SCH_IO_KICAD_SEXPR_PARSER parser( &reader, m_progressReporter, lineCount, m_rootSheet,
@@ -1587,6 +1612,116 @@ void SCH_IO_KICAD_SEXPR::EnumerateSymbolLib( std::vector<LIB_SYMBOL*>& aSymbolLi
 }
 
 
+void SCH_IO_KICAD_SEXPR::EnumerateSymbolSummaries( std::vector<LIB_SYMBOL_SUMMARY>& aSummaryList,
+                                                   const wxString& aLibraryPath,
+                                                   const std::map<std::string, UTF8>* aProperties )
+{
+    bool powerSymbolsOnly = ( aProperties &&
+                              aProperties->find( SYMBOL_LIB_TABLE::PropPowerSymsOnly ) != aProperties->end() );
+
+    wxFileName libFile( aLibraryPath );
+    wxString   indexPath = symbolIndexPath( aLibraryPath );
+    long long  timestamp = 0;
+    long long  size = 0;
+
+    // A library already loaded may have changes which are not saved yet, and is summarized as
+    // it is.  Otherwise the index is used if the library file did not change since it was written.
+    bool useIndex = !isBuffering( aProperties ) && libFile.FileExists()
+                        && !( m_cache && m_cache->IsFile( aLibraryPath )
+                              && !m_cache->IsFileChanged() );
+
+    if( useIndex )
+    {
+        timestamp = libFile.GetModificationTime().GetValue().GetValue();
+        size = wxFileName::GetSize( aLibraryPath ).GetValue();
+
+        if( wxFileExists( indexPath ) )
+        {
+            try
+            {
+                nlohmann::json index;
+                std::ifstream  indexFile( indexPath.fn_str() );
+
+                indexFile >> index;
+
+                if( index.at( "version" ).get<int>() == SYMBOL_INDEX_VERSION
+                        && index.at( "library" ).get<wxString>() == aLibraryPath
+                        && index.at( "timestamp" ).get<long long>() == timestamp
+                        && index.at( "size" ).get<long long>() == size )
+                {
+                    std::vector<LIB_SYMBOL_SUMMARY> summaries;
+
+                    index.at( "symbols" ).get_to( summaries );
+
+                    for( LIB_SYMBOL_SUMMARY& summary : summaries )
+                    {
+                        if( !powerSymbolsOnly || summary.IsPower() )
+                            aSummaryList.push_back( std::move( summary ) );
+                    }
+
+                    return;
+                }
+            }
+            catch( const nlohmann::json::exception& e )
+            {
+                // It is only a cache, an invalid index is rebuilt below
+                wxLogTrace( traceSchPlugin, wxT( "Invalid symbol library index '%s': %s" ),
+                            indexPath, e.what() );
+            }
+        }
+    }
+
+    LOCALE_IO toggle;     // toggles on, then off, the C locale.
+
+    cacheLib( aLibraryPath, aProperties );
+
+    std::vector<LIB_SYMBOL_SUMMARY> summaries;
+
+    for( const auto& [name, symbol] : m_cache->m_symbols )
+        summaries.emplace_back( *symbol );
+
+    if( useIndex )
+    {
+        wxFileName indexFile( indexPath );
+
+        if( indexFile.DirExists() || indexFile.Mkdir( wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL ) )
+        {
+            nlohmann::json index;
+
+            index["version"] = SYMBOL_INDEX_VERSION;
+            index["library"] = aLibraryPath;
+            index["timestamp"] = timestamp;
+            index["size"] = size;
+            index["symbols"] = summaries;
+
+            std::string text = index.dump( 0 );
+            wxString    tmpFileName = wxFileName::CreateTempFileName( indexPath );
+            bool        written = false;
+
+            {
+                wxFFile tmpFile( tmpFileName, wxT( "wb" ) );
+
+                if( tmpFile.IsOpened() )
+                {
+                    written = tmpFile.Write( text.data(), text.size() ) == text.size()
+                                && tmpFile.Close();
+                }
+            }
+
+            // The index of a library which is being read concurrently may be replaced already
+            if( !written || !wxRenameFile( tmpFileName, indexPath, true ) )
+                wxRemoveFile( tmpFileName );
+        }
+    }
+
+    for( LIB_SYMBOL_SUMMARY& summary : summaries )
+    {
+        if( !powerSymbolsOnly || summary.IsPower() )
+            aSummaryList.push_back( std::move( summary ) );
+    }
+}
+
+
 LIB_SYMBOL* SCH_IO_KICAD_SEXPR::LoadSymbol( const wxString& aLibraryPath,
                                             const wxString& aSymbolName,
                                             const std::map<std::string, UTF8>* aProperties )
@@ -34,12 +34,18 @@
 #include <string_utils.h>
 #include <trace_helpers.h>
 #include <io/kicad/kicad_io_utils.h>
+#include <thread_pool.h>
+
+
+/// Libraries with fewer symbols are saved on one thread
+static constexpr size_t PARALLEL_SAVE_MIN_SYMBOLS = 500;
 
 
 SCH_IO_KICAD_SEXPR_LIB_CACHE::SCH_IO_KICAD_SEXPR_LIB_CACHE( const wxString& aFullPathAndFileName ) :
     SCH_IO_LIB_CACHE( aFullPathAndFileName )
 {
     m_fileFormatVersionAtLoad = 0;
+    m_parallel = false;
 }
 
 
@@ -67,7 +73,7 @@ void SCH_IO_KICAD_SEXPR_LIB_CACHE::Load()
     wxLogTrace( traceSchLegacyPlugin, "Loading sexpr symbol library file '%s'",
                 m_libFileName.GetFullPath() );
 
-    FILE_LINE_READER reader( m_libFileName.GetFullPath() );
+    MMAP_LINE_READER reader( m_libFileName.GetFullPath() );
 
     SCH_IO_KICAD_SEXPR_PARSER parser( &reader );
 
@@ -119,8 +125,16 @@ void SCH_IO_KICAD_SEXPR_LIB_CACHE::Save( const std::optional<bool>& aOpt )
                    return lhDepth < rhDepth;
                } );
 
-    for( LIB_SYMBOL* symbol : orderedSymbols )
-        SaveSymbol( symbol, *formatter.get() );
+    if( m_parallel && orderedSymbols.size() >= PARALLEL_SAVE_MIN_SYMBOLS
+            && GetKiCadThreadPool().get_thread_count() > 1 )
+    {
+        saveSymbolsInParallel( orderedSymbols, *formatter.get() );
+    }
+    else
+    {
+        for( LIB_SYMBOL* symbol : orderedSymbols )
+            SaveSymbol( symbol, *formatter.get() );
+    }
 
     formatter->Print( ")" );
 
@@ -140,7 +154,13 @@ void SCH_IO_KICAD_SEXPR_LIB_CACHE::SaveSymbol( LIB_SYMBOL* aSymbol, OUTPUTFORMAT
     wxCHECK2( wxLocale::GetInfo( wxLOCALE_DECIMAL_POINT, wxLOCALE_CAT_NUMBER ) == ".",
               LOCALE_IO toggle );
 
+    updateEmbeddedFonts( aSymbol );
+    formatSymbol( aSymbol, aFormatter, aLibName, aIncludeData );
+}
 
+
+void SCH_IO_KICAD_SEXPR_LIB_CACHE::updateEmbeddedFonts( LIB_SYMBOL* aSymbol )
+{
     // If we've requested to embed the fonts in the symbol, do so.
     // Otherwise, clear the embedded fonts from the symbol.  Embedded
     // fonts will be used if available
@@ -148,7 +168,61 @@ void SCH_IO_KICAD_SEXPR_LIB_CACHE::SaveSymbol( LIB_SYMBOL* aSymbol, OUTPUTFORMAT
         aSymbol->EmbedFonts();
     else
         aSymbol->GetEmbeddedFiles()->ClearEmbeddedFonts();
+}
+
+
+void SCH_IO_KICAD_SEXPR_LIB_CACHE::saveSymbolsInParallel( const std::vector<LIB_SYMBOL*>& aSymbols,
+                                                          OUTPUTFORMATTER& aFormatter )
+{
+    struct CHUNK
+    {
+        size_t      m_first;
+        size_t      m_last;
+        std::string m_text;
+    };
 
+    thread_pool& tp = GetKiCadThreadPool();
+
+    for( LIB_SYMBOL* symbol : aSymbols )
+        updateEmbeddedFonts( symbol );
+
+    // A few chunks per thread, as symbols with many units take longer to format
+    const size_t chunkSize = std::max<size_t>( PARALLEL_SAVE_MIN_SYMBOLS / 4,
+                                               aSymbols.size() / ( tp.get_thread_count() * 4 ) );
+
+    std::vector<CHUNK> chunks;
+
+    for( size_t ii = 0; ii < aSymbols.size(); ii += chunkSize )
+        chunks.push_back( { ii, std::min( ii + chunkSize, aSymbols.size() ), {} } );
+
+    auto formatChunks =
+            [&]( size_t aStart, size_t aEnd )
+            {
+                for( size_t ii = aStart; ii < aEnd; ++ii )
+                {
+                    STRING_FORMATTER formatter;
+
+                    for( size_t jj = chunks[ii].m_first; jj < chunks[ii].m_last; ++jj )
+                        formatSymbol( aSymbols[jj], formatter, wxEmptyString, true );
+
+                    chunks[ii].m_text = formatter.GetString();
+                }
+            };
+
+    auto returns = tp.parallelize_loop( chunks.size(), formatChunks, chunks.size() );
+
+    // Wait for all the workers before throwing the first error, they use the chunks
+    returns.wait();
+    returns.get();
+
+    for( const CHUNK& chunk : chunks )
+        aFormatter.Write( chunk.m_text );
+}
+
+
+void SCH_IO_KICAD_SEXPR_LIB_CACHE::formatSymbol( LIB_SYMBOL* aSymbol, OUTPUTFORMATTER& aFormatter,
+                                                 const wxString& aLibName, bool aIncludeData )
+{
     int nextFreeFieldId = MANDATORY_FIELD_COUNT;
     std::vector<SCH_FIELD*> fields;
     std::string name = aFormatter.Quotew( aSymbol->GetLibId().GetLibItemName().wx_str() );
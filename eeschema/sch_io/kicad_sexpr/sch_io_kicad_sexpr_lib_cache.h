@@ -44,7 +44,12 @@ public:
     // error codes nor user interface calls from here, nor in any SCH_IO objects.
     // Catch these exceptions higher up please.
 
-    /// Save the entire library to file m_libFileName;
+    /**
+     * Save the entire library to file m_libFileName.
+     *
+     * In parallel mode, the symbols of large libraries are formatted on the thread pool.  The
+     * file does not depend on the number of threads.
+     */
     void Save( const std::optional<bool>& aOpt = std::nullopt ) override;
 
     void Load() override;
@@ -57,10 +62,34 @@ public:
     void SetFileFormatVersionAtLoad( int aVersion ) { m_fileFormatVersionAtLoad = aVersion; }
     int GetFileFormatVersionAtLoad()  const { return m_fileFormatVersionAtLoad; }
 
+    /**
+     * Format the symbols on the thread pool when saving.  Off by default, for callers which
+     * are tasks of the thread pool themselves.
+     */
+    void SetParallel( bool aParallel ) { m_parallel = aParallel; }
+
 private:
     friend SCH_IO_KICAD_SEXPR;
 
-    int m_fileFormatVersionAtLoad;
+    int  m_fileFormatVersionAtLoad;
+    bool m_parallel;
+
+    /**
+     * Embed the fonts of \a aSymbol, or clear them if it does not embed its fonts.  Needs the
+     * font libraries, so it is only called from the main thread.
+     */
+    static void updateEmbeddedFonts( LIB_SYMBOL* aSymbol );
+
+    /// The part of SaveSymbol() which can run on worker threads
+    static void formatSymbol( LIB_SYMBOL* aSymbol, OUTPUTFORMATTER& aFormatter,
+                              const wxString& aLibName, bool aIncludeData );
+
+    /**
+     * Format \a aSymbols in chunks, in parallel, and write the chunks to \a aFormatter in
+     * order.  The output is the same as saving the symbols one after the other.
+     */
+    static void saveSymbolsInParallel( const std::vector<LIB_SYMBOL*>& aSymbols,
+                                       OUTPUTFORMATTER& aFormatter );
 
     static void saveSymbolDrawItem( SCH_ITEM* aItem, OUTPUTFORMATTER& aFormatter );
     static void saveField( SCH_FIELD* aField, OUTPUTFORMATTER& aFormatter );
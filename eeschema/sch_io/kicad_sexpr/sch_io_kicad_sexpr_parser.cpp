@@ -613,24 +613,19 @@ SCH_ITEM* SCH_IO_KICAD_SEXPR_PARSER::ParseSymbolDrawItem()
 
 int SCH_IO_KICAD_SEXPR_PARSER::parseInternalUnits()
 {
-    auto retval = parseDouble() * schIUScale.IU_PER_MM;
-
     // Schematic internal units are represented as integers.  Any values that are
     // larger or smaller than the schematic units represent undefined behavior for
     // the system.  Limit values to the largest that can be displayed on the screen.
     constexpr double int_limit = std::numeric_limits<int>::max() * 0.7071; // 0.7071 = roughly 1/sqrt(2)
 
-    return KiROUND( std::clamp( retval, -int_limit, int_limit ) );
+    return parseScaledInt( schIUScale.IU_PER_MM, int_limit );
 }
 
 
 int SCH_IO_KICAD_SEXPR_PARSER::parseInternalUnits( const char* aExpected )
 {
-    auto retval = parseDouble( aExpected ) * schIUScale.IU_PER_MM;
-
-    constexpr double int_limit = std::numeric_limits<int>::max() * 0.7071;
-
-    return KiROUND( std::clamp( retval, -int_limit, int_limit ) );
+    NeedNUMBER( aExpected );
+    return parseInternalUnits();
 }
 
 
@@ -23,6 +23,8 @@
 #include <unordered_set>
 
 #include <ki_exception.h>
+#include <lib_symbol.h>
+#include <lib_symbol_summary.h>
 #include <sch_io/sch_io.h>
 #include <sch_io/sch_io_mgr.h>
 #include <wx/translation.h>
@@ -97,6 +99,19 @@ void SCH_IO::EnumerateSymbolLib( std::vector<LIB_SYMBOL*>& aSymbolList,
 }
 
 
+void SCH_IO::EnumerateSymbolSummaries( std::vector<LIB_SYMBOL_SUMMARY>& aSummaryList,
+                                       const wxString& aLibraryPath,
+                                       const std::map<std::string, UTF8>* aProperties )
+{
+    std::vector<LIB_SYMBOL*> symbols;
+
+    EnumerateSymbolLib( symbols, aLibraryPath, aProperties );
+
+    for( LIB_SYMBOL* symbol : symbols )
+        aSummaryList.emplace_back( *symbol );
+}
+
+
 LIB_SYMBOL* SCH_IO::LoadSymbol( const wxString& aLibraryPath, const wxString& aSymbolName,
                                 const std::map<std::string, UTF8>* aProperties )
 {
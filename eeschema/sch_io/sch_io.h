@@ -32,6 +32,8 @@
 #include <i18n_utility.h>
 #include <wx/arrstr.h>
 
+class LIB_SYMBOL_SUMMARY;
+
 /**
  * Base class that schematic file and library loading and saving plugins should derive from.
  * Implementations can provide either LoadSchematicFile() or SaveSchematicFile() functions,
@@ -187,6 +189,29 @@ public:
                                      const wxString& aLibraryPath,
                                      const std::map<std::string, UTF8>* aProperties = nullptr );
 
+    /**
+     * Populate a list of the summaries shown by the symbol choosers for the symbols contained
+     * within the library \a aLibraryPath.
+     *
+     * The default implementation loads the library with EnumerateSymbolLib().  Plugins which
+     * keep an index of their libraries can return the summaries without parsing the symbols.
+     *
+     * @param aSummaryList is an array to populate with the summaries.
+     *
+     * @param aLibraryPath is a locator for the "library", usually a directory, file,
+     *                     or URL containing one or more #LIB_SYMBOL objects.
+     *
+     * @param aProperties is an associative array that can be used to tell the plugin anything
+     *                    needed about how to perform with respect to \a aLibraryPath.  The
+     *                    caller continues to own this object (plugin may not delete it), and
+     *                    plugins should expect it to be optionally NULL.
+     *
+     * @throw IO_ERROR if the library cannot be found, the part library cannot be loaded.
+     */
+    virtual void EnumerateSymbolSummaries( std::vector<LIB_SYMBOL_SUMMARY>& aSummaryList,
+                                           const wxString& aLibraryPath,
+                                           const std::map<std::string, UTF8>* aProperties = nullptr );
+
     /**
      * Load a #LIB_SYMBOL object having \a aPartName from the \a aLibraryPath containing
      * a library format that this #SCH_IO knows about.
@@ -21,6 +21,7 @@
 #include <thread>
 
 #include <core/wx_stl_compat.h>
+#include <lib_symbol_summary.h>
 #include <symbol_async_loader.h>
 #include <symbol_lib_table.h>
 #include <progress_reporter.h>
@@ -34,6 +35,7 @@ SYMBOL_ASYNC_LOADER::SYMBOL_ASYNC_LOADER( const std::vector<wxString>& aNickname
         m_table( aTable ),
         m_onlyPowerSymbols( aOnlyPowerSymbols ),
         m_output( aOutput ),
+        m_summaryOutput( nullptr ),
         m_reporter( aReporter ),
         m_nextLibrary( 0 )
 {
@@ -114,8 +116,24 @@ std::vector<SYMBOL_ASYNC_LOADER::LOADED_PAIR> SYMBOL_ASYNC_LOADER::worker()
 
         try
         {
-            m_table->LoadSymbolLib( pair.second, nickname, onlyPower );
-            ret.emplace_back( std::move( pair ) );
+            if( m_summaryOutput )
+            {
+                std::vector<LIB_SYMBOL_SUMMARY> summaries;
+
+                m_table->LoadSymbolSummaries( summaries, nickname, onlyPower );
+
+                // Don't show libraries that had no power symbols
+                if( onlyPower && summaries.empty() )
+                    continue;
+
+                std::lock_guard<std::mutex> lock( m_summaryMutex );
+                m_summaryOutput->emplace( nickname, std::move( summaries ) );
+            }
+            else
+            {
+                m_table->LoadSymbolLib( pair.second, nickname, onlyPower );
+                ret.emplace_back( std::move( pair ) );
+            }
         }
         catch( const IO_ERROR& ioe )
         {
@@ -30,6 +30,7 @@
 #include <wx/string.h>
 
 class LIB_SYMBOL;
+class LIB_SYMBOL_SUMMARY;
 class PROGRESS_REPORTER;
 class SYMBOL_LIB_TABLE;
 
@@ -53,6 +54,19 @@ public:
 
     ~SYMBOL_ASYNC_LOADER();
 
+    /**
+     * Load the summaries of the symbols shown by the choosers instead of the symbols.
+     *
+     * Summaries may be read from a library index, without loading the symbols.
+     *
+     * @param aOutput will be filled with the summaries, instead of the output map given to the
+     *                constructor.
+     */
+    void SetSummaryOutput( std::unordered_map<wxString, std::vector<LIB_SYMBOL_SUMMARY>>* aOutput )
+    {
+        m_summaryOutput = aOutput;
+    }
+
     /**
      * Spin up threads to load all the libraries in m_nicknames.
      */
@@ -88,6 +102,10 @@ private:
     /// Handle to map that will be filled with the loaded parts per library.
     std::unordered_map<wxString, std::vector<LIB_SYMBOL*>>* m_output;
 
+    /// Handle to map that will be filled with the symbol summaries per library, if not null.
+    std::unordered_map<wxString, std::vector<LIB_SYMBOL_SUMMARY>>* m_summaryOutput;
+    std::mutex                                                     m_summaryMutex;
+
     /// Progress reporter (may be null).
     PROGRESS_REPORTER* m_reporter;
 
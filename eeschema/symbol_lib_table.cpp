@@ -35,6 +35,7 @@
 #include <systemdirsappend.h>
 #include <symbol_lib_table.h>
 #include <lib_symbol.h>
+#include <lib_symbol_summary.h>
 #include <sch_io/database/sch_io_database.h>
 #include <dialogs/dialog_database_lib_settings.h>
 
@@ -409,6 +410,39 @@ void SYMBOL_LIB_TABLE::LoadSymbolLib( std::vector<LIB_SYMBOL*>& aSymbolList,
 }
 
 
+void SYMBOL_LIB_TABLE::LoadSymbolSummaries( std::vector<LIB_SYMBOL_SUMMARY>& aSummaryList,
+                                            const wxString& aNickname, bool aPowerSymbolsOnly )
+{
+    SYMBOL_LIB_TABLE_ROW* row = FindRow( aNickname, true );
+
+    if( !row || !row->plugin )
+        return;
+
+    std::lock_guard<std::mutex> lock( row->GetMutex() );
+
+    wxString options = row->GetOptions();
+
+    if( aPowerSymbolsOnly )
+        row->SetOptions( row->GetOptions() + " " + PropPowerSymsOnly );
+
+    row->plugin->SetLibTable( this );
+    row->plugin->EnumerateSymbolSummaries( aSummaryList, row->GetFullURI( true ),
+                                           row->GetProperties() );
+
+    if( aPowerSymbolsOnly )
+        row->SetOptions( options );
+
+    // Same as LoadSymbolLib(): only the table knows the library nickname
+    for( LIB_SYMBOL_SUMMARY& summary : aSummaryList )
+    {
+        LIB_ID id = summary.GetLIB_ID();
+
+        id.SetLibNickname( row->GetNickName() );
+        summary.SetLibId( id );
+    }
+}
+
+
 LIB_SYMBOL* SYMBOL_LIB_TABLE::LoadSymbol( const wxString& aNickname, const wxString& aSymbolName )
 {
     SYMBOL_LIB_TABLE_ROW* row = FindRow( aNickname, true );
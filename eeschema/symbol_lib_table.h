@@ -196,6 +196,15 @@ public:
     void LoadSymbolLib( std::vector<LIB_SYMBOL*>& aAliasList, const wxString& aNickname,
                         bool aPowerSymbolsOnly = false );
 
+    /**
+     * Load the summaries shown by the symbol choosers for the symbols of the library given by
+     * @a aNickname, which may be known without loading the symbols themselves.
+     *
+     * @throw IO_ERROR if the library cannot be found or loaded.
+     */
+    void LoadSymbolSummaries( std::vector<LIB_SYMBOL_SUMMARY>& aSummaryList,
+                              const wxString& aNickname, bool aPowerSymbolsOnly = false );
+
     /**
      * Load a #LIB_SYMBOL having @a aName from the library given by @a aNickname.
      *
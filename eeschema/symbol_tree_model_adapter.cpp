@@ -30,6 +30,7 @@
 #include <widgets/wx_progress_reporters.h>
 #include <dialogs/html_message_box.h>
 #include <generate_alias_info.h>
+#include <lib_symbol_summary.h>
 #include <sch_base_frame.h>
 #include <locale_io.h>
 #include <symbol_async_loader.h>
@@ -78,11 +79,15 @@ bool SYMBOL_TREE_MODEL_ADAPTER::AddLibraries( const std::vector<wxString>& aNick
     // Disable KIID generation: not needed for library parts; sometimes very slow
     KIID::CreateNilUuids( true );
 
-    std::unordered_map<wxString, std::vector<LIB_SYMBOL*>> loadedSymbolMap;
+    std::unordered_map<wxString, std::vector<LIB_SYMBOL_SUMMARY>> loadedSymbolMap;
 
-    SYMBOL_ASYNC_LOADER loader( aNicknames, m_libs, GetFilter() != nullptr, &loadedSymbolMap,
+    // The tree items are made from the library indexes where possible; the symbols themselves
+    // are only loaded when previewed or placed
+    SYMBOL_ASYNC_LOADER loader( aNicknames, m_libs, GetFilter() != nullptr, nullptr,
                                 progressReporter.get() );
 
+    loader.SetSummaryOutput( &loadedSymbolMap );
+
     LOCALE_IO toggle;
 
     loader.Start();
@@ -121,17 +126,16 @@ bool SYMBOL_TREE_MODEL_ADAPTER::AddLibraries( const std::vector<wxString>& aNick
         PROJECT_FILE&    project = aFrame->Prj().GetProjectFile();
 
         auto addFunc =
-                [&]( const wxString& aLibName, const std::vector<LIB_SYMBOL*>& aSymbolList,
+                [&]( const wxString& aLibName, const std::vector<LIB_TREE_ITEM*>& aSymbolList,
                      const wxString& aDescription )
                 {
-                    std::vector<LIB_TREE_ITEM*> treeItems( aSymbolList.begin(), aSymbolList.end() );
                     bool pinned = alg::contains( cfg->m_Session.pinned_symbol_libs, aLibName )
                                   || alg::contains( project.m_PinnedSymbolLibs, aLibName );
 
-                    DoAddLibrary( aLibName, aDescription, treeItems, pinned, false );
+                    DoAddLibrary( aLibName, aDescription, aSymbolList, pinned, false );
                 };
 
-        for( const auto& [libNickname, libSymbols] : loadedSymbolMap )
+        for( auto& [libNickname, libSymbols] : loadedSymbolMap )
         {
             SYMBOL_LIB_TABLE_ROW* row = m_libs->FindRow( libNickname );
 
@@ -169,21 +173,25 @@ bool SYMBOL_TREE_MODEL_ADAPTER::AddLibraries( const std::vector<wxString>& aNick
 
                     UTF8 utf8Lib( lib );
 
-                    std::vector<LIB_SYMBOL*> symbols;
+                    std::vector<LIB_TREE_ITEM*> symbols;
 
-                    std::copy_if( libSymbols.begin(), libSymbols.end(),
-                                  std::back_inserter( symbols ),
-                                  [&utf8Lib]( LIB_SYMBOL* aSym )
-                                  {
-                                      return utf8Lib == aSym->GetLibId().GetSubLibraryName();
-                                  } );
+                    for( LIB_SYMBOL_SUMMARY& summary : libSymbols )
+                    {
+                        if( utf8Lib == summary.GetLIB_ID().GetSubLibraryName() )
+                            symbols.push_back( &summary );
+                    }
 
                     addFunc( name, symbols, desc );
                 }
             }
             else
             {
-                addFunc( libNickname, libSymbols, m_libs->GetDescription( libNickname ) );
+                std::vector<LIB_TREE_ITEM*> symbols;
+
+                for( LIB_SYMBOL_SUMMARY& summary : libSymbols )
+                    symbols.push_back( &summary );
+
+                addFunc( libNickname, symbols, m_libs->GetDescription( libNickname ) );
             }
         }
     }
@@ -255,6 +255,17 @@ public:
      */
     bool m_CompactSave;
 
+    /**
+     * Save the zone fills of boards in a binary cache file next to the board file
+     * (<board>.kicad_pcb.cache), and read them from it when the board is opened again and has
+     * not changed since.
+     *
+     * Setting name: "BoardFillCache"
+     * Valid values: 0 or 1
+     * Default value: 0
+     */
+    bool m_BoardFillCache;
+
     /**
      * Enable drawing the triangulation outlines with a visible color.
      *
@@ -36,6 +36,9 @@ namespace CLI
         /// Rules check violation count was greater than 0.
         static const int ERR_RC_VIOLATIONS = 5;
         static const int ERR_JOBS_RUN_FAILED = 6;
+
+        /// Some connections were left unrouted by the batch router.
+        static const int ERR_UNROUTED = 7;
     };
 }
 
@@ -382,6 +382,17 @@ public:
      */
     void NeedRIGHT();
 
+    /**
+     * Skip the rest of the current list, up to and including the #DSN_RIGHT which closes it.
+     *
+     * The skipped text is only scanned for parentheses and quoted strings, not tokenized, so
+     * this is much faster than reading the tokens of a large list just to drop them.  On return
+     * the current token is the closing #DSN_RIGHT.
+     *
+     * @throw IO_ERROR if the input ends before the list is closed.
+     */
+    void SkipList();
+
     /**
      * Call #NextTok() and then verifies that the token read in is a #DSN_BAR.
      *
@@ -439,7 +450,9 @@ public:
      */
     const char* CurLine() const
     {
-        return (const char*)(*reader);
+        // The line may be read in place, in the reader's text, and not be nul terminated
+        curLine.assign( start, limit );
+        return curLine.c_str();
     }
 
     /**
@@ -471,13 +484,11 @@ protected:
     {
         if( reader )
         {
-            reader->ReadLine();
-
-            unsigned len = reader->Length();
+            unsigned len = 0;
 
-            // start may have changed in ReadLine(), which can resize and
-            // relocate reader's line buffer.
-            start = reader->Line();
+            // Readers holding their whole text in memory return the line in place, others
+            // from their line buffer, which ReadLine() can resize and relocate.
+            start = reader->ReadLineInPlace( len );
 
             next  = start;
             limit = next + len;
@@ -528,6 +539,20 @@ protected:
         return parseDouble( GetTokenText( aToken ) );
     }
 
+    /**
+     * Parse the current token as a number of file units and convert it to integer internal
+     * units, clamped to +/- \a aLimit.
+     *
+     * Plain decimal numbers, which is all KiCad writes, are converted with integer arithmetic
+     * and rounded exactly (half away from zero, as KiROUND() does).  Anything else (exponents,
+     * very long mantissas, scales which are not a power of 10) goes through parseDouble().
+     *
+     * @param aScale is the number of internal units per file unit.
+     * @param aLimit is the largest magnitude of the result.
+     * @throw IO_ERROR if the current token is not a number.
+     */
+    int parseScaledInt( double aScale, double aLimit );
+
     bool                iOwnReaders;            ///< On readerStack, should I delete them?
     const char*         start;
     const char*         next;
@@ -557,6 +582,7 @@ protected:
 
     int                 curTok;                 ///< The current token obtained on last NextTok().
     std::string         curText;                ///< The text of the current token.
+    mutable std::string curLine;                ///< The nul terminated copy of CurLine().
 
     const KEYWORD*      keywords;               ///< Table sorted by CMake for bsearch().
     unsigned            keywordCount;           ///< Count of keywords table.
@@ -52,6 +52,11 @@ struct KICOMMON_API SEARCH_TERM
             Normalized( false )
     {}
 
+    /**
+     * Convert the text to the lower case, trimmed form patterns are matched against.
+     */
+    void Normalize();
+
     wxString Text;
     int      Score;
     bool     Normalized;
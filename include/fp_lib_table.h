@@ -184,6 +184,16 @@ public:
      */
     const FOOTPRINT* GetEnumeratedFootprint( const wxString& aNickname,
                                              const wxString& aFootprintName );
+
+    /**
+     * Fetch the description, keywords and pad counts of a footprint, after
+     * #FootprintEnumerate(), without loading it when the library has an index.
+     *
+     * @return false if the footprint cannot be found or loaded.
+     */
+    bool GetFootprintSummary( const wxString& aNickname, const wxString& aFootprintName,
+                              FOOTPRINT_SUMMARY& aSummary );
+
     /**
      * The set of return values from FootprintSave() below.
      */
@@ -47,4 +47,52 @@ KICOMMON_API void FormatStreamData( OUTPUTFORMATTER& aOut, const wxStreamBuffer&
 
 KICOMMON_API void Prettify( std::string& aSource, bool aCompactSave );
 
+/**
+ * Format s-expression text the same way as Prettify(), but as it is written rather than all at
+ * once, so that it can go to disk while the rest is produced.
+ *
+ * Only the characters which cannot be formatted yet are kept: a run of whitespace until the
+ * next character, or the start of a list until its keyword.
+ */
+class KICOMMON_API PRETTIFIER
+{
+public:
+    PRETTIFIER( bool aCompactSave );
+
+    /**
+     * Format \a aCount more characters, appending what can be formatted so far to \a aOut.
+     */
+    void Process( const char* aText, size_t aCount, std::string& aOut );
+
+    /**
+     * Format the remaining characters, and append them and the final newline to \a aOut.
+     */
+    void Finish( std::string& aOut );
+
+private:
+    void drain( bool aFinal, std::string& aOut );
+
+    /**
+     * Format the pending character at \a aIdx.
+     *
+     * @return false if more characters are needed to know how to format it.
+     */
+    bool processChar( size_t aIdx, bool aFinal, std::string& aOut );
+
+    bool        m_compactSave;
+    std::string m_pending;              ///< characters not formatted yet
+    bool        m_empty;                ///< nothing has been output yet
+
+    int         m_listDepth;
+    char        m_lastNonWhitespace;
+    bool        m_inQuote;
+    bool        m_hasInsertedSpace;
+    bool        m_inMultiLineList;
+    bool        m_inXY;
+    bool        m_inShortForm;
+    int         m_shortFormDepth;
+    int         m_column;
+    int         m_backslashCount;       ///< successive backslashes read since any other char
+};
+
 } // namespace KICAD_FORMAT
@@ -29,6 +29,7 @@
 #include <wx/string.h>
 #include <eda_pattern_match.h>
 #include <lib_tree_item.h>
+#include <lib_tree_search_index.h>
 
 
 /**
@@ -210,6 +211,8 @@ public:
      */
     LIB_TREE_NODE_ITEM( LIB_TREE_NODE* aParent, LIB_TREE_ITEM* aItem );
 
+    ~LIB_TREE_NODE_ITEM();
+
     /**
      * Update the node using data from a LIB_ALIAS object.
      */
@@ -221,6 +224,10 @@ public:
     void UpdateScore( EDA_COMBINED_MATCHER* aMatcher, const wxString& aLib,
                       std::function<bool( LIB_TREE_NODE& aNode )>* aFilter ) override;
 
+    /// Score of the search terms against the current search term, if already computed by the
+    /// search index of the tree, or -1.
+    int m_TermsScore;
+
 protected:
     /**
      * Add a new unit to the component and return it.
@@ -300,6 +307,9 @@ public:
 
     void UpdateScore( EDA_COMBINED_MATCHER* aMatcher, const wxString& aLib,
                       std::function<bool( LIB_TREE_NODE& aNode )>* aFilter ) override;
+
+private:
+    LIB_TREE_SEARCH_INDEX m_searchIndex;
 };
 
 
@@ -0,0 +1,99 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_TREE_SEARCH_INDEX_H
+#define LIB_TREE_SEARCH_INDEX_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <utility>
+#include <vector>
+
+#include <wx/string.h>
+
+class LIB_TREE_NODE_ITEM;
+class LIB_TREE_NODE_ROOT;
+
+
+/**
+ * Scores the search terms of all the items of a library tree against a search pattern.
+ *
+ * The result is the one of EDA_COMBINED_MATCHER::ScoreTerms() for each item, so the ranking
+ * is unchanged, but most items are ruled out without being matched:
+ *  - plain text patterns, which are the most common, are looked up in an index of the
+ *    trigrams of the search terms of each item, then matched as substrings;
+ *  - the items matching a pattern are kept for a few searches; when the pattern grows as it
+ *    is typed, only these items are matched again;
+ *  - the remaining matching is split over the thread pool.
+ *
+ * Other patterns (regular expressions, wildcards and relational patterns) go through
+ * EDA_COMBINED_MATCHER, still in parallel.
+ *
+ * The index is built on first use and rebuilt when item nodes are added, updated or removed.
+ */
+class LIB_TREE_SEARCH_INDEX
+{
+public:
+    LIB_TREE_SEARCH_INDEX() = default;
+
+    /**
+     * Store the score of the search terms of each item of \a aRoot against \a aPattern in its
+     * LIB_TREE_NODE_ITEM::m_TermsScore.
+     */
+    void ScoreItems( LIB_TREE_NODE_ROOT& aRoot, const wxString& aPattern );
+
+    /**
+     * Mark the indexes of all trees out of date.  Called whenever an item node is created,
+     * updated or deleted.
+     */
+    static void Invalidate() { s_revision++; }
+
+private:
+    /// One bit per trigram hash
+    typedef std::array<uint64_t, 16> SIGNATURE;
+
+    /// The items with a non-zero score for a pattern, as (item index, score) pairs
+    struct MATCHES
+    {
+        wxString                         m_Pattern;
+        std::vector<std::pair<int, int>> m_Items;
+    };
+
+    void build( LIB_TREE_NODE_ROOT& aRoot );
+
+    void scoreLiteral( const wxString& aPattern );
+
+    void scoreWithMatchers( const wxString& aPattern );
+
+    static bool isLiteral( const wxString& aPattern );
+
+    static SIGNATURE signature( const wxString& aText );
+
+    static std::atomic<uint64_t> s_revision;
+
+    uint64_t                         m_revision = 0;
+    bool                             m_built = false;
+    std::vector<LIB_TREE_NODE_ITEM*> m_items;
+    std::vector<SIGNATURE>           m_signatures;
+    std::deque<MATCHES>              m_recentMatches;
+};
+
+#endif // LIB_TREE_SEARCH_INDEX_H
@@ -29,6 +29,9 @@
 // "richio" after its author, Richard Hollenbeck, aka Dick Hollenbeck.
 
 
+#include <memory>
+#include <string>
+#include <string_view>
 #include <vector>
 #include <core/utf8.h>
 
@@ -41,6 +44,11 @@
 #include <ki_exception.h>
 #include <kicommon.h>
 
+namespace KICAD_FORMAT
+{
+class PRETTIFIER;
+}
+
 /**
  * This is like sprintf() but the output is appended to a std::string instead of to a
  * character array.
@@ -112,6 +120,24 @@ public:
      */
     virtual char* ReadLine() = 0;
 
+    /**
+     * Read a line of text and increment the line number counter, without copying the line
+     * when the reader holds all its text in memory.
+     *
+     * The line is not nul terminated, and may not be in Line().  This reads the line with
+     * ReadLine() unless overridden.
+     *
+     * @param aLength receives the number of bytes in the line, 0 at the end of the text.
+     * @return the beginning of the line.
+     * @throw IO_ERROR when a line is too long.
+     */
+    virtual const char* ReadLineInPlace( unsigned& aLength )
+    {
+        ReadLine();
+        aLength = m_length;
+        return m_line;
+    }
+
     /**
      * Returns the name of the source of the lines in an abstract sense.
      *
@@ -277,6 +303,56 @@ public:
     STRING_LINE_READER( const STRING_LINE_READER& aStartingPoint );
 
     char* ReadLine() override;
+
+    const char* ReadLineInPlace( unsigned& aLength ) override;
+};
+
+
+/**
+ * A #LINE_READER that maps a file in memory.
+ *
+ * ReadLineInPlace() returns the lines from the mapping itself, so that lexers do not copy
+ * them.  Files which cannot be mapped (empty files, pipes...) are read in memory instead.
+ */
+class KICOMMON_API MMAP_LINE_READER : public LINE_READER
+{
+public:
+    /**
+     * @param aFileName is the name of the file to map and to use for error reporting purposes.
+     * @param aMaxLineLength is the maximum length of a line.
+     *
+     * @throw IO_ERROR if @a aFileName cannot be opened.
+     */
+    MMAP_LINE_READER( const wxString& aFileName,
+                      unsigned aMaxLineLength = LINE_READER_LINE_DEFAULT_MAX );
+
+    ~MMAP_LINE_READER();
+
+    char* ReadLine() override;
+
+    const char* ReadLineInPlace( unsigned& aLength ) override;
+
+    /**
+     * Go back to the beginning of the file, and reset the line number to zero.
+     */
+    void Rewind()
+    {
+        m_ndx = 0;
+        m_lineNum = 0;
+    }
+
+    /**
+     * @return the whole text of the file.
+     */
+    std::string_view GetText() const { return std::string_view( m_data, m_size ); }
+
+private:
+    const char* m_data;
+    size_t      m_size;
+    size_t      m_ndx;
+    void*       m_mapHandle;
+    bool        m_mapped;
+    std::string m_buffer;       ///< the file contents when it cannot be mapped
 };
 
 
@@ -391,6 +467,18 @@ public:
      */
     int PRINTF_FUNC Print( const char* fmt, ... );
 
+    /**
+     * Write already formatted text, such as the output of a #STRING_FORMATTER, to the output
+     * stream as is.
+     *
+     * @throw IO_ERROR, if there is a problem outputting, such as a full disk.
+     */
+    void Write( std::string_view aText )
+    {
+        if( !aText.empty() )
+            write( aText.data(), (int) aText.size() );
+    }
+
     /**
      * Perform quote character need determination.
      *
@@ -512,6 +600,12 @@ protected:
 };
 
 
+/**
+ * An #OUTPUTFORMATTER writing prettified s-expressions to a file.
+ *
+ * The text is formatted as it is written and sent to the file in large blocks, so the whole
+ * output is never held in memory.
+ */
 class KICOMMON_API PRETTIFIED_FILE_OUTPUTFORMATTER : public OUTPUTFORMATTER
 {
 public:
@@ -521,7 +615,7 @@ public:
     ~PRETTIFIED_FILE_OUTPUTFORMATTER();
 
     /**
-     * Performs prettification and writes the stored buffer to the file.
+     * Writes the rest of the prettified text to the file and closes it.
      * @return true if the write succeeded.
      */
     bool Finish() override;
@@ -530,8 +624,11 @@ protected:
     void write( const char* aOutBuf, int aCount ) override;
 
 private:
+    void flush();
+
     FILE* m_fp;
-    std::string m_buf;
+    std::string m_buf;                                      ///< formatted text not written yet
+    std::unique_ptr<KICAD_FORMAT::PRETTIFIER> m_prettifier;
 };
 
 
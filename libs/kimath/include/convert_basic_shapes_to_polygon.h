@@ -47,6 +47,16 @@ enum RECT_CHAMFER_POSITIONS : int
 };
 
 
+/**
+ * Set the maximum number of shape approximations kept by the circle, oval, trapezoid and
+ * rounded/chamfered rectangle conversions below, and flush the current ones.
+ *
+ * These shapes are approximated once at the origin for a given size and error, and moved or
+ * rotated for each caller.  0 disables the cache.
+ */
+void SetApproximationCacheSize( size_t aMaxEntries );
+
+
 /**
  * Generate a polyline to approximate a arc
  *
@@ -0,0 +1,125 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef FROZEN_POLY_SET_H
+#define FROZEN_POLY_SET_H
+
+#include <cstdint>
+#include <vector>
+
+#include <geometry/shape_arc.h>
+#include <geometry/shape_poly_set.h>
+#include <math/box2.h>
+#include <math/vector2d.h>
+
+
+/**
+ * A read-only, compact copy of a #SHAPE_POLY_SET.
+ *
+ * A SHAPE_POLY_SET stores each contour in its own SHAPE_LINE_CHAIN, with separate point, shape
+ * and cache allocations.  This keeps all the vertices in a single buffer, with offset tables
+ * to find the polygons and contours, and optionally encodes each vertex as a varint delta from
+ * the previous one (large fills have mostly short edges, which then need 2 to 4 bytes instead
+ * of 8).
+ *
+ * It is meant for polygon sets which are kept but rarely read, and is converted back with
+ * Thaw() when needed.  Arcs are kept, but triangulations and other caches are not.
+ */
+class FROZEN_POLY_SET
+{
+public:
+    enum class ENCODING
+    {
+        PLAIN,          ///< 32 bit coordinates, for sets which are read often
+        DELTA_VARINT    ///< zigzag varint deltas between consecutive vertices
+    };
+
+    FROZEN_POLY_SET();
+
+    explicit FROZEN_POLY_SET( const SHAPE_POLY_SET& aSet,
+                              ENCODING aEncoding = ENCODING::DELTA_VARINT );
+
+    /**
+     * @return an editable copy of the polygon set.
+     */
+    SHAPE_POLY_SET Thaw() const;
+
+    /**
+     * @return an editable copy of one contour: 0 for the outline of \a aPolygon, 1 and up for
+     *         its holes.
+     */
+    SHAPE_LINE_CHAIN ThawContour( int aPolygon, int aContour ) const;
+
+    ENCODING GetEncoding() const { return m_encoding; }
+
+    bool IsEmpty() const { return OutlineCount() == 0; }
+
+    int OutlineCount() const { return static_cast<int>( m_polyOffsets.size() ) - 1; }
+
+    int HoleCount( int aPolygon ) const
+    {
+        return m_polyOffsets[aPolygon + 1] - m_polyOffsets[aPolygon] - 1;
+    }
+
+    int TotalVertices() const { return static_cast<int>( m_contourOffsets.back() ); }
+
+    const BOX2I& BBox() const { return m_bbox; }
+
+    /**
+     * @return the number of bytes allocated to store the set.
+     */
+    size_t MemoryUsage() const;
+
+private:
+    /// The arcs of a contour, with the same layout as in SHAPE_LINE_CHAIN
+    struct ARC_DATA
+    {
+        uint32_t                                 m_contour;
+        std::vector<std::pair<ssize_t, ssize_t>> m_shapes;
+        std::vector<SHAPE_ARC>                   m_arcs;
+    };
+
+    void encodeContour( const std::vector<VECTOR2I>& aPoints );
+
+    void decodeContour( size_t aContour, std::vector<VECTOR2I>& aPoints ) const;
+
+    ENCODING m_encoding;
+
+    /// First contour of each polygon (outline, then holes), plus the total contour count
+    std::vector<uint32_t> m_polyOffsets;
+
+    /// First vertex of each contour, plus the total vertex count
+    std::vector<uint32_t> m_contourOffsets;
+
+    /// First byte of each contour in m_encoded, plus its size (DELTA_VARINT only)
+    std::vector<uint32_t> m_byteOffsets;
+
+    std::vector<VECTOR2I> m_vertices;           ///< PLAIN vertices
+    std::vector<uint8_t>  m_encoded;            ///< DELTA_VARINT vertices
+
+    /// The contours having arcs, by increasing contour index
+    std::vector<ARC_DATA> m_arcData;
+
+    BOX2I                 m_bbox;
+};
+
+#endif // FROZEN_POLY_SET_H
@@ -27,12 +27,15 @@
 #define __SHAPE_LINE_CHAIN
 
 
+#include <memory>
+
 #include <clipper2/clipper.h>
 #include <geometry/seg.h>
 #include <geometry/shape.h>
 #include <geometry/shape_arc.h>
 #include <geometry/corner_strategy.h>
 #include <math/vector2d.h>
+#include <math/vector2_batch.h>
 
 /**
  * Holds information on each point of a SHAPE_LINE_CHAIN that is retrievable
@@ -166,7 +169,8 @@ public:
             m_arcs( aShape.m_arcs ),
             m_closed( aShape.m_closed ),
             m_width( aShape.m_width ),
-            m_bbox( aShape.m_bbox )
+            m_bbox( aShape.m_bbox ),
+            m_edgeIndex( aShape.m_edgeIndex )
     {}
 
     SHAPE_LINE_CHAIN( const std::vector<int>& aV );
@@ -212,6 +216,11 @@ public:
     virtual bool Collide( const SEG& aSeg, int aClearance = 0, int* aActual = nullptr,
                           VECTOR2I* aLocation = nullptr ) const override;
 
+    SEG::ecoord SquaredDistance( const VECTOR2I& aP, bool aOutlineOnly = false ) const override;
+
+    bool PointInside( const VECTOR2I& aPt, int aAccuracy = 0,
+                      bool aUseBBoxCache = false ) const override;
+
     /**
      * Finds closest points between this and the other line chain. Doesn't test segments or arcs.
      *
@@ -259,6 +268,7 @@ public:
         m_arcs.clear();
         m_shapes.clear();
         m_closed = false;
+        m_edgeIndex.reset();
     }
 
     /**
@@ -441,8 +451,7 @@ public:
     /// @copydoc SHAPE::BBox()
     const BOX2I BBox( int aClearance = 0 ) const override
     {
-        BOX2I bbox;
-        bbox.Compute( m_points );
+        BOX2I bbox = BoundingBox( m_points.data(), m_points.size() );
 
         if( aClearance != 0 || m_width != 0 )
             bbox.Inflate( aClearance + m_width );
@@ -452,10 +461,13 @@ public:
 
     void GenerateBBoxCache() const
     {
-        m_bbox.Compute( m_points );
+        if( !m_points.empty() )
+            m_bbox = BoundingBox( m_points.data(), m_points.size() );
 
         if( m_width != 0 )
             m_bbox.Inflate( m_width );
+
+        buildEdgeIndex();
     }
 
     BOX2I* GetCachedBBox() const override
@@ -525,6 +537,7 @@ public:
             m_points.push_back( aP );
             m_shapes.push_back( SHAPES_ARE_PT );
             m_bbox.Merge( aP );
+            m_edgeIndex.reset();
         }
     }
 
@@ -745,13 +758,13 @@ public:
 
     void Move( const VECTOR2I& aVector ) override
     {
-        for( auto& pt : m_points )
-            pt += aVector;
+        MovePoints( m_points.data(), m_points.size(), aVector );
 
         for( auto& arc : m_arcs )
             arc.Move( aVector );
 
         m_bbox.Move( aVector );
+        m_edgeIndex.reset();
     }
 
     /**
@@ -870,6 +883,7 @@ public:
 
 protected:
     friend class SHAPE_POLY_SET;
+    friend class FROZEN_POLY_SET;
 
     /**
      * Convert an arc to only a point chain by removing the arc and references
@@ -971,6 +985,40 @@ private:
 
     /// cached bounding box
     mutable BOX2I m_bbox;
+
+    /**
+     * Horizontal bands over the extent of a closed chain, each listing the edges whose
+     * vertical span overlaps it.  Built by GenerateBBoxCache() for large chains and used, like
+     * the cached bounding box, when the caller asks for the caches.
+     *
+     * Edges spanning many bands are kept in a separate list, scanned for every query, so that
+     * the size of the index stays linear in the number of points.
+     */
+    struct EDGE_INDEX
+    {
+        int                   m_yMin = 0;
+        int                   m_yMax = 0;
+        int                   m_bandHeight = 1;
+        size_t                m_pointCount = 0;
+        std::vector<uint32_t> m_bandStart;      ///< offsets into m_edges, one per band plus one
+        std::vector<uint32_t> m_edges;
+        std::vector<uint32_t> m_longEdges;      ///< edges in no band, to be checked every time
+
+        int Band( int aY ) const
+        {
+            int64_t band = ( int64_t( aY ) - m_yMin ) / m_bandHeight;
+            return (int) std::clamp<int64_t>( band, 0, (int64_t) m_bandStart.size() - 2 );
+        }
+    };
+
+    void buildEdgeIndex() const;
+
+    /// Return the edge index if it still matches the chain, nullptr otherwise.
+    const EDGE_INDEX* validEdgeIndex() const;
+
+    /// Shared between copies: it is never modified once built, only replaced or dropped.
+    /// Every change to m_points must drop it.
+    mutable std::shared_ptr<const EDGE_INDEX> m_edgeIndex;
 };
 
 
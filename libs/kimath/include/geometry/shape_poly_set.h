@@ -49,6 +49,11 @@
 #include <math/vector2d.h>              // for VECTOR2I
 #include <hash_128.h>
 
+namespace BS
+{
+class thread_pool;
+}
+
 
 /**
  * Represent a set of closed polygons. Polygons may be nonconvex, self-intersecting
@@ -550,6 +555,18 @@ public:
     {
         cacheTriangulation( aPartition, aSimplify, nullptr );
     }
+
+    /**
+     * Build the partitioned triangulation, triangulating the grid cells on \a aPool.
+     *
+     * Cells which are identical to one already triangulated by this set or by \a aPrevious
+     * (typically the fill being replaced) reuse its triangles instead of being triangulated
+     * again.
+     *
+     * @return the number of triangulated partitions which were reused.
+     */
+    size_t CacheTriangulation( BS::thread_pool& aPool, const SHAPE_POLY_SET* aPrevious = nullptr );
+
     bool IsTriangulationUpToDate() const;
 
     HASH_128 GetHash() const;
@@ -1010,6 +1027,25 @@ public:
     /// Perform boolean polyset exclusive or between a and b, store the result in it self
     void BooleanXor( const SHAPE_POLY_SET& a, const SHAPE_POLY_SET& b );
 
+    /**
+     * Perform boolean polyset union, spreading the work over the threads of \a aPool.
+     *
+     * The outlines are grouped into clusters whose bounding boxes don't touch each other, so
+     * that the clusters cannot interact and can be processed independently.  Clusters too
+     * large for a single task, such as a zone outline with all its knockouts, are cut into
+     * vertical strips which are stitched back together afterwards.
+     *
+     * The result covers the same area as BooleanAdd( b ), possibly with the outlines in a
+     * different order, and with extra vertices (within one unit of the exact result) where
+     * edges cross the boundary between two strips.  It does not depend on the thread count.
+     * Small sets and sets containing arcs are processed on the calling thread.
+     */
+    void BooleanAdd( const SHAPE_POLY_SET& b, BS::thread_pool& aPool );
+
+    /// Perform boolean polyset difference, spreading the work over the threads of \a aPool.
+    /// @see BooleanAdd( const SHAPE_POLY_SET&, BS::thread_pool& ).
+    void BooleanSubtract( const SHAPE_POLY_SET& b, BS::thread_pool& aPool );
+
     /**
     * Extract all contours from this polygon set, then recreate polygons with holes.
     * Essentially XOR'ing, but faster. Self-intersecting polygons are not supported.
@@ -1067,6 +1103,19 @@ public:
     /// connecting the outer ring to the inner holes
     void Fracture();
 
+    /// Same as Fracture(), fracturing the polygons concurrently on \a aPool.
+    void Fracture( BS::thread_pool& aPool );
+
+    /// The available fracture implementations, to compare them in tests and benchmarks.
+    enum class FRACTURE_ALGO
+    {
+        INDEXED,    ///< Bridges each hole through an index of the edges near it (the default)
+        LINEAR,     ///< Scans every edge already bridged for each hole; same result as INDEXED
+        SLOW        ///< Linked list implementation, used if cache friendly fracture is disabled
+    };
+
+    void Fracture( FRACTURE_ALGO aAlgo );
+
     /// Convert a single outline slitted ("fractured") polygon into a set ouf outlines
     /// with holes.
     void Unfracture();
@@ -1227,7 +1276,8 @@ public:
                       bool aUseBBoxCache = false ) const override;
 
     /**
-     * Construct BBoxCaches for Contains(), below.
+     * Construct BBoxCaches for Contains(), below.  Large contours also get an edge index so
+     * that the containment test only visits the edges near the test point.
      *
      * @note These caches **must** be built before a group of calls to Contains().  They are
      *       **not** kept up-to-date by editing actions.
@@ -1446,14 +1496,16 @@ public:
 
 protected:
     void cacheTriangulation( bool aPartition, bool aSimplify,
-                             std::vector<std::unique_ptr<TRIANGULATED_POLYGON>>* aHintData );
+                             std::vector<std::unique_ptr<TRIANGULATED_POLYGON>>* aHintData,
+                             const SHAPE_POLY_SET* aPrevious = nullptr,
+                             BS::thread_pool* aPool = nullptr, size_t* aReusedCount = nullptr );
 
 private:
     enum DROP_TRIANGULATION_FLAG { SINGLETON };
 
     SHAPE_POLY_SET( const SHAPE_POLY_SET& aOther, DROP_TRIANGULATION_FLAG );
 
-    void fractureSingle( POLYGON& paths );
+    void fractureSingle( POLYGON& paths, FRACTURE_ALGO aAlgo );
     void unfractureSingle ( POLYGON& path );
     void importTree( Clipper2Lib::PolyTree64&            tree,
                      const std::vector<CLIPPER_Z_VALUE>& aZValueBuffer,
@@ -1482,6 +1534,14 @@ private:
     void booleanOp( Clipper2Lib::ClipType aType, const SHAPE_POLY_SET& aShape,
                     const SHAPE_POLY_SET& aOtherShape );
 
+    /**
+     * Parallel version of the above: splits the operands into clusters of outlines which
+     * cannot interact with each other (and large clusters into strips) and runs them through
+     * booleanOp() concurrently.
+     */
+    void booleanOp( Clipper2Lib::ClipType aType, const SHAPE_POLY_SET& aShape,
+                    const SHAPE_POLY_SET& aOtherShape, BS::thread_pool& aPool );
+
     /**
      * Check whether the point \a aP is inside the \a aSubpolyIndex-th polygon of the polyset. If
      * the points lies on an edge, the polygon is considered to contain it.
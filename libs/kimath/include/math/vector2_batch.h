@@ -0,0 +1,77 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef VECTOR2_BATCH_H
+#define VECTOR2_BATCH_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include <core/mirror.h>
+#include <geometry/eda_angle.h>
+#include <math/box2.h>
+#include <math/vector2d.h>
+
+/**
+ * Operations on arrays of points.
+ *
+ * They give the same results as the equivalent one point at a time operations (BOX2::Compute(),
+ * RotatePoint(), etc.), but use the SSE2 (x86-64) or NEON (AArch64) vector units when
+ * available and hoist the per call work (trigonometry, branches) out of the loops.
+ */
+
+/**
+ * @return the bounding box of \a aCount points, or a default BOX2I if \a aCount is 0.
+ */
+BOX2I BoundingBox( const VECTOR2I* aPoints, size_t aCount );
+
+/**
+ * Move \a aCount points by \a aOffset.
+ */
+void MovePoints( VECTOR2I* aPoints, size_t aCount, const VECTOR2I& aOffset );
+
+/**
+ * Mirror \a aCount points about the vertical (#FLIP_DIRECTION::LEFT_RIGHT) or horizontal
+ * (#FLIP_DIRECTION::TOP_BOTTOM) axis going through \a aRef.
+ */
+void MirrorPoints( VECTOR2I* aPoints, size_t aCount, const VECTOR2I& aRef,
+                   FLIP_DIRECTION aFlipDirection );
+
+/**
+ * Rotate \a aCount points around \a aCentre.  The results are the same as calling
+ * RotatePoint() on each point.
+ */
+void RotatePoints( VECTOR2I* aPoints, size_t aCount, const VECTOR2I& aCentre,
+                   const EDA_ANGLE& aAngle );
+
+/**
+ * Find the point closest to \a aRef.
+ *
+ * @param aDistSq is the squared distance to beat.  If a point is at least as close it is
+ *                updated with its squared distance.
+ * @return the index of the closest point at a squared distance <= \a aDistSq (the last one if
+ *         several are at the same distance), or -1 if there is none.
+ */
+int NearestPoint( const VECTOR2I* aPoints, size_t aCount, const VECTOR2I& aRef, int64_t& aDistSq );
+
+#endif // VECTOR2_BATCH_H
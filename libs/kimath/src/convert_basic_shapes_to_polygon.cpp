@@ -23,129 +23,275 @@
  */
 
 #include <algorithm>                    // for max, min
+#include <array>
+#include <atomic>
 #include <bitset>                       // for bitset::count
+#include <list>
 #include <math.h>                       // for atan2
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 
 #include <convert_basic_shapes_to_polygon.h>
 #include <geometry/geometry_utils.h>
 #include <geometry/shape_line_chain.h>  // for SHAPE_LINE_CHAIN
 #include <geometry/shape_poly_set.h>    // for SHAPE_POLY_SET, SHAPE_POLY_SE...
+#include <hash.h>
 #include <math/util.h>
 #include <math/vector2d.h>              // for VECTOR2I
 #include <trigo.h>
 
 
-void TransformCircleToPolygon( SHAPE_LINE_CHAIN& aBuffer, const VECTOR2I& aCenter, int aRadius,
-                               int aError, ERROR_LOC aErrorLoc, int aMinSegCount )
+/**
+ * A bounded, thread-safe cache of the basic shapes approximations, built at the origin and
+ * without rotation.
+ *
+ * Boards use a handful of distinct pad and via shapes, which are otherwise rebuilt for every
+ * item on every layer by the zone filler, the plotters and the 3D viewer.  Callers get the
+ * normalized approximation and rotate and move a copy of it exactly as they would have done
+ * with a freshly built one, so cached and uncached results are identical.
+ *
+ * The cache is split in shards, each with its own lock and least recently used list, to keep
+ * contention low when called from the thread pool.
+ */
+class APPROXIMATION_CACHE
 {
-    VECTOR2I corner_position;
-    int     numSegs = GetArcToSegmentCount( aRadius, aError, FULL_CIRCLE );
-    numSegs = std::max( aMinSegCount, numSegs );
+public:
+    enum SHAPE_KIND
+    {
+        CIRCLE_CHAIN,
+        CIRCLE,
+        OVAL,
+        TRAPEZOID,
+        ROUND_CHAMFERED_RECT
+    };
+
+    struct KEY
+    {
+        SHAPE_KIND         m_kind;
+        std::array<int, 8> m_params;
+        double             m_ratio = 0.0;
 
-    // Round up to 8 to make segment approximations align properly at 45-degrees
-    numSegs = ( numSegs + 7 ) / 8 * 8;
+        bool operator==( const KEY& aOther ) const = default;
+    };
 
-    EDA_ANGLE delta = ANGLE_360 / numSegs;
-    int       radius = aRadius;
+    static APPROXIMATION_CACHE& Get()
+    {
+        static APPROXIMATION_CACHE cache;
+        return cache;
+    }
 
-    if( aErrorLoc == ERROR_OUTSIDE )
+    /**
+     * Return the approximation for \a aKey, building it with \a aBuilder if it is not cached.
+     */
+    template <typename BUILDER>
+    std::shared_ptr<const SHAPE_POLY_SET> Lookup( const KEY& aKey, BUILDER&& aBuilder )
     {
-        // The outer radius should be radius+aError
-        // Recalculate the actual approx error, as it can be smaller than aError
-        // because numSegs is clamped to a minimal value
-        int actual_delta_radius = CircleToEndSegmentDeltaRadius( radius, numSegs );
-        radius += GetCircleToPolyCorrection( actual_delta_radius );
+        size_t maxEntries = m_maxEntries.load( std::memory_order_relaxed );
+
+        if( maxEntries == 0 )
+            return std::make_shared<const SHAPE_POLY_SET>( aBuilder() );
+
+        size_t hash = KEY_HASH()( aKey );
+        SHARD& shard = m_shards[hash % SHARD_COUNT];
+
+        {
+            std::lock_guard<std::mutex> lock( shard.m_mutex );
+            auto                        it = shard.m_index.find( aKey );
+
+            if( it != shard.m_index.end() )
+            {
+                shard.m_lru.splice( shard.m_lru.begin(), shard.m_lru, it->second );
+                return it->second->second;
+            }
+        }
+
+        // Built outside of the lock.  Two threads may build the same shape concurrently, which
+        // only wastes a little time.
+        std::shared_ptr<const SHAPE_POLY_SET> shape =
+                std::make_shared<const SHAPE_POLY_SET>( aBuilder() );
+
+        std::lock_guard<std::mutex> lock( shard.m_mutex );
+
+        if( shard.m_index.count( aKey ) )
+            return shape;
+
+        shard.m_lru.emplace_front( aKey, shape );
+        shard.m_index[aKey] = shard.m_lru.begin();
+
+        size_t shardCapacity = ( maxEntries + SHARD_COUNT - 1 ) / SHARD_COUNT;
+
+        while( shard.m_lru.size() > shardCapacity )
+        {
+            shard.m_index.erase( shard.m_lru.back().first );
+            shard.m_lru.pop_back();
+        }
+
+        return shape;
     }
 
-    for( EDA_ANGLE angle = delta / 2; angle < ANGLE_360; angle += delta )
+    void SetMaxEntries( size_t aMaxEntries )
     {
-        corner_position.x = radius;
-        corner_position.y = 0;
-        RotatePoint( corner_position, angle );
-        corner_position += aCenter;
-        aBuffer.Append( corner_position.x, corner_position.y );
+        m_maxEntries.store( aMaxEntries );
+
+        for( SHARD& shard : m_shards )
+        {
+            std::lock_guard<std::mutex> lock( shard.m_mutex );
+            shard.m_index.clear();
+            shard.m_lru.clear();
+        }
     }
 
-    aBuffer.SetClosed( true );
+private:
+    APPROXIMATION_CACHE() :
+            m_maxEntries( 4096 )
+    {}
+
+    struct KEY_HASH
+    {
+        size_t operator()( const KEY& aKey ) const
+        {
+            size_t seed = 0xa82de1c0;
+            hash_combine( seed, static_cast<int>( aKey.m_kind ), aKey.m_ratio );
+
+            for( int param : aKey.m_params )
+                hash_combine( seed, param );
+
+            return seed;
+        }
+    };
+
+    typedef std::list<std::pair<KEY, std::shared_ptr<const SHAPE_POLY_SET>>> LRU_LIST;
+
+    struct SHARD
+    {
+        std::mutex                                                m_mutex;
+        LRU_LIST                                                  m_lru;
+        std::unordered_map<KEY, LRU_LIST::iterator, KEY_HASH>     m_index;
+    };
+
+    static constexpr size_t SHARD_COUNT = 16;
+
+    std::atomic<size_t>               m_maxEntries;
+    std::array<SHARD, SHARD_COUNT>    m_shards;
+};
+
+
+void SetApproximationCacheSize( size_t aMaxEntries )
+{
+    APPROXIMATION_CACHE::Get().SetMaxEntries( aMaxEntries );
 }
 
 
-void TransformCircleToPolygon( SHAPE_POLY_SET& aBuffer, const VECTOR2I& aCenter, int aRadius,
+void TransformCircleToPolygon( SHAPE_LINE_CHAIN& aBuffer, const VECTOR2I& aCenter, int aRadius,
                                int aError, ERROR_LOC aErrorLoc, int aMinSegCount )
 {
-    VECTOR2I corner_position;
-    int      numSegs = GetArcToSegmentCount( aRadius, aError, FULL_CIRCLE );
-    numSegs = std::max( aMinSegCount, numSegs );
+    APPROXIMATION_CACHE::KEY key{ APPROXIMATION_CACHE::CIRCLE_CHAIN,
+                                  { aRadius, aError, aErrorLoc, aMinSegCount } };
 
-    // Round up to 8 to make segment approximations align properly at 45-degrees
-    numSegs = ( numSegs + 7 ) / 8 * 8;
+    std::shared_ptr<const SHAPE_POLY_SET> circle = APPROXIMATION_CACHE::Get().Lookup( key,
+            [&]()
+            {
+                VECTOR2I         corner_position;
+                SHAPE_LINE_CHAIN chain;
+                int              numSegs = GetArcToSegmentCount( aRadius, aError, FULL_CIRCLE );
+                numSegs = std::max( aMinSegCount, numSegs );
 
-    EDA_ANGLE delta = ANGLE_360 / numSegs;
-    int       radius = aRadius;
+                // Round up to 8 to make segment approximations align properly at 45-degrees
+                numSegs = ( numSegs + 7 ) / 8 * 8;
 
-    if( aErrorLoc == ERROR_OUTSIDE )
-    {
-        // The outer radius should be radius+aError
-        // Recalculate the actual approx error, as it can be smaller than aError
-        // because numSegs is clamped to a minimal value
-        int actual_delta_radius = CircleToEndSegmentDeltaRadius( radius, numSegs );
-        radius += GetCircleToPolyCorrection( actual_delta_radius );
-    }
+                EDA_ANGLE delta = ANGLE_360 / numSegs;
+                int       radius = aRadius;
 
-    aBuffer.NewOutline();
+                if( aErrorLoc == ERROR_OUTSIDE )
+                {
+                    // The outer radius should be radius+aError
+                    // Recalculate the actual approx error, as it can be smaller than aError
+                    // because numSegs is clamped to a minimal value
+                    int actual_delta_radius = CircleToEndSegmentDeltaRadius( radius, numSegs );
+                    radius += GetCircleToPolyCorrection( actual_delta_radius );
+                }
 
-    for( EDA_ANGLE angle = delta / 2; angle < ANGLE_360; angle += delta )
-    {
-        corner_position.x = radius;
-        corner_position.y = 0;
-        RotatePoint( corner_position, angle );
-        corner_position += aCenter;
-        aBuffer.Append( corner_position.x, corner_position.y );
-    }
+                for( EDA_ANGLE angle = delta / 2; angle < ANGLE_360; angle += delta )
+                {
+                    corner_position.x = radius;
+                    corner_position.y = 0;
+                    RotatePoint( corner_position, angle );
+                    chain.Append( corner_position.x, corner_position.y );
+                }
+
+                chain.SetClosed( true );
+                return SHAPE_POLY_SET( chain );
+            } );
 
-    // Finish circle
-    corner_position.x = radius;
-    corner_position.y = 0;
-    RotatePoint( corner_position, delta / 2 );
-    corner_position += aCenter;
-    aBuffer.Append( corner_position.x, corner_position.y );
+    for( const VECTOR2I& pt : circle->COutline( 0 ).CPoints() )
+        aBuffer.Append( pt + aCenter );
+
+    aBuffer.SetClosed( true );
 }
 
 
-void TransformOvalToPolygon( SHAPE_POLY_SET& aBuffer, const VECTOR2I& aStart, const VECTOR2I& aEnd,
-                             int aWidth, int aError, ERROR_LOC aErrorLoc, int aMinSegCount )
+void TransformCircleToPolygon( SHAPE_POLY_SET& aBuffer, const VECTOR2I& aCenter, int aRadius,
+                               int aError, ERROR_LOC aErrorLoc, int aMinSegCount )
 {
-    // To build the polygonal shape outside the actual shape, we use a bigger
-    // radius to build rounded ends.
-    // However, the width of the segment is too big.
-    // so, later, we will clamp the polygonal shape with the bounding box
-    // of the segment.
-    int radius  = aWidth / 2;
-    int numSegs = GetArcToSegmentCount( radius, aError, FULL_CIRCLE );
-    numSegs = std::max( aMinSegCount, numSegs );
+    APPROXIMATION_CACHE::KEY key{ APPROXIMATION_CACHE::CIRCLE,
+                                  { aRadius, aError, aErrorLoc, aMinSegCount } };
 
-    // Round up to 8 to make segment approximations align properly at 45-degrees
-    numSegs = ( numSegs + 7 ) / 8 * 8;
+    std::shared_ptr<const SHAPE_POLY_SET> circle = APPROXIMATION_CACHE::Get().Lookup( key,
+            [&]()
+            {
+                VECTOR2I       corner_position;
+                SHAPE_POLY_SET polyshape;
+                int            numSegs = GetArcToSegmentCount( aRadius, aError, FULL_CIRCLE );
+                numSegs = std::max( aMinSegCount, numSegs );
 
-    EDA_ANGLE delta = ANGLE_360 / numSegs;
+                // Round up to 8 to make segment approximations align properly at 45-degrees
+                numSegs = ( numSegs + 7 ) / 8 * 8;
 
-    if( aErrorLoc == ERROR_OUTSIDE )
-    {
-        // The outer radius should be radius+aError
-        // Recalculate the actual approx error, as it can be smaller than aError
-        // because numSegs is clamped to a minimal value
-        int actual_delta_radius = CircleToEndSegmentDeltaRadius( radius, numSegs );
-        int correction = GetCircleToPolyCorrection( actual_delta_radius );
-        radius += correction;
-    }
+                EDA_ANGLE delta = ANGLE_360 / numSegs;
+                int       radius = aRadius;
 
-    // end point is the coordinate relative to aStart
-    VECTOR2I       endp = aEnd - aStart;
-    VECTOR2I       startp = aStart;
-    VECTOR2I       corner;
-    SHAPE_POLY_SET polyshape;
+                if( aErrorLoc == ERROR_OUTSIDE )
+                {
+                    // The outer radius should be radius+aError
+                    // Recalculate the actual approx error, as it can be smaller than aError
+                    // because numSegs is clamped to a minimal value
+                    int actual_delta_radius = CircleToEndSegmentDeltaRadius( radius, numSegs );
+                    radius += GetCircleToPolyCorrection( actual_delta_radius );
+                }
 
-    polyshape.NewOutline();
+                polyshape.NewOutline();
+
+                for( EDA_ANGLE angle = delta / 2; angle < ANGLE_360; angle += delta )
+                {
+                    corner_position.x = radius;
+                    corner_position.y = 0;
+                    RotatePoint( corner_position, angle );
+                    polyshape.Append( corner_position.x, corner_position.y );
+                }
+
+                // Finish circle
+                corner_position.x = radius;
+                corner_position.y = 0;
+                RotatePoint( corner_position, delta / 2 );
+                polyshape.Append( corner_position.x, corner_position.y );
+
+                return polyshape;
+            } );
+
+    aBuffer.NewOutline();
+
+    for( const VECTOR2I& pt : circle->COutline( 0 ).CPoints() )
+        aBuffer.Append( pt + aCenter );
+}
+
+
+void TransformOvalToPolygon( SHAPE_POLY_SET& aBuffer, const VECTOR2I& aStart, const VECTOR2I& aEnd,
+                             int aWidth, int aError, ERROR_LOC aErrorLoc, int aMinSegCount )
+{
+    // end point is the coordinate relative to aStart
+    VECTOR2I endp = aEnd - aStart;
+    VECTOR2I startp = aStart;
 
     // normalize the position in order to have endp.x >= 0
     // it makes calculations more easy to understand
@@ -158,67 +304,106 @@ void TransformOvalToPolygon( SHAPE_POLY_SET& aBuffer, const VECTOR2I& aStart, co
     EDA_ANGLE delta_angle( endp );
     int       seg_len = endp.EuclideanNorm();
 
-    // Compute the outlines of the segment, and creates a polygon
-    // Note: the polygonal shape is built from the equivalent horizontal
-    // segment starting at {0,0}, and ending at {seg_len,0}
+    APPROXIMATION_CACHE::KEY key{ APPROXIMATION_CACHE::OVAL,
+                                  { seg_len, aWidth, aError, aErrorLoc, aMinSegCount } };
 
-    // add right rounded end:
+    std::shared_ptr<const SHAPE_POLY_SET> oval = APPROXIMATION_CACHE::Get().Lookup( key,
+            [&]()
+            {
+                // To build the polygonal shape outside the actual shape, we use a bigger
+                // radius to build rounded ends.
+                // However, the width of the segment is too big.
+                // so, later, we will clamp the polygonal shape with the bounding box
+                // of the segment.
+                int radius  = aWidth / 2;
+                int numSegs = GetArcToSegmentCount( radius, aError, FULL_CIRCLE );
+                numSegs = std::max( aMinSegCount, numSegs );
 
-    // Right arc start:
-    corner = VECTOR2I( seg_len, radius );
-    polyshape.Append( corner.x, corner.y );
+                // Round up to 8 to make segment approximations align properly at 45-degrees
+                numSegs = ( numSegs + 7 ) / 8 * 8;
 
-    for( EDA_ANGLE angle = delta / 2; angle < ANGLE_180; angle += delta )
-    {
-        corner = VECTOR2I( 0, radius );
-        RotatePoint( corner, angle );
-        corner.x += seg_len;
-        polyshape.Append( corner.x, corner.y );
-    }
+                EDA_ANGLE delta = ANGLE_360 / numSegs;
 
-    // Finish right arc:
-    corner = VECTOR2I( seg_len, -radius );
-    polyshape.Append( corner.x, corner.y );
+                if( aErrorLoc == ERROR_OUTSIDE )
+                {
+                    // The outer radius should be radius+aError
+                    // Recalculate the actual approx error, as it can be smaller than aError
+                    // because numSegs is clamped to a minimal value
+                    int actual_delta_radius = CircleToEndSegmentDeltaRadius( radius, numSegs );
+                    int correction = GetCircleToPolyCorrection( actual_delta_radius );
+                    radius += correction;
+                }
 
-    // Left arc start:
-    corner = VECTOR2I( 0, -radius );
-    polyshape.Append( corner.x, corner.y );
+                VECTOR2I       corner;
+                SHAPE_POLY_SET polyshape;
 
-    // add left rounded end:
-    for( EDA_ANGLE angle = delta / 2; angle < ANGLE_180; angle += delta )
-    {
-        corner = VECTOR2I( 0, -radius );
-        RotatePoint( corner, angle );
-        polyshape.Append( corner.x, corner.y );
-    }
+                polyshape.NewOutline();
+
+                // Compute the outlines of the segment, and creates a polygon
+                // Note: the polygonal shape is built from the equivalent horizontal
+                // segment starting at {0,0}, and ending at {seg_len,0}
+
+                // add right rounded end:
+
+                // Right arc start:
+                corner = VECTOR2I( seg_len, radius );
+                polyshape.Append( corner.x, corner.y );
+
+                for( EDA_ANGLE angle = delta / 2; angle < ANGLE_180; angle += delta )
+                {
+                    corner = VECTOR2I( 0, radius );
+                    RotatePoint( corner, angle );
+                    corner.x += seg_len;
+                    polyshape.Append( corner.x, corner.y );
+                }
+
+                // Finish right arc:
+                corner = VECTOR2I( seg_len, -radius );
+                polyshape.Append( corner.x, corner.y );
 
-    // Finish left arc:
-    corner = VECTOR2I( 0, radius );
-    polyshape.Append( corner.x, corner.y );
-
-    // Now trim the edges of the polygonal shape which will be slightly outside the
-    // track width.
-    SHAPE_POLY_SET bbox;
-    bbox.NewOutline();
-    // Build the bbox (a horizontal rectangle).
-    int halfwidth = aWidth / 2;     // Use the exact segment width for the bbox height
-    corner.x = -radius - 2;         // use a bbox width slightly bigger to avoid
-                                    // creating useless corner at segment ends
-    corner.y = halfwidth;
-    bbox.Append( corner.x, corner.y );
-    corner.y = -halfwidth;
-    bbox.Append( corner.x, corner.y );
-    corner.x = radius + seg_len + 2;
-    bbox.Append( corner.x, corner.y );
-    corner.y = halfwidth;
-    bbox.Append( corner.x, corner.y );
-
-    // Now, clamp the shape
-    polyshape.BooleanIntersection( bbox );
-    // Note the final polygon is a simple, convex polygon with no hole
-    // due to the shape of initial polygons
+                // Left arc start:
+                corner = VECTOR2I( 0, -radius );
+                polyshape.Append( corner.x, corner.y );
+
+                // add left rounded end:
+                for( EDA_ANGLE angle = delta / 2; angle < ANGLE_180; angle += delta )
+                {
+                    corner = VECTOR2I( 0, -radius );
+                    RotatePoint( corner, angle );
+                    polyshape.Append( corner.x, corner.y );
+                }
+
+                // Finish left arc:
+                corner = VECTOR2I( 0, radius );
+                polyshape.Append( corner.x, corner.y );
+
+                // Now trim the edges of the polygonal shape which will be slightly outside the
+                // track width.
+                SHAPE_POLY_SET bbox;
+                bbox.NewOutline();
+                // Build the bbox (a horizontal rectangle).
+                int halfwidth = aWidth / 2;     // Use the exact segment width for the bbox height
+                corner.x = -radius - 2;         // use a bbox width slightly bigger to avoid
+                                                // creating useless corner at segment ends
+                corner.y = halfwidth;
+                bbox.Append( corner.x, corner.y );
+                corner.y = -halfwidth;
+                bbox.Append( corner.x, corner.y );
+                corner.x = radius + seg_len + 2;
+                bbox.Append( corner.x, corner.y );
+                corner.y = halfwidth;
+                bbox.Append( corner.x, corner.y );
+
+                // Now, clamp the shape
+                polyshape.BooleanIntersection( bbox );
+                // Note the final polygon is a simple, convex polygon with no hole
+                // due to the shape of initial polygons
+
+                return polyshape;
+            } );
 
     // Rotate and move the polygon to its right location
+    SHAPE_POLY_SET polyshape = oval->CloneDropTriangulation();
     polyshape.Rotate( -delta_angle );
     polyshape.Move( startp );
 
@@ -380,66 +565,82 @@ void TransformTrapezoidToPolygon( SHAPE_POLY_SET& aBuffer, const VECTOR2I& aPosi
                                   const VECTOR2I& aSize, const EDA_ANGLE& aRotation, int aDeltaX,
                                   int aDeltaY, int aInflate, int aError, ERROR_LOC aErrorLoc )
 {
-    SHAPE_POLY_SET              outline;
-    VECTOR2I                    size( aSize / 2 );
-    std::vector<ROUNDED_CORNER> corners;
-
-    if( aInflate < 0 )
-    {
-        if( !aDeltaX && !aDeltaY ) // rectangle
-        {
-            size.x = std::max( 1, size.x + aInflate );
-            size.y = std::max( 1, size.y + aInflate );
-        }
-        else if( aDeltaX ) // horizontal trapezoid
-        {
-            double slope = (double) aDeltaX / size.x;
-            int    yShrink = KiROUND( ( std::hypot( size.x, aDeltaX ) * aInflate ) / size.x );
-            size.y = std::max( 1, size.y + yShrink );
-            size.x = std::max( 1, size.x + aInflate );
-            aDeltaX = KiROUND( size.x * slope );
+    APPROXIMATION_CACHE::KEY key{ APPROXIMATION_CACHE::TRAPEZOID,
+                                  { aSize.x, aSize.y, aDeltaX, aDeltaY, aInflate, aError,
+                                    aErrorLoc } };
 
-            if( aDeltaX > size.y ) // shrinking turned the trapezoid into a triangle
+    std::shared_ptr<const SHAPE_POLY_SET> trapezoid = APPROXIMATION_CACHE::Get().Lookup( key,
+            [&]()
             {
-                corners.reserve( 3 );
-                corners.emplace_back( -size.x, -size.y - aDeltaX );
-                corners.emplace_back( KiROUND( size.y / slope ), 0 );
-                corners.emplace_back( -size.x, size.y + aDeltaX );
-            }
-        }
-        else // vertical trapezoid
-        {
-            double slope = (double) aDeltaY / size.y;
-            int    xShrink = KiROUND( ( std::hypot( size.y, aDeltaY ) * aInflate ) / size.y );
-            size.x = std::max( 1, size.x + xShrink );
-            size.y = std::max( 1, size.y + aInflate );
-            aDeltaY = KiROUND( size.y * slope );
+                SHAPE_POLY_SET              outline;
+                VECTOR2I                    size( aSize / 2 );
+                std::vector<ROUNDED_CORNER> corners;
 
-            if( aDeltaY > size.x )
-            {
-                corners.reserve( 3 );
-                corners.emplace_back( 0, -KiROUND( size.x / slope ) );
-                corners.emplace_back( size.x + aDeltaY, size.y );
-                corners.emplace_back( -size.x - aDeltaY, size.y );
-            }
-        }
+                if( aInflate < 0 )
+                {
+                    if( !aDeltaX && !aDeltaY ) // rectangle
+                    {
+                        size.x = std::max( 1, size.x + aInflate );
+                        size.y = std::max( 1, size.y + aInflate );
+                    }
+                    else if( aDeltaX ) // horizontal trapezoid
+                    {
+                        double slope = (double) aDeltaX / size.x;
+                        int    yShrink = KiROUND( ( std::hypot( size.x, aDeltaX ) * aInflate )
+                                                  / size.x );
+                        size.y = std::max( 1, size.y + yShrink );
+                        size.x = std::max( 1, size.x + aInflate );
+                        aDeltaX = KiROUND( size.x * slope );
+
+                        if( aDeltaX > size.y ) // shrinking turned the trapezoid into a triangle
+                        {
+                            corners.reserve( 3 );
+                            corners.emplace_back( -size.x, -size.y - aDeltaX );
+                            corners.emplace_back( KiROUND( size.y / slope ), 0 );
+                            corners.emplace_back( -size.x, size.y + aDeltaX );
+                        }
+                    }
+                    else // vertical trapezoid
+                    {
+                        double slope = (double) aDeltaY / size.y;
+                        int    xShrink = KiROUND( ( std::hypot( size.y, aDeltaY ) * aInflate )
+                                                  / size.y );
+                        size.x = std::max( 1, size.x + xShrink );
+                        size.y = std::max( 1, size.y + aInflate );
+                        aDeltaY = KiROUND( size.y * slope );
+
+                        if( aDeltaY > size.x )
+                        {
+                            corners.reserve( 3 );
+                            corners.emplace_back( 0, -KiROUND( size.x / slope ) );
+                            corners.emplace_back( size.x + aDeltaY, size.y );
+                            corners.emplace_back( -size.x - aDeltaY, size.y );
+                        }
+                    }
 
-        aInflate = 0;
-    }
+                    aInflate = 0;
+                }
 
-    if( corners.empty() )
-    {
-        corners.reserve( 4 );
-        corners.emplace_back( -size.x + aDeltaY, -size.y - aDeltaX );
-        corners.emplace_back( size.x - aDeltaY, -size.y + aDeltaX );
-        corners.emplace_back( size.x + aDeltaY, size.y - aDeltaX );
-        corners.emplace_back( -size.x - aDeltaY, size.y + aDeltaX );
-
-        if( std::abs( aDeltaY ) == std::abs( size.x ) || std::abs( aDeltaX ) == std::abs( size.y ) )
-            CornerListRemoveDuplicates( corners );
-    }
+                if( corners.empty() )
+                {
+                    corners.reserve( 4 );
+                    corners.emplace_back( -size.x + aDeltaY, -size.y - aDeltaX );
+                    corners.emplace_back( size.x - aDeltaY, -size.y + aDeltaX );
+                    corners.emplace_back( size.x + aDeltaY, size.y - aDeltaX );
+                    corners.emplace_back( -size.x - aDeltaY, size.y + aDeltaX );
+
+                    if( std::abs( aDeltaY ) == std::abs( size.x )
+                            || std::abs( aDeltaX ) == std::abs( size.y ) )
+                    {
+                        CornerListRemoveDuplicates( corners );
+                    }
+                }
 
-    CornerListToPolygon( outline, corners, aInflate, aError, aErrorLoc );
+                CornerListToPolygon( outline, corners, aInflate, aError, aErrorLoc );
+                return outline;
+            } );
+
+    SHAPE_POLY_SET outline = trapezoid->CloneDropTriangulation();
 
     if( !aRotation.IsZero() )
         outline.Rotate( aRotation );
@@ -455,58 +656,71 @@ void TransformRoundChamferedRectToPolygon( SHAPE_POLY_SET& aBuffer, const VECTOR
                                            int aChamferCorners, int aInflate, int aError,
                                            ERROR_LOC aErrorLoc )
 {
-    SHAPE_POLY_SET outline;
-    VECTOR2I       size( aSize / 2 );
-    int            chamferCnt = std::bitset<8>( aChamferCorners ).count();
-    double         chamferDeduct = 0;
+    APPROXIMATION_CACHE::KEY key{ APPROXIMATION_CACHE::ROUND_CHAMFERED_RECT,
+                                  { aSize.x, aSize.y, aCornerRadius, aChamferCorners, aInflate,
+                                    aError, aErrorLoc },
+                                  aChamferRatio };
 
-    if( aInflate < 0 )
-    {
-        size.x = std::max( 1, size.x + aInflate );
-        size.y = std::max( 1, size.y + aInflate );
-        chamferDeduct = aInflate * ( 2.0 - M_SQRT2 );
-        aCornerRadius = std::max( 0, aCornerRadius + aInflate );
-        aInflate = 0;
-    }
+    std::shared_ptr<const SHAPE_POLY_SET> rect = APPROXIMATION_CACHE::Get().Lookup( key,
+            [&]()
+            {
+                SHAPE_POLY_SET outline;
+                VECTOR2I       size( aSize / 2 );
+                int            chamferCnt = std::bitset<8>( aChamferCorners ).count();
+                double         chamferDeduct = 0;
+
+                if( aInflate < 0 )
+                {
+                    size.x = std::max( 1, size.x + aInflate );
+                    size.y = std::max( 1, size.y + aInflate );
+                    chamferDeduct = aInflate * ( 2.0 - M_SQRT2 );
+                    aCornerRadius = std::max( 0, aCornerRadius + aInflate );
+                    aInflate = 0;
+                }
 
-    std::vector<ROUNDED_CORNER> corners;
-    corners.reserve( 4 + chamferCnt );
-    corners.emplace_back( -size.x, -size.y, aCornerRadius );
-    corners.emplace_back( size.x, -size.y, aCornerRadius );
-    corners.emplace_back( size.x, size.y, aCornerRadius );
-    corners.emplace_back( -size.x, size.y, aCornerRadius );
+                std::vector<ROUNDED_CORNER> corners;
+                corners.reserve( 4 + chamferCnt );
+                corners.emplace_back( -size.x, -size.y, aCornerRadius );
+                corners.emplace_back( size.x, -size.y, aCornerRadius );
+                corners.emplace_back( size.x, size.y, aCornerRadius );
+                corners.emplace_back( -size.x, size.y, aCornerRadius );
 
-    if( aChamferCorners )
-    {
-        int shorterSide = std::min( aSize.x, aSize.y );
-        int chamfer = std::max( 0, KiROUND( aChamferRatio * shorterSide + chamferDeduct ) );
-        int chamId[4] = { RECT_CHAMFER_TOP_LEFT, RECT_CHAMFER_TOP_RIGHT,
-                          RECT_CHAMFER_BOTTOM_RIGHT, RECT_CHAMFER_BOTTOM_LEFT };
-        int sign[8] = { 0, 1, -1, 0, 0, -1, 1, 0 };
+                if( aChamferCorners )
+                {
+                    int shorterSide = std::min( aSize.x, aSize.y );
+                    int chamfer = std::max( 0, KiROUND( aChamferRatio * shorterSide
+                                                        + chamferDeduct ) );
+                    int chamId[4] = { RECT_CHAMFER_TOP_LEFT, RECT_CHAMFER_TOP_RIGHT,
+                                      RECT_CHAMFER_BOTTOM_RIGHT, RECT_CHAMFER_BOTTOM_LEFT };
+                    int sign[8] = { 0, 1, -1, 0, 0, -1, 1, 0 };
+
+                    for( int cc = 0, pos = 0; cc < 4; cc++, pos++ )
+                    {
+                        if( !( aChamferCorners & chamId[cc] ) )
+                            continue;
 
-        for( int cc = 0, pos = 0; cc < 4; cc++, pos++ )
-        {
-            if( !( aChamferCorners & chamId[cc] ) )
-                continue;
+                        corners[pos].m_radius = 0;
 
-            corners[pos].m_radius = 0;
+                        if( chamfer == 0 )
+                            continue;
 
-            if( chamfer == 0 )
-                continue;
+                        corners.insert( corners.begin() + pos + 1, corners[pos] );
+                        corners[pos].m_position.x += sign[( 2 * cc ) & 7] * chamfer;
+                        corners[pos].m_position.y += sign[( 2 * cc - 2 ) & 7] * chamfer;
+                        corners[pos + 1].m_position.x += sign[( 2 * cc + 1 ) & 7] * chamfer;
+                        corners[pos + 1].m_position.y += sign[( 2 * cc - 1 ) & 7] * chamfer;
+                        pos++;
+                    }
 
-            corners.insert( corners.begin() + pos + 1, corners[pos] );
-            corners[pos].m_position.x += sign[( 2 * cc ) & 7] * chamfer;
-            corners[pos].m_position.y += sign[( 2 * cc - 2 ) & 7] * chamfer;
-            corners[pos + 1].m_position.x += sign[( 2 * cc + 1 ) & 7] * chamfer;
-            corners[pos + 1].m_position.y += sign[( 2 * cc - 1 ) & 7] * chamfer;
-            pos++;
-        }
+                    if( chamferCnt > 1 && 2 * chamfer >= shorterSide )
+                        CornerListRemoveDuplicates( corners );
+                }
 
-        if( chamferCnt > 1 && 2 * chamfer >= shorterSide )
-            CornerListRemoveDuplicates( corners );
-    }
+                CornerListToPolygon( outline, corners, aInflate, aError, aErrorLoc );
+                return outline;
+            } );
 
-    CornerListToPolygon( outline, corners, aInflate, aError, aErrorLoc );
+    SHAPE_POLY_SET outline = rect->CloneDropTriangulation();
 
     if( !aRotation.IsZero() )
         outline.Rotate( aRotation );
@@ -0,0 +1,236 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <geometry/frozen_poly_set.h>
+
+#include <algorithm>
+
+
+static void writeVarint( std::vector<uint8_t>& aBuffer, int64_t aValue )
+{
+    // Zigzag, so that small negative deltas are small too
+    uint64_t value = ( static_cast<uint64_t>( aValue ) << 1 )
+                     ^ static_cast<uint64_t>( aValue >> 63 );
+
+    while( value >= 0x80 )
+    {
+        aBuffer.push_back( static_cast<uint8_t>( value | 0x80 ) );
+        value >>= 7;
+    }
+
+    aBuffer.push_back( static_cast<uint8_t>( value ) );
+}
+
+
+static int64_t readVarint( const uint8_t*& aData )
+{
+    uint64_t value = 0;
+    int      shift = 0;
+
+    while( *aData & 0x80 )
+    {
+        value |= static_cast<uint64_t>( *aData++ & 0x7F ) << shift;
+        shift += 7;
+    }
+
+    value |= static_cast<uint64_t>( *aData++ ) << shift;
+
+    return static_cast<int64_t>( value >> 1 ) ^ -static_cast<int64_t>( value & 1 );
+}
+
+
+FROZEN_POLY_SET::FROZEN_POLY_SET() :
+        m_encoding( ENCODING::PLAIN ),
+        m_polyOffsets( 1, 0 ),
+        m_contourOffsets( 1, 0 )
+{
+}
+
+
+FROZEN_POLY_SET::FROZEN_POLY_SET( const SHAPE_POLY_SET& aSet, ENCODING aEncoding ) :
+        m_encoding( aEncoding )
+{
+    size_t contourCount = 0;
+    size_t vertexCount = 0;
+
+    for( const SHAPE_POLY_SET::POLYGON& poly : aSet.CPolygons() )
+    {
+        contourCount += poly.size();
+
+        for( const SHAPE_LINE_CHAIN& contour : poly )
+            vertexCount += contour.PointCount();
+    }
+
+    m_polyOffsets.reserve( aSet.OutlineCount() + 1 );
+    m_contourOffsets.reserve( contourCount + 1 );
+
+    if( m_encoding == ENCODING::PLAIN )
+    {
+        m_vertices.reserve( vertexCount );
+    }
+    else
+    {
+        m_byteOffsets.reserve( contourCount + 1 );
+        m_byteOffsets.push_back( 0 );
+    }
+
+    m_polyOffsets.push_back( 0 );
+    m_contourOffsets.push_back( 0 );
+
+    for( const SHAPE_POLY_SET::POLYGON& poly : aSet.CPolygons() )
+    {
+        for( const SHAPE_LINE_CHAIN& contour : poly )
+        {
+            if( !contour.m_arcs.empty() )
+            {
+                m_arcData.push_back( { static_cast<uint32_t>( m_contourOffsets.size() - 1 ),
+                                       contour.m_shapes, contour.m_arcs } );
+            }
+
+            encodeContour( contour.CPoints() );
+            m_contourOffsets.push_back( m_contourOffsets.back() + contour.PointCount() );
+        }
+
+        m_polyOffsets.push_back( static_cast<uint32_t>( m_contourOffsets.size() - 1 ) );
+    }
+
+    m_encoded.shrink_to_fit();
+    m_bbox = aSet.BBox();
+}
+
+
+void FROZEN_POLY_SET::encodeContour( const std::vector<VECTOR2I>& aPoints )
+{
+    if( m_encoding == ENCODING::PLAIN )
+    {
+        m_vertices.insert( m_vertices.end(), aPoints.begin(), aPoints.end() );
+        return;
+    }
+
+    // Each contour starts from the origin, so that it can be decoded on its own
+    VECTOR2I prev( 0, 0 );
+
+    for( const VECTOR2I& pt : aPoints )
+    {
+        writeVarint( m_encoded, int64_t( pt.x ) - prev.x );
+        writeVarint( m_encoded, int64_t( pt.y ) - prev.y );
+        prev = pt;
+    }
+
+    m_byteOffsets.push_back( static_cast<uint32_t>( m_encoded.size() ) );
+}
+
+
+void FROZEN_POLY_SET::decodeContour( size_t aContour, std::vector<VECTOR2I>& aPoints ) const
+{
+    size_t first = m_contourOffsets[aContour];
+    size_t count = m_contourOffsets[aContour + 1] - first;
+
+    if( m_encoding == ENCODING::PLAIN )
+    {
+        aPoints.assign( m_vertices.begin() + first, m_vertices.begin() + first + count );
+        return;
+    }
+
+    const uint8_t* data = m_encoded.data() + m_byteOffsets[aContour];
+    int64_t        x = 0;
+    int64_t        y = 0;
+
+    aPoints.clear();
+    aPoints.reserve( count );
+
+    for( size_t ii = 0; ii < count; ii++ )
+    {
+        x += readVarint( data );
+        y += readVarint( data );
+        aPoints.emplace_back( static_cast<int>( x ), static_cast<int>( y ) );
+    }
+}
+
+
+SHAPE_LINE_CHAIN FROZEN_POLY_SET::ThawContour( int aPolygon, int aContour ) const
+{
+    size_t           contour = m_polyOffsets[aPolygon] + aContour;
+    SHAPE_LINE_CHAIN chain;
+
+    decodeContour( contour, chain.m_points );
+
+    auto arcData = std::lower_bound( m_arcData.begin(), m_arcData.end(), contour,
+                                     []( const ARC_DATA& aData, size_t aIndex )
+                                     {
+                                         return aData.m_contour < aIndex;
+                                     } );
+
+    if( arcData != m_arcData.end() && arcData->m_contour == contour )
+    {
+        chain.m_shapes = arcData->m_shapes;
+        chain.m_arcs = arcData->m_arcs;
+    }
+    else
+    {
+        chain.m_shapes.assign( chain.m_points.size(), SHAPE_LINE_CHAIN::SHAPES_ARE_PT );
+    }
+
+    chain.m_closed = true;
+    return chain;
+}
+
+
+SHAPE_POLY_SET FROZEN_POLY_SET::Thaw() const
+{
+    SHAPE_POLY_SET result;
+
+    for( int ii = 0; ii < OutlineCount(); ii++ )
+    {
+        result.NewOutline();
+        result.Outline( ii ) = ThawContour( ii, 0 );
+
+        for( int jj = 0; jj < HoleCount( ii ); jj++ )
+        {
+            result.NewHole( ii );
+            result.Hole( ii, jj ) = ThawContour( ii, jj + 1 );
+        }
+    }
+
+    return result;
+}
+
+
+size_t FROZEN_POLY_SET::MemoryUsage() const
+{
+    size_t usage = sizeof( *this );
+
+    usage += m_polyOffsets.capacity() * sizeof( uint32_t );
+    usage += m_contourOffsets.capacity() * sizeof( uint32_t );
+    usage += m_byteOffsets.capacity() * sizeof( uint32_t );
+    usage += m_vertices.capacity() * sizeof( VECTOR2I );
+    usage += m_encoded.capacity();
+
+    for( const ARC_DATA& arcData : m_arcData )
+    {
+        usage += sizeof( ARC_DATA );
+        usage += arcData.m_shapes.capacity() * sizeof( std::pair<ssize_t, ssize_t> );
+        usage += arcData.m_arcs.capacity() * sizeof( SHAPE_ARC );
+    }
+
+    return usage;
+}
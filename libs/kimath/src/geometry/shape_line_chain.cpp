@@ -199,6 +199,7 @@ void SHAPE_LINE_CHAIN::mergeFirstLastPointIfNeeded()
 
             m_points.pop_back();
             m_shapes.pop_back();
+            m_edgeIndex.reset();
 
             fixIndicesRotation();
         }
@@ -210,6 +211,7 @@ void SHAPE_LINE_CHAIN::mergeFirstLastPointIfNeeded()
             // Create a duplicate point at the end
             m_points.push_back( m_points.front() );
             m_shapes.push_back( { m_shapes.front().first, SHAPE_IS_PT } );
+            m_edgeIndex.reset();
             m_shapes.front().first = m_shapes.front().second;
             m_shapes.front().second = SHAPE_IS_PT;
         }
@@ -344,6 +346,31 @@ void SHAPE_LINE_CHAIN::splitArc( ssize_t aPtIndex, bool aCoincident )
 }
 
 
+/**
+ * Squared distance from \a aP to the bounding box of the segment \a aA, \a aB.  The nearest
+ * point of the segment lies within that box, so this is a cheap lower bound of the distance to
+ * the segment.
+ */
+static inline SEG::ecoord boxSquaredDistance( const VECTOR2I& aA, const VECTOR2I& aB,
+                                              const VECTOR2I& aP )
+{
+    SEG::ecoord dx = 0;
+    SEG::ecoord dy = 0;
+
+    if( aP.x < std::min( aA.x, aB.x ) )
+        dx = SEG::ecoord( std::min( aA.x, aB.x ) ) - aP.x;
+    else if( aP.x > std::max( aA.x, aB.x ) )
+        dx = SEG::ecoord( aP.x ) - std::max( aA.x, aB.x );
+
+    if( aP.y < std::min( aA.y, aB.y ) )
+        dy = SEG::ecoord( std::min( aA.y, aB.y ) ) - aP.y;
+    else if( aP.y > std::max( aA.y, aB.y ) )
+        dy = SEG::ecoord( aP.y ) - std::max( aA.y, aB.y );
+
+    return dx * dx + dy * dy;
+}
+
+
 bool SHAPE_LINE_CHAIN_BASE::Collide( const VECTOR2I& aP, int aClearance, int* aActual,
                                      VECTOR2I* aLocation ) const
 {
@@ -415,14 +442,24 @@ bool SHAPE_LINE_CHAIN::Collide( const VECTOR2I& aP, int aClearance, int* aActual
     SEG::ecoord clearance_sq = SEG::Square( aClearance );
     VECTOR2I    nearest;
 
-    // Collide line segments
-    for( size_t i = 0; i < GetSegmentCount(); i++ )
+    const size_t    pointCount = m_points.size();
+    const size_t    segCount = SegmentCount();
+    const VECTOR2I* pts = m_points.data();
+
+    // Collide line segments.  Segments whose bounding box is no closer than the best match so
+    // far can't improve on it and are skipped without computing their nearest point.
+    for( size_t i = 0; i < segCount; i++ )
     {
         if( IsArcSegment( i ) )
             continue;
 
-        const SEG&  s = GetSegment( i );
-        VECTOR2I    pn = s.NearestPoint( aP );
+        const VECTOR2I& a = pts[i];
+        const VECTOR2I& b = pts[i + 1 == pointCount ? 0 : i + 1];
+
+        if( boxSquaredDistance( a, b, aP ) >= closest_dist_sq )
+            continue;
+
+        VECTOR2I    pn = SEG( a, b ).NearestPoint( aP );
         SEG::ecoord dist_sq = ( pn - aP ).SquaredEuclideanNorm();
 
         if( dist_sq < closest_dist_sq )
@@ -468,8 +505,9 @@ bool SHAPE_LINE_CHAIN::Collide( const VECTOR2I& aP, int aClearance, int* aActual
 
 void SHAPE_LINE_CHAIN::Rotate( const EDA_ANGLE& aAngle, const VECTOR2I& aCenter )
 {
-    for( VECTOR2I& pt : m_points )
-        RotatePoint( pt, aCenter, aAngle );
+    m_edgeIndex.reset();
+
+    RotatePoints( m_points.data(), m_points.size(), aCenter, aAngle );
 
     for( SHAPE_ARC& arc : m_arcs )
         arc.Rotate( aAngle, aCenter );
@@ -804,13 +842,17 @@ bool SHAPE_LINE_CHAIN::Collide( const SEG& aSeg, int aClearance, int* aActual,
     SEG::ecoord clearance_sq = SEG::Square( aClearance );
     VECTOR2I    nearest;
 
+    const size_t    pointCount = m_points.size();
+    const size_t    segCount = SegmentCount();
+    const VECTOR2I* pts = m_points.data();
+
     // Collide line segments
-    for( size_t i = 0; i < GetSegmentCount(); i++ )
+    for( size_t i = 0; i < segCount; i++ )
     {
         if( IsArcSegment( i ) )
             continue;
 
-        const SEG&  s = GetSegment( i );
+        const SEG   s( pts[i], pts[i + 1 == pointCount ? 0 : i + 1] );
         SEG::ecoord dist_sq = s.SquaredDistance( aSeg );
 
         if( dist_sq < closest_dist_sq )
@@ -947,13 +989,9 @@ long long int SHAPE_LINE_CHAIN::Length() const
 
 void SHAPE_LINE_CHAIN::Mirror( const VECTOR2I& aRef, FLIP_DIRECTION aFlipDirection )
 {
-    for( auto& pt : m_points )
-    {
-        if( aFlipDirection == FLIP_DIRECTION::LEFT_RIGHT )
-            pt.x = -pt.x + 2 * aRef.x;
-        else
-            pt.y = -pt.y + 2 * aRef.y;
-    }
+    m_edgeIndex.reset();
+
+    MirrorPoints( m_points.data(), m_points.size(), aRef, aFlipDirection );
 
     for( auto& arc : m_arcs )
         arc.Mirror( aRef, aFlipDirection );
@@ -962,6 +1000,8 @@ void SHAPE_LINE_CHAIN::Mirror( const VECTOR2I& aRef, FLIP_DIRECTION aFlipDirecti
 
 void SHAPE_LINE_CHAIN::Mirror( const SEG& axis )
 {
+    m_edgeIndex.reset();
+
     for( auto& pt : m_points )
         pt = axis.ReflectPoint( pt );
 
@@ -980,6 +1020,8 @@ void SHAPE_LINE_CHAIN::Replace( int aStartIndex, int aEndIndex, const VECTOR2I&
 
 void SHAPE_LINE_CHAIN::Replace( int aStartIndex, int aEndIndex, const SHAPE_LINE_CHAIN& aLine )
 {
+    m_edgeIndex.reset();
+
     if( aEndIndex < 0 )
         aEndIndex += PointCount();
 
@@ -1050,6 +1092,8 @@ void SHAPE_LINE_CHAIN::Replace( int aStartIndex, int aEndIndex, const SHAPE_LINE
 
 void SHAPE_LINE_CHAIN::Remove( int aStartIndex, int aEndIndex )
 {
+    m_edgeIndex.reset();
+
     wxCHECK( m_shapes.size() == m_points.size(), /*void*/ );
 
     // Unwrap the chain first (correctly handling removing arc at
@@ -1152,6 +1196,26 @@ SEG::ecoord SHAPE_LINE_CHAIN_BASE::SquaredDistance( const VECTOR2I& aP, bool aOu
 }
 
 
+SEG::ecoord SHAPE_LINE_CHAIN::SquaredDistance( const VECTOR2I& aP, bool aOutlineOnly ) const
+{
+    ecoord d = VECTOR2I::ECOORD_MAX;
+
+    if( IsClosed() && PointInside( aP ) && !aOutlineOnly )
+        return 0;
+
+    // Same as the base class, but reading the points directly rather than building each
+    // segment through the virtual accessors.
+    const size_t    pointCount = m_points.size();
+    const size_t    segCount = SegmentCount();
+    const VECTOR2I* pts = m_points.data();
+
+    for( size_t i = 0; i < segCount; i++ )
+        d = std::min( d, SEG( pts[i], pts[i + 1 == pointCount ? 0 : i + 1] ).SquaredDistance( aP ) );
+
+    return d;
+}
+
+
 int SHAPE_LINE_CHAIN::Split( const VECTOR2I& aP, bool aExact )
 {
     int ii = -1;
@@ -1194,6 +1258,7 @@ int SHAPE_LINE_CHAIN::Split( const VECTOR2I& aP, bool aExact )
         {
             m_points.insert( m_points.begin() + newIndex, aP );
             m_shapes.insert( m_shapes.begin() + newIndex, { ArcIndex( ii ), SHAPE_IS_PT } );
+            m_edgeIndex.reset();
             splitArc( newIndex, true ); // Make the inserted point a shared point
         }
         else
@@ -1341,6 +1406,7 @@ void SHAPE_LINE_CHAIN::SetPoint( int aIndex, const VECTOR2I& aPos )
         aIndex -= PointCount();
 
     m_points[aIndex] = aPos;
+    m_edgeIndex.reset();
 
     alg::run_on_pair( m_shapes[aIndex],
         [&]( ssize_t& aIdx )
@@ -1514,6 +1580,8 @@ const SHAPE_LINE_CHAIN SHAPE_LINE_CHAIN::Slice( int aStartIndex, int aEndIndex )
 
 void SHAPE_LINE_CHAIN::Append( const SHAPE_LINE_CHAIN& aOtherLine )
 {
+    m_edgeIndex.reset();
+
     assert( m_shapes.size() == m_points.size() );
 
     if( aOtherLine.PointCount() == 0 )
@@ -1605,6 +1673,8 @@ void SHAPE_LINE_CHAIN::Append( const SHAPE_ARC& aArc, double aAccuracy )
 
 void SHAPE_LINE_CHAIN::Insert( size_t aVertex, const VECTOR2I& aP )
 {
+    m_edgeIndex.reset();
+
     if( aVertex == m_points.size() )
     {
         Append( aP );
@@ -1626,6 +1696,8 @@ void SHAPE_LINE_CHAIN::Insert( size_t aVertex, const VECTOR2I& aP )
 
 void SHAPE_LINE_CHAIN::Insert( size_t aVertex, const SHAPE_ARC& aArc )
 {
+    m_edgeIndex.reset();
+
     wxCHECK( aVertex < m_points.size(), /* void */ );
 
     if( aVertex > 0 && IsPtOnArc( aVertex ) )
@@ -1910,6 +1982,200 @@ bool SHAPE_LINE_CHAIN_BASE::PointInside( const VECTOR2I& aPt, int aAccuracy,
 }
 
 
+void SHAPE_LINE_CHAIN::buildEdgeIndex() const
+{
+    // Below this a linear scan is about as fast as the index lookup
+    const size_t minIndexedPoints = 64;
+
+    // Edges spanning more bands than this go to the long edge list instead
+    const int maxEdgeBands = 8;
+
+    const size_t pointCount = m_points.size();
+
+    if( !m_closed || pointCount < minIndexedPoints )
+    {
+        m_edgeIndex.reset();
+        return;
+    }
+
+    auto index = std::make_shared<EDGE_INDEX>();
+
+    index->m_yMin = m_points[0].y;
+    index->m_yMax = m_points[0].y;
+
+    for( const VECTOR2I& pt : m_points )
+    {
+        index->m_yMin = std::min( index->m_yMin, pt.y );
+        index->m_yMax = std::max( index->m_yMax, pt.y );
+    }
+
+    // Aim for a handful of edges per band
+    int64_t height = int64_t( index->m_yMax ) - index->m_yMin + 1;
+    int64_t bandCount = std::clamp<int64_t>( pointCount / 4, 1, 1 << 16 );
+
+    index->m_bandHeight = (int) std::max<int64_t>( 1, ( height + bandCount - 1 ) / bandCount );
+    bandCount = ( height + index->m_bandHeight - 1 ) / index->m_bandHeight;
+    index->m_pointCount = pointCount;
+    index->m_bandStart.assign( bandCount + 1, 0 );
+
+    auto edgeBands =
+            [&]( size_t aEdge ) -> std::pair<int, int>
+            {
+                const VECTOR2I& a = m_points[aEdge];
+                const VECTOR2I& b = m_points[aEdge + 1 == pointCount ? 0 : aEdge + 1];
+
+                return { index->Band( std::min( a.y, b.y ) ), index->Band( std::max( a.y, b.y ) ) };
+            };
+
+    // Count, prefix-sum, then fill: the edges of each band end up contiguous
+    for( size_t ii = 0; ii < pointCount; ii++ )
+    {
+        auto [first, last] = edgeBands( ii );
+
+        if( last - first >= maxEdgeBands )
+        {
+            index->m_longEdges.push_back( (uint32_t) ii );
+            continue;
+        }
+
+        for( int band = first; band <= last; band++ )
+            index->m_bandStart[band + 1]++;
+    }
+
+    for( size_t band = 0; band < (size_t) bandCount; band++ )
+        index->m_bandStart[band + 1] += index->m_bandStart[band];
+
+    std::vector<uint32_t> fill( index->m_bandStart.begin(), index->m_bandStart.end() - 1 );
+    index->m_edges.resize( index->m_bandStart.back() );
+
+    for( size_t ii = 0; ii < pointCount; ii++ )
+    {
+        auto [first, last] = edgeBands( ii );
+
+        if( last - first >= maxEdgeBands )
+            continue;
+
+        for( int band = first; band <= last; band++ )
+            index->m_edges[fill[band]++] = (uint32_t) ii;
+    }
+
+    m_edgeIndex = std::move( index );
+}
+
+
+const SHAPE_LINE_CHAIN::EDGE_INDEX* SHAPE_LINE_CHAIN::validEdgeIndex() const
+{
+    if( m_edgeIndex && m_closed && m_edgeIndex->m_pointCount == m_points.size() )
+        return m_edgeIndex.get();
+
+    return nullptr;
+}
+
+
+bool SHAPE_LINE_CHAIN::PointInside( const VECTOR2I& aPt, int aAccuracy,
+                                    bool aUseBBoxCache ) const
+{
+    if( aUseBBoxCache && !m_bbox.Contains( aPt ) )
+        return false;
+
+    const size_t pointCount = m_points.size();
+
+    if( !m_closed || pointCount < 3 )
+        return false;
+
+    const EDGE_INDEX* index = aUseBBoxCache ? validEdgeIndex() : nullptr;
+
+    if( index )
+    {
+        // Only the edges spanning aPt's band can cross the ray, and only the edges in the
+        // bands within aAccuracy can be close enough to count as "on edge".
+        const VECTOR2I* pts = m_points.data();
+        bool            inside = false;
+
+        auto crossEdge =
+                [&]( size_t aEdge )
+                {
+                    const VECTOR2I& p1 = pts[aEdge];
+                    const VECTOR2I& p2 = pts[aEdge + 1 == pointCount ? 0 : aEdge + 1];
+
+                    if( ( p1.y >= aPt.y ) == ( p2.y >= aPt.y ) )
+                        return;
+
+                    const VECTOR2I diff = p2 - p1;
+                    const int      d = rescale( diff.x, ( aPt.y - p1.y ), diff.y );
+
+                    if( aPt.x - p1.x < d )
+                        inside = !inside;
+                };
+
+        auto nearEdge =
+                [&]( size_t aEdge )
+                {
+                    SEG s( pts[aEdge], pts[aEdge + 1 == pointCount ? 0 : aEdge + 1] );
+
+                    return s.A == aPt || s.B == aPt || s.Distance( aPt ) <= aAccuracy + 1;
+                };
+
+        if( aPt.y >= index->m_yMin && aPt.y <= index->m_yMax )
+        {
+            int band = index->Band( aPt.y );
+
+            for( uint32_t ii = index->m_bandStart[band]; ii < index->m_bandStart[band + 1]; ii++ )
+                crossEdge( index->m_edges[ii] );
+
+            for( uint32_t edge : index->m_longEdges )
+                crossEdge( edge );
+        }
+
+        if( inside || aAccuracy <= 1 )
+            return inside;
+
+        int first = index->Band( aPt.y - aAccuracy - 1 );
+        int last = index->Band( aPt.y + aAccuracy + 1 );
+
+        for( uint32_t ii = index->m_bandStart[first]; ii < index->m_bandStart[last + 1]; ii++ )
+        {
+            if( nearEdge( index->m_edges[ii] ) )
+                return true;
+        }
+
+        for( uint32_t edge : index->m_longEdges )
+        {
+            if( nearEdge( edge ) )
+                return true;
+        }
+
+        return false;
+    }
+
+    // The same crossing test as SHAPE_LINE_CHAIN_BASE::PointInside(), walking the point array
+    // directly.  Edges which don't straddle the horizontal through aPt are rejected before the
+    // (comparatively expensive) intersection is computed.
+    const VECTOR2I* pts = m_points.data();
+    bool            inside = false;
+
+    for( size_t i = 0; i < pointCount; i++ )
+    {
+        const VECTOR2I& p1 = pts[i];
+        const VECTOR2I& p2 = pts[i + 1 == pointCount ? 0 : i + 1];
+
+        if( ( p1.y >= aPt.y ) == ( p2.y >= aPt.y ) )
+            continue;
+
+        const VECTOR2I diff = p2 - p1;
+        const int      d = rescale( diff.x, ( aPt.y - p1.y ), diff.y );
+
+        if( aPt.x - p1.x < d )
+            inside = !inside;
+    }
+
+    if( aAccuracy <= 1 )
+        return inside;
+    else
+        return inside || PointOnEdge( aPt, aAccuracy );
+}
+
+
 bool SHAPE_LINE_CHAIN_BASE::PointOnEdge( const VECTOR2I& aPt, int aAccuracy ) const
 {
 	return EdgeContainingPoint( aPt, aAccuracy ) >= 0;
@@ -2205,9 +2471,13 @@ const VECTOR2I SHAPE_LINE_CHAIN::NearestPoint( const VECTOR2I& aP,
     int min_d = std::numeric_limits<int>::max();
     int nearest = 0;
 
-    for( int i = 0; i < SegmentCount(); i++ )
+    const int       pointCount = PointCount();
+    const int       segCount = SegmentCount();
+    const VECTOR2I* pts = m_points.data();
+
+    for( int i = 0; i < segCount; i++ )
     {
-        int d = CSegment( i ).Distance( aP );
+        int d = SEG( pts[i], pts[i + 1 == pointCount ? 0 : i + 1] ).Distance( aP );
 
         if( d < min_d )
         {
@@ -2361,6 +2631,8 @@ SHAPE* SHAPE_LINE_CHAIN::Clone() const
 
 bool SHAPE_LINE_CHAIN::Parse( std::stringstream& aStream )
 {
+    m_edgeIndex.reset();
+
     size_t n_pts;
     size_t n_arcs;
 
@@ -2458,6 +2730,8 @@ double SHAPE_LINE_CHAIN::Area( bool aAbsolute ) const
 
 void SHAPE_LINE_CHAIN::RemoveDuplicatePoints()
 {
+    m_edgeIndex.reset();
+
     std::vector<VECTOR2I> pts_unique;
     std::vector<std::pair<ssize_t, ssize_t>> shapes_unique;
 
@@ -2520,6 +2794,8 @@ void SHAPE_LINE_CHAIN::RemoveDuplicatePoints()
 
 void SHAPE_LINE_CHAIN::Simplify( int aMaxError )
 {
+    m_edgeIndex.reset();
+
     if( PointCount() < 3 )
         return;
 
@@ -2644,6 +2920,8 @@ void SHAPE_LINE_CHAIN::Split( const VECTOR2I& aStart, const VECTOR2I& aEnd, SHAP
 
 SHAPE_LINE_CHAIN& SHAPE_LINE_CHAIN::Simplify2( bool aRemoveColinear )
 {
+    m_edgeIndex.reset();
+
     std::vector<VECTOR2I> pts_unique;
     std::vector<std::pair<ssize_t, ssize_t>> shapes_unique;
 
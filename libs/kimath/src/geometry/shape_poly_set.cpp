@@ -32,16 +32,21 @@
 #include <assert.h>                          // for assert
 #include <cmath>                             // for sqrt, cos, hypot, isinf
 #include <cstdio>
+#include <functional>
 #include <istream>                           // for operator<<, operator>>
 #include <limits>                            // for numeric_limits
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string> // for char_traits, operator!=
+#include <thread>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility> // for swap, move
 #include <vector>
 
+#include <bs_thread_pool.hpp>
 #include <clipper2/clipper.h>
 #include <geometry/geometry_utils.h>
 #include <geometry/polygon_triangulation.h>
@@ -908,6 +913,322 @@ void SHAPE_POLY_SET::BooleanXor( const SHAPE_POLY_SET& a, const SHAPE_POLY_SET&
 }
 
 
+/**
+ * Call \a aFunc for each index in [0, \a aCount) on \a aPool, returning once all the calls are
+ * done.  The calling thread works through the indices as well, so this can't deadlock when it is
+ * itself running on the pool and all the other workers are busy.
+ */
+static void parallelFor( BS::thread_pool& aPool, size_t aCount,
+                         const std::function<void( size_t )>& aFunc )
+{
+    struct STATE
+    {
+        std::function<void( size_t )> func;
+        size_t                         count = 0;
+        std::atomic<size_t>            next = 0;
+        std::atomic<size_t>            done = 0;
+    };
+
+    auto state = std::make_shared<STATE>();
+    state->func = aFunc;
+    state->count = aCount;
+
+    auto worker =
+            [state]()
+            {
+                for( size_t ii = state->next++; ii < state->count; ii = state->next++ )
+                {
+                    state->func( ii );
+                    state->done++;
+                }
+            };
+
+    size_t helpers = std::min<size_t>( aPool.get_thread_count(), aCount );
+
+    for( size_t ii = 1; ii < helpers; ii++ )
+        aPool.push_task( worker );
+
+    worker();
+
+    while( state->done < state->count )
+        std::this_thread::yield();
+}
+
+
+void SHAPE_POLY_SET::BooleanAdd( const SHAPE_POLY_SET& b, BS::thread_pool& aPool )
+{
+    booleanOp( Clipper2Lib::ClipType::Union, *this, b, aPool );
+}
+
+
+void SHAPE_POLY_SET::BooleanSubtract( const SHAPE_POLY_SET& b, BS::thread_pool& aPool )
+{
+    booleanOp( Clipper2Lib::ClipType::Difference, *this, b, aPool );
+}
+
+
+void SHAPE_POLY_SET::booleanOp( Clipper2Lib::ClipType aType, const SHAPE_POLY_SET& aShape,
+                                const SHAPE_POLY_SET& aOtherShape, BS::thread_pool& aPool )
+{
+    // Below this the clustering and thread hand-off cost more than they save
+    const size_t minParallelOutlines = 256;
+
+    const size_t subjectCount = aShape.m_polys.size();
+    const size_t outlineCount = subjectCount + aOtherShape.m_polys.size();
+
+    if( outlineCount < minParallelOutlines || aPool.get_thread_count() < 2
+            || aShape.ArcCount() > 0 || aOtherShape.ArcCount() > 0 )
+    {
+        booleanOp( aType, aShape, aOtherShape );
+        return;
+    }
+
+    auto outline =
+            [&]( size_t aIdx ) -> const POLYGON&
+            {
+                return aIdx < subjectCount ? aShape.m_polys[aIdx]
+                                           : aOtherShape.m_polys[aIdx - subjectCount];
+            };
+
+    // Outlines whose bounding boxes don't touch cannot interact, so the operation can be run
+    // separately on each group of touching outlines.  Boxes are grown by one unit so that
+    // outlines which merely share an edge or a vertex end up in the same group.
+    std::vector<BOX2I> bboxes( outlineCount );
+    std::vector<size_t> order( outlineCount );
+    std::vector<size_t> parent( outlineCount );
+
+    for( size_t ii = 0; ii < outlineCount; ii++ )
+    {
+        bboxes[ii] = outline( ii ).front().BBox( 1 );
+        order[ii] = ii;
+        parent[ii] = ii;
+    }
+
+    auto find =
+            [&]( size_t aIdx ) -> size_t
+            {
+                while( parent[aIdx] != aIdx )
+                {
+                    parent[aIdx] = parent[parent[aIdx]];
+                    aIdx = parent[aIdx];
+                }
+
+                return aIdx;
+            };
+
+    std::sort( order.begin(), order.end(),
+               [&]( size_t aA, size_t aB )
+               {
+                   return bboxes[aA].GetLeft() < bboxes[aB].GetLeft();
+               } );
+
+    std::vector<size_t> active;
+
+    for( size_t idx : order )
+    {
+        const BOX2I& bbox = bboxes[idx];
+
+        std::erase_if( active,
+                       [&]( size_t aOther )
+                       {
+                           return bboxes[aOther].GetRight() < bbox.GetLeft();
+                       } );
+
+        for( size_t other : active )
+        {
+            if( bboxes[other].Intersects( bbox ) )
+            {
+                size_t a = find( idx );
+                size_t b = find( other );
+
+                if( a != b )
+                    parent[std::max( a, b )] = std::min( a, b );
+            }
+        }
+
+        active.push_back( idx );
+    }
+
+    // Gather the clusters, in order of their first outline so that the result is
+    // deterministic, and pack them into tasks of roughly equal size.
+    std::vector<std::vector<size_t>> clusters;
+    std::vector<int>                 clusterOf( outlineCount, -1 );
+
+    for( size_t ii = 0; ii < outlineCount; ii++ )
+    {
+        size_t root = find( ii );
+
+        if( clusterOf[root] < 0 )
+        {
+            clusterOf[root] = static_cast<int>( clusters.size() );
+            clusters.emplace_back();
+        }
+
+        clusters[clusterOf[root]].push_back( ii );
+    }
+
+    struct TASK
+    {
+        SHAPE_POLY_SET subject;
+        SHAPE_POLY_SET clip;
+        SHAPE_POLY_SET result;
+        BOX2I          strip;              ///< Part of the cluster handled, for split clusters
+        int            stitchGroup = -1;   ///< Tasks of the same split cluster
+    };
+
+    // The task sizes don't depend on the thread count, so that the result is the same on any
+    // machine
+    const size_t taskTarget = minParallelOutlines / 2;
+    const size_t maxStrips = 16;
+
+    std::vector<TASK> tasks;
+    TASK*             task = nullptr;
+    int               stitchGroups = 0;
+
+    tasks.reserve( clusters.size() );
+
+    for( const std::vector<size_t>& cluster : clusters )
+    {
+        // Clip outlines on their own don't contribute anything to a difference
+        if( aType == Clipper2Lib::ClipType::Difference && cluster.front() >= subjectCount )
+            continue;
+
+        if( cluster.size() < 2 * taskTarget )
+        {
+            if( !task || task->stitchGroup >= 0
+                    || task->subject.m_polys.size() + task->clip.m_polys.size() >= taskTarget )
+            {
+                task = &tasks.emplace_back();
+            }
+
+            for( size_t idx : cluster )
+            {
+                if( idx < subjectCount )
+                    task->subject.m_polys.push_back( outline( idx ) );
+                else
+                    task->clip.m_polys.push_back( outline( idx ) );
+            }
+
+            continue;
+        }
+
+        // A cluster too large for one task (typically a zone outline and all its knockouts)
+        // is cut into vertical strips which are processed separately and stitched back
+        // together with a union.  Outlines crossing a strip boundary go to both strips.
+        BOX2I clusterBox;
+
+        for( size_t idx : cluster )
+            clusterBox.Merge( bboxes[idx] );
+
+        size_t stripCount = std::min( maxStrips, cluster.size() / taskTarget );
+        int    stripWidth = static_cast<int>( ( clusterBox.GetWidth() + stripCount - 1 )
+                                              / stripCount );
+        int    firstTask = static_cast<int>( tasks.size() );
+
+        for( size_t ii = 0; ii < stripCount; ii++ )
+        {
+            int left = clusterBox.GetLeft() + static_cast<int>( ii ) * stripWidth;
+            int right = ii + 1 < stripCount ? left + stripWidth : clusterBox.GetRight();
+
+            task = &tasks.emplace_back();
+            task->strip.SetOrigin( left, clusterBox.GetTop() );
+            task->strip.SetEnd( right, clusterBox.GetBottom() );
+            task->stitchGroup = stitchGroups;
+
+            for( size_t idx : cluster )
+            {
+                if( bboxes[idx].GetRight() < left || bboxes[idx].GetLeft() > right )
+                    continue;
+
+                if( idx < subjectCount )
+                    task->subject.m_polys.push_back( outline( idx ) );
+                else
+                    task->clip.m_polys.push_back( outline( idx ) );
+            }
+
+            // Nothing to subtract from in this strip
+            if( aType == Clipper2Lib::ClipType::Difference && task->subject.m_polys.empty() )
+                tasks.pop_back();
+        }
+
+        if( static_cast<int>( tasks.size() ) > firstTask )
+            stitchGroups++;
+
+        task = nullptr;
+    }
+
+    parallelFor( aPool, tasks.size(),
+                 [&]( size_t aIdx )
+                 {
+                     TASK& t = tasks[aIdx];
+
+                     if( t.stitchGroup < 0 )
+                     {
+                         t.result.booleanOp( aType, t.subject, t.clip );
+                         return;
+                     }
+
+                     SHAPE_POLY_SET strip;
+                     strip.NewOutline();
+                     strip.Append( t.strip.GetLeft(), t.strip.GetTop() );
+                     strip.Append( t.strip.GetRight(), t.strip.GetTop() );
+                     strip.Append( t.strip.GetRight(), t.strip.GetBottom() );
+                     strip.Append( t.strip.GetLeft(), t.strip.GetBottom() );
+
+                     // (S - C) & R is (S & R) - C, which saves carrying the whole subject
+                     // through the difference
+                     if( aType == Clipper2Lib::ClipType::Difference )
+                     {
+                         SHAPE_POLY_SET subject;
+                         subject.booleanOp( Clipper2Lib::ClipType::Intersection, t.subject,
+                                            strip );
+                         t.result.booleanOp( aType, subject, t.clip );
+                     }
+                     else
+                     {
+                         SHAPE_POLY_SET unclipped;
+                         unclipped.booleanOp( aType, t.subject, t.clip );
+                         t.result.booleanOp( Clipper2Lib::ClipType::Intersection, unclipped,
+                                             strip );
+                     }
+                 } );
+
+    std::vector<POLYGON> result;
+
+    for( size_t ii = 0; ii < tasks.size(); ii++ )
+    {
+        if( tasks[ii].stitchGroup < 0 )
+        {
+            for( POLYGON& poly : tasks[ii].result.m_polys )
+                result.push_back( std::move( poly ) );
+
+            continue;
+        }
+
+        // The strips of a split cluster share their boundaries exactly, so a union merges them
+        // back.  Only points where an edge crosses a strip boundary are added.
+        SHAPE_POLY_SET strips;
+        int            group = tasks[ii].stitchGroup;
+
+        for( ; ii < tasks.size() && tasks[ii].stitchGroup == group; ii++ )
+        {
+            for( POLYGON& poly : tasks[ii].result.m_polys )
+                strips.m_polys.push_back( std::move( poly ) );
+        }
+
+        ii--;
+
+        SHAPE_POLY_SET stitched;
+        stitched.booleanOp( Clipper2Lib::ClipType::Union, strips, SHAPE_POLY_SET() );
+
+        for( POLYGON& poly : stitched.m_polys )
+            result.push_back( std::move( poly ) );
+    }
+
+    m_polys = std::move( result );
+}
+
+
 void SHAPE_POLY_SET::InflateWithLinkedHoles( int aFactor, CORNER_STRATEGY aCornerStrategy,
                                              int aMaxError )
 {
@@ -1224,8 +1545,50 @@ struct FractureEdge
 typedef std::vector<FractureEdge> FractureEdgeSet;
 
 
+/**
+ * Edges bucketed by horizontal bands, so that looking for the edges crossing a given Y only has
+ * to look at one band's worth of them instead of at every edge of the polygon.
+ */
+struct FractureEdgeBands
+{
+    FractureEdgeBands( int aYMin, int aYMax, int aBandCount ) :
+            m_yMin( aYMin ),
+            m_bandHeight( ( (int64_t) aYMax - aYMin ) / aBandCount + 1 ),
+            m_bands( aBandCount )
+    {
+    }
+
+    int band( int aY ) const
+    {
+        int64_t band = ( (int64_t) aY - m_yMin ) / m_bandHeight;
+
+        return static_cast<int>( std::clamp<int64_t>( band, 0, (int64_t) m_bands.size() - 1 ) );
+    }
+
+    void Add( const FractureEdgeSet& aEdges, FractureEdge::Index aIndex )
+    {
+        const FractureEdge& edge = aEdges[aIndex];
+        int                 last = band( std::max( edge.m_p1.y, edge.m_p2.y ) );
+
+        for( int ii = band( std::min( edge.m_p1.y, edge.m_p2.y ) ); ii <= last; ii++ )
+            m_bands[ii].push_back( aIndex );
+    }
+
+    /// Edges which may cross \a aY.  Edges shortened after being added stay in their old bands.
+    const std::vector<FractureEdge::Index>& Candidates( int aY ) const
+    {
+        return m_bands[band( aY )];
+    }
+
+    int64_t                                        m_yMin;
+    int64_t                                        m_bandHeight;
+    std::vector<std::vector<FractureEdge::Index>> m_bands;
+};
+
+
 static FractureEdge* processHole( FractureEdgeSet& edges, FractureEdge::Index provokingIndex,
-                                  FractureEdge::Index edgeIndex, FractureEdge::Index bridgeIndex )
+                                  FractureEdge::Index edgeIndex, FractureEdge::Index bridgeIndex,
+                                  FractureEdgeBands* aBands )
 {
     FractureEdge& edge = edges[edgeIndex];
     int           x = edge.m_p1.x;
@@ -1233,38 +1596,55 @@ static FractureEdge* processHole( FractureEdgeSet& edges, FractureEdge::Index pr
     int           min_dist = std::numeric_limits<int>::max();
     int           x_nearest = 0;
 
-    FractureEdge* e_nearest = nullptr;
+    FractureEdge*       e_nearest = nullptr;
+    FractureEdge::Index i_nearest = 0;
 
-    // Since this function is run for all holes left to right, no need to
-    // check for any edge beyond the provoking one because they will always be
-    // further to the right, and unconnected to the outline anyway.
-    for( FractureEdge::Index i = 0; i < provokingIndex; i++ )
-    {
-        FractureEdge& e = edges[i];
-        // Don't consider this edge if it can't be bridged to, or faces left.
-        if( !e.matches( y ) )
-            continue;
+    auto checkEdge =
+            [&]( FractureEdge::Index i )
+            {
+                FractureEdge& e = edges[i];
 
-        int x_intersect;
+                // Don't consider this edge if it can't be bridged to, or faces left.
+                if( !e.matches( y ) )
+                    return;
 
-        if( e.m_p1.y == e.m_p2.y ) // horizontal edge
-        {
-            x_intersect = std::max( e.m_p1.x, e.m_p2.x );
-        }
-        else
-        {
-            x_intersect =
-                    e.m_p1.x + rescale( e.m_p2.x - e.m_p1.x, y - e.m_p1.y, e.m_p2.y - e.m_p1.y );
-        }
+                int x_intersect;
 
-        int dist = ( x - x_intersect );
+                if( e.m_p1.y == e.m_p2.y ) // horizontal edge
+                {
+                    x_intersect = std::max( e.m_p1.x, e.m_p2.x );
+                }
+                else
+                {
+                    x_intersect = e.m_p1.x
+                                  + rescale( e.m_p2.x - e.m_p1.x, y - e.m_p1.y, e.m_p2.y - e.m_p1.y );
+                }
 
-        if( dist >= 0 && dist < min_dist )
-        {
-            min_dist = dist;
-            x_nearest = x_intersect;
-            e_nearest = &e;
-        }
+                int dist = ( x - x_intersect );
+
+                // Ties go to the lowest index, whatever order the edges are checked in
+                if( dist >= 0 && ( dist < min_dist || ( dist == min_dist && i < i_nearest ) ) )
+                {
+                    min_dist = dist;
+                    x_nearest = x_intersect;
+                    e_nearest = &e;
+                    i_nearest = i;
+                }
+            };
+
+    // Since this function is run for all holes left to right, no need to
+    // check for any edge beyond the provoking one because they will always be
+    // further to the right, and unconnected to the outline anyway.  The bands only ever
+    // hold these edges.
+    if( aBands )
+    {
+        for( FractureEdge::Index i : aBands->Candidates( y ) )
+            checkEdge( i );
+    }
+    else
+    {
+        for( FractureEdge::Index i = 0; i < provokingIndex; i++ )
+            checkEdge( i );
     }
 
     if( e_nearest )
@@ -1289,13 +1669,20 @@ static FractureEdge* processHole( FractureEdgeSet& edges, FractureEdge::Index pr
         for( ; last->m_next != edgeIndex; last = &edges[last->m_next] )
             ;
         last->m_next = hole2outline_index;
+
+        // The hole is now part of the outline, and a candidate for bridging the next ones
+        if( aBands )
+        {
+            for( FractureEdge::Index i = provokingIndex; i <= split_index; i++ )
+                aBands->Add( edges, i );
+        }
     }
 
     return e_nearest;
 }
 
 
-static void fractureSingleCacheFriendly( SHAPE_POLY_SET::POLYGON& paths )
+static void fractureSingleCacheFriendly( SHAPE_POLY_SET::POLYGON& paths, bool aIndexed )
 {
     FractureEdgeSet edges;
     bool            outline = true;
@@ -1402,10 +1789,37 @@ static void fractureSingleCacheFriendly( SHAPE_POLY_SET::POLYGON& paths )
         outline = false; // first path is always the outline
     }
 
+    // With more than a few holes, only look at the edges near each hole when bridging it.
+    // This finds the same edges as scanning them all, in close to linear time.
+    std::optional<FractureEdgeBands> bands;
+
+    if( aIndexed && paths_count > 8 )
+    {
+        int y_min = std::numeric_limits<int>::max();
+        int y_max = std::numeric_limits<int>::min();
+
+        for( const SHAPE_LINE_CHAIN& path : paths )
+        {
+            for( const VECTOR2I& point : path.CPoints() )
+            {
+                y_min = std::min( y_min, point.y );
+                y_max = std::max( y_max, point.y );
+            }
+        }
+
+        int band_count = std::clamp( static_cast<int>( total_point_count / 4 ), 1, 65536 );
+
+        bands.emplace( y_min, y_max, band_count );
+
+        for( FractureEdge::Index i = 0; i < sorted_paths[1].path_or_provoking_index; i++ )
+            bands->Add( edges, i );
+    }
+
     for( auto it = sorted_paths.begin() + 1; it != sorted_paths.end(); it++ )
     {
         auto edge = processHole( edges, it->path_or_provoking_index,
-                                 it->path_or_provoking_index + it->leftmost, it->y_or_bridge );
+                                 it->path_or_provoking_index + it->leftmost, it->y_or_bridge,
+                                 bands ? &*bands : nullptr );
 
         // If we can't handle the hole, the zone is broken (maybe)
         if( !edge )
@@ -1649,20 +2063,45 @@ static void fractureSingleSlow( SHAPE_POLY_SET::POLYGON& paths )
 }
 
 
-void SHAPE_POLY_SET::fractureSingle( POLYGON& paths )
+void SHAPE_POLY_SET::fractureSingle( POLYGON& paths, FRACTURE_ALGO aAlgo )
 {
-    if( ENABLECACHEFRIENDLYFRACTURE )
-        return fractureSingleCacheFriendly( paths );
-    fractureSingleSlow( paths );
+    switch( aAlgo )
+    {
+    case FRACTURE_ALGO::INDEXED: fractureSingleCacheFriendly( paths, true );  break;
+    case FRACTURE_ALGO::LINEAR:  fractureSingleCacheFriendly( paths, false ); break;
+    case FRACTURE_ALGO::SLOW:    fractureSingleSlow( paths );                 break;
+    }
 }
 
 
 void SHAPE_POLY_SET::Fracture()
+{
+    Fracture( ENABLECACHEFRIENDLYFRACTURE ? FRACTURE_ALGO::INDEXED : FRACTURE_ALGO::SLOW );
+}
+
+
+void SHAPE_POLY_SET::Fracture( FRACTURE_ALGO aAlgo )
 {
     Simplify();    // remove overlapping holes/degeneracy
 
     for( POLYGON& paths : m_polys )
-        fractureSingle( paths );
+        fractureSingle( paths, aAlgo );
+}
+
+
+void SHAPE_POLY_SET::Fracture( BS::thread_pool& aPool )
+{
+    FRACTURE_ALGO algo = ENABLECACHEFRIENDLYFRACTURE ? FRACTURE_ALGO::INDEXED
+                                                     : FRACTURE_ALGO::SLOW;
+
+    Simplify();    // remove overlapping holes/degeneracy
+
+    // Each polygon is fractured on its own, so they can all be done at once
+    parallelFor( aPool, m_polys.size(),
+                 [&]( size_t aIdx )
+                 {
+                     fractureSingle( m_polys[aIdx], algo );
+                 } );
 }
 
 
@@ -2316,34 +2755,30 @@ bool SHAPE_POLY_SET::CollideVertex( const VECTOR2I& aPoint,
                                     int aClearance ) const
 {
     // Shows whether there was a collision
-    bool collision = false;
-
-    // Difference vector between each vertex and aPoint.
-    VECTOR2D    delta;
-    ecoord      distance_squared;
-    ecoord      clearance_squared = SEG::Square( aClearance );
+    bool   collision = false;
+    ecoord clearance_squared = SEG::Square( aClearance );
 
-    for( CONST_ITERATOR iterator = CIterateWithHoles(); iterator; iterator++ )
+    for( int polygon = 0; polygon < (int) m_polys.size(); polygon++ )
     {
-        // Get the difference vector between current vertex and aPoint
-        delta = *iterator - aPoint;
+        for( int contour = 0; contour < (int) m_polys[polygon].size(); contour++ )
+        {
+            const std::vector<VECTOR2I>& points = m_polys[polygon][contour].CPoints();
 
-        // Compute distance
-        distance_squared = delta.SquaredEuclideanNorm();
+            // Also updates clearance_squared, to look for closer vertices in the next contours
+            int vertex = NearestPoint( points.data(), points.size(), aPoint, clearance_squared );
+
+            if( vertex < 0 )
+                continue;
 
-        // Check for collisions
-        if( distance_squared <= clearance_squared )
-        {
             if( !aClosestVertex )
                 return true;
 
             collision = true;
 
-            // Update clearance to look for closer vertices
-            clearance_squared = distance_squared;
-
             // Store the indices that identify the vertex
-            *aClosestVertex = iterator.GetIndex();
+            aClosestVertex->m_polygon = polygon;
+            aClosestVertex->m_contour = contour;
+            aClosestVertex->m_vertex = vertex;
         }
     }
 
@@ -2456,7 +2891,7 @@ bool SHAPE_POLY_SET::containsSingle( const VECTOR2I& aP, int aSubpolyIndex, int
                                      bool aUseBBoxCaches ) const
 {
     // Check that the point is inside the outline
-    if( m_polys[aSubpolyIndex][0].PointInside( aP, aAccuracy ) )
+    if( m_polys[aSubpolyIndex][0].PointInside( aP, aAccuracy, aUseBBoxCaches ) )
     {
         // Check that the point is not in any of the holes
         for( int holeIdx = 0; holeIdx < HoleCount( aSubpolyIndex ); holeIdx++ )
@@ -2938,7 +3373,8 @@ bool SHAPE_POLY_SET::IsTriangulationUpToDate() const
 }
 
 
-static SHAPE_POLY_SET partitionPolyIntoRegularCellGrid( const SHAPE_POLY_SET& aPoly, int aSize )
+static SHAPE_POLY_SET partitionPolyIntoRegularCellGrid( const SHAPE_POLY_SET& aPoly, int aSize,
+                                                        BS::thread_pool* aPool )
 {
     BOX2I bb = aPoly.BBox();
 
@@ -2992,10 +3428,25 @@ static SHAPE_POLY_SET partitionPolyIntoRegularCellGrid( const SHAPE_POLY_SET& aP
         }
     }
 
-    ps1.BooleanIntersection( maskSetOdd );
-    ps2.BooleanIntersection( maskSetEven );
-    ps1.Fracture();
-    ps2.Fracture();
+    // The odd and even cells don't touch each other, so both halves can be cut out at once
+    auto cut =
+            [&]( size_t aIdx )
+            {
+                SHAPE_POLY_SET& ps = aIdx ? ps2 : ps1;
+
+                ps.BooleanIntersection( aIdx ? maskSetEven : maskSetOdd );
+                ps.Fracture();
+            };
+
+    if( aPool )
+    {
+        parallelFor( *aPool, 2, cut );
+    }
+    else
+    {
+        cut( 0 );
+        cut( 1 );
+    }
 
     for( int i = 0; i < ps2.OutlineCount(); i++ )
         ps1.AddOutline( ps2.COutline( i ) );
@@ -3007,8 +3458,76 @@ static SHAPE_POLY_SET partitionPolyIntoRegularCellGrid( const SHAPE_POLY_SET& aP
 }
 
 
+/**
+ * Hash of a partition's vertices, used to find partitions whose triangulation can be reused.
+ */
+template <typename CONTAINER>
+static uint64_t partitionHash( const CONTAINER& aPoints )
+{
+    MMH3_HASH hash( 0x3C2A5E91 ); // Arbitrary seed
+
+    hash.add( static_cast<int>( aPoints.size() ) );
+
+    for( const VECTOR2I& pt : aPoints )
+    {
+        hash.add( pt.x );
+        hash.add( pt.y );
+    }
+
+    return hash.digest().Value64[0];
+}
+
+
+static uint64_t polygonHash( const SHAPE_POLY_SET::POLYGON& aPolygon )
+{
+    MMH3_HASH hash( 0x3C2A5E91 ); // Arbitrary seed
+
+    hash.add( static_cast<int>( aPolygon.size() ) );
+
+    for( const SHAPE_LINE_CHAIN& chain : aPolygon )
+    {
+        hash.add( chain.PointCount() );
+
+        for( const VECTOR2I& pt : chain.CPoints() )
+        {
+            hash.add( pt.x );
+            hash.add( pt.y );
+        }
+    }
+
+    return hash.digest().Value64[0];
+}
+
+
+static bool samePoints( const SHAPE_POLY_SET::POLYGON& aA, const SHAPE_POLY_SET::POLYGON& aB )
+{
+    if( aA.size() != aB.size() )
+        return false;
+
+    for( size_t ii = 0; ii < aA.size(); ii++ )
+    {
+        if( aA[ii].CPoints() != aB[ii].CPoints() )
+            return false;
+    }
+
+    return true;
+}
+
+
+size_t SHAPE_POLY_SET::CacheTriangulation( BS::thread_pool& aPool,
+                                           const SHAPE_POLY_SET* aPrevious )
+{
+    size_t reused = 0;
+
+    cacheTriangulation( true, false, nullptr, aPrevious, &aPool, &reused );
+    return reused;
+}
+
+
 void SHAPE_POLY_SET::cacheTriangulation( bool aPartition, bool aSimplify,
-                                         std::vector<std::unique_ptr<TRIANGULATED_POLYGON>>* aHintData )
+                                         std::vector<std::unique_ptr<TRIANGULATED_POLYGON>>* aHintData,
+                                         const SHAPE_POLY_SET* aPrevious, BS::thread_pool* aPool,
+                                         size_t* aReusedCount )
 {
     std::unique_lock<std::mutex> lock( m_triangulationMutex );
 
@@ -3073,44 +3592,237 @@ void SHAPE_POLY_SET::cacheTriangulation( bool aPartition, bool aSimplify,
                 return triangulationValid;
             };
 
-    m_triangulatedPolys.clear();
-
     if( aPartition )
     {
-        for( int ii = 0; ii < OutlineCount(); ++ii )
+        // Partitions whose vertices are identical to one triangulated earlier (by this set
+        // before it was edited, by aPrevious or in aHintData) keep their triangles, so only
+        // the parts of a large polygon which actually changed need to be triangulated again.
+        std::vector<std::unique_ptr<TRIANGULATED_POLYGON>> stale;
+        std::unordered_multimap<uint64_t, const TRIANGULATED_POLYGON*> reusable;
+
+        stale.swap( m_triangulatedPolys );
+
+        auto addReusable =
+                [&]( const std::vector<std::unique_ptr<TRIANGULATED_POLYGON>>& aPolys )
+                {
+                    for( const std::unique_ptr<TRIANGULATED_POLYGON>& poly : aPolys )
+                    {
+                        if( poly->GetTriangleCount() > 0 )
+                            reusable.emplace( partitionHash( poly->Vertices() ), poly.get() );
+                    }
+                };
+
+        addReusable( stale );
+
+        if( aHintData )
+            addReusable( *aHintData );
+
+        // Whole polygons which are unchanged in aPrevious don't even need partitioning again
+        std::unordered_multimap<uint64_t, int>                 previousOutlines;
+        std::vector<std::vector<const TRIANGULATED_POLYGON*>> previousTriangulations;
+
+        if( aPrevious && aPrevious != this && aPrevious->IsTriangulationUpToDate() )
         {
-            // This partitions into regularly-sized grids (1cm in Pcbnew)
-            SHAPE_POLY_SET flattened( Outline( ii ) );
+            addReusable( aPrevious->m_triangulatedPolys );
+
+            previousTriangulations.resize( aPrevious->OutlineCount() );
+
+            for( const std::unique_ptr<TRIANGULATED_POLYGON>& poly : aPrevious->m_triangulatedPolys )
+            {
+                int source = poly->GetSourceOutlineIndex();
+
+                if( source >= 0 && source < (int) previousTriangulations.size() )
+                    previousTriangulations[source].push_back( poly.get() );
+            }
+
+            for( int ii = 0; ii < aPrevious->OutlineCount(); ++ii )
+            {
+                if( !previousTriangulations[ii].empty() )
+                    previousOutlines.emplace( polygonHash( aPrevious->m_polys[ii] ), ii );
+            }
+        }
+
+        auto findReusable =
+                [&]( const SHAPE_LINE_CHAIN& aChain ) -> const TRIANGULATED_POLYGON*
+                {
+                    const std::vector<VECTOR2I>& pts = aChain.CPoints();
+                    auto range = reusable.equal_range( partitionHash( pts ) );
+
+                    for( auto it = range.first; it != range.second; ++it )
+                    {
+                        const std::deque<VECTOR2I>& vertices = it->second->Vertices();
+
+                        if( std::equal( vertices.begin(), vertices.end(), pts.begin(), pts.end() ) )
+                            return it->second;
+                    }
+
+                    return nullptr;
+                };
+
+        auto forEach =
+                [&]( size_t aCount, const std::function<void( size_t )>& aFunc )
+                {
+                    if( aPool && aPool->get_thread_count() > 1 && aCount > 1 )
+                    {
+                        parallelFor( *aPool, aCount, aFunc );
+                    }
+                    else
+                    {
+                        for( size_t ii = 0; ii < aCount; ii++ )
+                            aFunc( ii );
+                    }
+                };
+
+        std::vector<SHAPE_POLY_SET> partitions( OutlineCount() );
+        std::vector<const std::vector<const TRIANGULATED_POLYGON*>*> reusedOutlines( OutlineCount() );
+
+        forEach( partitions.size(),
+                 [&]( size_t aIdx )
+                 {
+                     int  ii = static_cast<int>( aIdx );
+                     auto range = previousOutlines.equal_range( polygonHash( m_polys[ii] ) );
 
-            for( int jj = 0; jj < HoleCount( ii ); ++jj )
-                flattened.AddHole( Hole( ii, jj ) );
+                     for( auto it = range.first; it != range.second; ++it )
+                     {
+                         if( samePoints( aPrevious->m_polys[it->second], m_polys[ii] ) )
+                         {
+                             reusedOutlines[ii] = &previousTriangulations[it->second];
+                             return;
+                         }
+                     }
 
-            flattened.ClearArcs();
+                     // This partitions into regularly-sized grids (1cm in Pcbnew)
+                     SHAPE_POLY_SET flattened( COutline( ii ) );
 
-            if( flattened.HasHoles() || flattened.IsSelfIntersecting() )
-                flattened.Fracture();
-            else if( aSimplify )
-                flattened.Simplify();
+                     for( int jj = 0; jj < HoleCount( ii ); ++jj )
+                         flattened.AddHole( CHole( ii, jj ) );
 
-            SHAPE_POLY_SET partitions = partitionPolyIntoRegularCellGrid( flattened, 1e7 );
+                     flattened.ClearArcs();
 
-            // This pushes the triangulation for all polys in partitions
-            // to be referenced to the ii-th polygon
-            if( !triangulate( partitions, ii , m_triangulatedPolys, aHintData ) )
+                     if( flattened.HasHoles() || flattened.IsSelfIntersecting() )
+                         flattened.Fracture();
+                     else if( aSimplify )
+                         flattened.Simplify();
+
+                     partitions[ii] = partitionPolyIntoRegularCellGrid( flattened, 1e7, aPool );
+                 } );
+
+        // Each cell of the grid is triangulated on its own
+        struct CELL
+        {
+            int                                   outline;
+            const SHAPE_LINE_CHAIN*               chain;
+            std::unique_ptr<TRIANGULATED_POLYGON> result;
+            bool                                  ok = false;
+            bool                                  reused = false;
+        };
+
+        std::vector<CELL> cells;
+
+        for( int ii = 0; ii < (int) partitions.size(); ++ii )
+        {
+            for( int jj = 0; jj < partitions[ii].OutlineCount(); ++jj )
+                cells.push_back( { ii, &partitions[ii].COutline( jj ), nullptr } );
+        }
+
+        forEach( cells.size(),
+                 [&]( size_t aIdx )
+                 {
+                     CELL& cell = cells[aIdx];
+
+                     cell.result = std::make_unique<TRIANGULATED_POLYGON>( cell.outline );
+
+                     if( const TRIANGULATED_POLYGON* match = findReusable( *cell.chain ) )
+                     {
+                         *cell.result = *match;
+                         cell.result->SetSourceOutlineIndex( cell.outline );
+                         cell.ok = true;
+                         cell.reused = true;
+                     }
+                     else
+                     {
+                         POLYGON_TRIANGULATION tess( *cell.result );
+                         cell.ok = tess.TesselatePolygon( *cell.chain, nullptr );
+                     }
+                 } );
+
+        // Same bookkeeping as triangulate(): a partition without triangles is dropped once
+        // another one follows it
+        auto append =
+                [&]( std::unique_ptr<TRIANGULATED_POLYGON> aPoly )
+                {
+                    if( !m_triangulatedPolys.empty()
+                            && m_triangulatedPolys.back()->GetTriangleCount() == 0 )
+                    {
+                        m_triangulatedPolys.pop_back();
+                    }
+
+                    m_triangulatedPolys.push_back( std::move( aPoly ) );
+                };
+
+        size_t next = 0;
+        bool   anyTriangulated = false;
+
+        for( int ii = 0; ii < (int) partitions.size(); ++ii )
+        {
+            size_t first = next;
+            bool   ok = true;
+
+            while( next < cells.size() && cells[next].outline == ii )
+                ok &= cells[next++].ok;
+
+            bool triangulated = false;
+
+            if( reusedOutlines[ii] )
             {
-                wxLogTrace( TRIANGULATE_TRACE, "Failed to triangulate partitioned polygon %d", ii );
+                for( const TRIANGULATED_POLYGON* poly : *reusedOutlines[ii] )
+                {
+                    append( std::make_unique<TRIANGULATED_POLYGON>( *poly ) );
+                    m_triangulatedPolys.back()->SetSourceOutlineIndex( ii );
+                }
+
+                if( aReusedCount )
+                    *aReusedCount += reusedOutlines[ii]->size();
+
+                triangulated = true;
+            }
+            else if( ok && next > first )
+            {
+                for( size_t jj = first; jj < next; ++jj )
+                {
+                    if( aReusedCount && cells[jj].reused )
+                        ( *aReusedCount )++;
+
+                    append( std::move( cells[jj].result ) );
+                }
+
+                triangulated = true;
             }
             else
             {
-                m_hash = checksum();
-                m_hashValid = true;
-                // Set valid flag only after everything has been updated
-                m_triangulationValid = true;
+                // Some cell needs the simplify-and-retry fallback, which works on the remaining
+                // cells of the polygon as a whole.
+                triangulated = triangulate( partitions[ii], ii, m_triangulatedPolys, nullptr );
             }
+
+            if( !triangulated )
+                wxLogTrace( TRIANGULATE_TRACE, "Failed to triangulate partitioned polygon %d", ii );
+            else
+                anyTriangulated = true;
+        }
+
+        if( anyTriangulated )
+        {
+            m_hash = checksum();
+            m_hashValid = true;
+            // Set valid flag only after everything has been updated
+            m_triangulationValid = true;
         }
     }
     else
     {
+        m_triangulatedPolys.clear();
+
         SHAPE_POLY_SET tmpSet( *this );
 
         tmpSet.ClearArcs();
@@ -0,0 +1,295 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <math/vector2_batch.h>
+
+#include <algorithm>
+#include <limits>
+
+#include <trigo.h>
+
+// SSE2 is part of the x86-64 baseline, and NEON of the AArch64 one, so no runtime dispatch is
+// needed.  Wider instruction sets (AVX2) would need one and are not used.
+#if defined( __SSE2__ ) || defined( _M_X64 ) || defined( _M_AMD64 )
+#define BATCH_USE_SSE2
+#include <emmintrin.h>
+#elif defined( __ARM_NEON ) && defined( __aarch64__ )
+#define BATCH_USE_NEON
+#include <arm_neon.h>
+#endif
+
+
+// The kernels load points as pairs of packed 32 bit integers
+static_assert( sizeof( VECTOR2I ) == 2 * sizeof( int32_t ) );
+
+
+#ifdef BATCH_USE_SSE2
+// SSE2 has no 32 bit integer min/max (they came with SSE4.1)
+static inline __m128i min_epi32( __m128i aA, __m128i aB )
+{
+    __m128i greater = _mm_cmpgt_epi32( aA, aB );
+    return _mm_or_si128( _mm_and_si128( greater, aB ), _mm_andnot_si128( greater, aA ) );
+}
+
+
+static inline __m128i max_epi32( __m128i aA, __m128i aB )
+{
+    __m128i greater = _mm_cmpgt_epi32( aA, aB );
+    return _mm_or_si128( _mm_and_si128( greater, aA ), _mm_andnot_si128( greater, aB ) );
+}
+#endif
+
+
+BOX2I BoundingBox( const VECTOR2I* aPoints, size_t aCount )
+{
+    BOX2I box;
+
+    if( aCount == 0 )
+        return box;
+
+    VECTOR2I vmin = aPoints[0];
+    VECTOR2I vmax = aPoints[0];
+    size_t   ii = 0;
+
+#if defined( BATCH_USE_SSE2 )
+    if( aCount >= 4 )
+    {
+        __m128i lo = _mm_set_epi32( vmin.y, vmin.x, vmin.y, vmin.x );
+        __m128i hi = lo;
+
+        for( ; ii + 2 <= aCount; ii += 2 )
+        {
+            __m128i pts = _mm_loadu_si128( reinterpret_cast<const __m128i*>( aPoints + ii ) );
+            lo = min_epi32( lo, pts );
+            hi = max_epi32( hi, pts );
+        }
+
+        lo = min_epi32( lo, _mm_shuffle_epi32( lo, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+        hi = max_epi32( hi, _mm_shuffle_epi32( hi, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+
+        vmin = VECTOR2I( _mm_cvtsi128_si32( lo ), _mm_cvtsi128_si32( _mm_srli_si128( lo, 4 ) ) );
+        vmax = VECTOR2I( _mm_cvtsi128_si32( hi ), _mm_cvtsi128_si32( _mm_srli_si128( hi, 4 ) ) );
+    }
+#elif defined( BATCH_USE_NEON )
+    if( aCount >= 4 )
+    {
+        int32x4_t lo = vcombine_s32( vld1_s32( &vmin.x ), vld1_s32( &vmin.x ) );
+        int32x4_t hi = lo;
+
+        for( ; ii + 2 <= aCount; ii += 2 )
+        {
+            int32x4_t pts = vld1q_s32( &aPoints[ii].x );
+            lo = vminq_s32( lo, pts );
+            hi = vmaxq_s32( hi, pts );
+        }
+
+        int32x2_t lo2 = vmin_s32( vget_low_s32( lo ), vget_high_s32( lo ) );
+        int32x2_t hi2 = vmax_s32( vget_low_s32( hi ), vget_high_s32( hi ) );
+
+        vmin = VECTOR2I( vget_lane_s32( lo2, 0 ), vget_lane_s32( lo2, 1 ) );
+        vmax = VECTOR2I( vget_lane_s32( hi2, 0 ), vget_lane_s32( hi2, 1 ) );
+    }
+#endif
+
+    for( ; ii < aCount; ii++ )
+    {
+        vmin.x = std::min( vmin.x, aPoints[ii].x );
+        vmin.y = std::min( vmin.y, aPoints[ii].y );
+        vmax.x = std::max( vmax.x, aPoints[ii].x );
+        vmax.y = std::max( vmax.y, aPoints[ii].y );
+    }
+
+    // Same as BOX2::Compute()
+    box.SetOrigin( vmin );
+    box.SetSize( vmax - vmin );
+    return box;
+}
+
+
+void MovePoints( VECTOR2I* aPoints, size_t aCount, const VECTOR2I& aOffset )
+{
+    size_t ii = 0;
+
+#if defined( BATCH_USE_SSE2 )
+    __m128i offset = _mm_set_epi32( aOffset.y, aOffset.x, aOffset.y, aOffset.x );
+
+    for( ; ii + 2 <= aCount; ii += 2 )
+    {
+        __m128i* pts = reinterpret_cast<__m128i*>( aPoints + ii );
+        _mm_storeu_si128( pts, _mm_add_epi32( _mm_loadu_si128( pts ), offset ) );
+    }
+#elif defined( BATCH_USE_NEON )
+    int32x4_t offset = vcombine_s32( vld1_s32( &aOffset.x ), vld1_s32( &aOffset.x ) );
+
+    for( ; ii + 2 <= aCount; ii += 2 )
+        vst1q_s32( &aPoints[ii].x, vaddq_s32( vld1q_s32( &aPoints[ii].x ), offset ) );
+#endif
+
+    for( ; ii < aCount; ii++ )
+        aPoints[ii] += aOffset;
+}
+
+
+void MirrorPoints( VECTOR2I* aPoints, size_t aCount, const VECTOR2I& aRef,
+                   FLIP_DIRECTION aFlipDirection )
+{
+    // Plain loops, with the direction test out of them: compilers vectorize these on their own
+    if( aFlipDirection == FLIP_DIRECTION::LEFT_RIGHT )
+    {
+        for( size_t ii = 0; ii < aCount; ii++ )
+            aPoints[ii].x = -aPoints[ii].x + 2 * aRef.x;
+    }
+    else
+    {
+        for( size_t ii = 0; ii < aCount; ii++ )
+            aPoints[ii].y = -aPoints[ii].y + 2 * aRef.y;
+    }
+}
+
+
+void RotatePoints( VECTOR2I* aPoints, size_t aCount, const VECTOR2I& aCentre,
+                   const EDA_ANGLE& aAngle )
+{
+    EDA_ANGLE angle = aAngle;
+    angle.Normalize();
+
+    // Same special cases as RotatePoint()
+    if( angle == ANGLE_0 )
+        return;
+
+    if( angle == ANGLE_90 )
+    {
+        for( size_t ii = 0; ii < aCount; ii++ )
+        {
+            VECTOR2I delta = aPoints[ii] - aCentre;
+            aPoints[ii] = VECTOR2I( delta.y, -delta.x ) + aCentre;
+        }
+
+        return;
+    }
+    else if( angle == ANGLE_180 )
+    {
+        for( size_t ii = 0; ii < aCount; ii++ )
+        {
+            VECTOR2I delta = aPoints[ii] - aCentre;
+            aPoints[ii] = VECTOR2I( -delta.x, -delta.y ) + aCentre;
+        }
+
+        return;
+    }
+    else if( angle == ANGLE_270 )
+    {
+        for( size_t ii = 0; ii < aCount; ii++ )
+        {
+            VECTOR2I delta = aPoints[ii] - aCentre;
+            aPoints[ii] = VECTOR2I( -delta.y, delta.x ) + aCentre;
+        }
+
+        return;
+    }
+
+    const double sinus = angle.Sin();
+    const double cosinus = angle.Cos();
+    size_t       ii = 0;
+
+#if defined( BATCH_USE_SSE2 )
+    const __m128i centre = _mm_set_epi32( aCentre.y, aCentre.x, aCentre.y, aCentre.x );
+    const __m128d vsin = _mm_set1_pd( sinus );
+    const __m128d vcos = _mm_set1_pd( cosinus );
+    const __m128d half = _mm_set1_pd( 0.5 );
+    const __m128d signBit = _mm_set1_pd( -0.0 );
+    const __m128d maxInt = _mm_set1_pd( std::numeric_limits<int>::max() );
+    const __m128d minInt = _mm_set1_pd( std::numeric_limits<int>::lowest() );
+
+    // Round as KiROUND() does: half away from zero
+    auto roundAway =
+            [&]( __m128d aValue )
+            {
+                return _mm_add_pd( aValue, _mm_or_pd( _mm_and_pd( aValue, signBit ), half ) );
+            };
+
+    for( ; ii + 2 <= aCount; ii += 2 )
+    {
+        __m128i* pts = reinterpret_cast<__m128i*>( aPoints + ii );
+        __m128i  delta = _mm_sub_epi32( _mm_loadu_si128( pts ), centre );
+
+        // x0 x1 and y0 y1 in the low lanes
+        __m128i xs = _mm_shuffle_epi32( delta, _MM_SHUFFLE( 3, 1, 2, 0 ) );
+        __m128i ys = _mm_shuffle_epi32( delta, _MM_SHUFFLE( 2, 0, 3, 1 ) );
+        __m128d x = _mm_cvtepi32_pd( xs );
+        __m128d y = _mm_cvtepi32_pd( ys );
+
+        __m128d newX = roundAway( _mm_add_pd( _mm_mul_pd( y, vsin ), _mm_mul_pd( x, vcos ) ) );
+        __m128d newY = roundAway( _mm_sub_pd( _mm_mul_pd( y, vcos ), _mm_mul_pd( x, vsin ) ) );
+
+        __m128d outOfRange = _mm_or_pd( _mm_or_pd( _mm_cmpgt_pd( newX, maxInt ),
+                                                   _mm_cmplt_pd( newX, minInt ) ),
+                                        _mm_or_pd( _mm_cmpgt_pd( newY, maxInt ),
+                                                   _mm_cmplt_pd( newY, minInt ) ) );
+
+        // Let RotatePoint() report and clamp the overflows
+        if( _mm_movemask_pd( outOfRange ) )
+        {
+            RotatePoint( aPoints[ii], aCentre, aAngle );
+            RotatePoint( aPoints[ii + 1], aCentre, aAngle );
+            continue;
+        }
+
+        __m128i result = _mm_unpacklo_epi32( _mm_cvttpd_epi32( newX ), _mm_cvttpd_epi32( newY ) );
+        _mm_storeu_si128( pts, _mm_add_epi32( result, centre ) );
+    }
+#endif
+
+    for( ; ii < aCount; ii++ )
+    {
+        VECTOR2I& pt = aPoints[ii];
+        double    dx = pt.x - aCentre.x;
+        double    dy = pt.y - aCentre.y;
+
+        pt.x = KiROUND( ( dy * sinus ) + ( dx * cosinus ) ) + aCentre.x;
+        pt.y = KiROUND( ( dy * cosinus ) - ( dx * sinus ) ) + aCentre.y;
+    }
+}
+
+
+int NearestPoint( const VECTOR2I* aPoints, size_t aCount, const VECTOR2I& aRef, int64_t& aDistSq )
+{
+    // Squared distances need 64 bit products and compares, which SSE2 lacks: this one stays
+    // scalar, but branch free in the common case so that it pipelines well.
+    int best = -1;
+
+    for( size_t ii = 0; ii < aCount; ii++ )
+    {
+        int64_t dx = int64_t( aPoints[ii].x ) - aRef.x;
+        int64_t dy = int64_t( aPoints[ii].y ) - aRef.y;
+        int64_t distSq = dx * dx + dy * dy;
+
+        if( distSq <= aDistSq )
+        {
+            aDistSq = distSq;
+            best = static_cast<int>( ii );
+        }
+    }
+
+    return best;
+}
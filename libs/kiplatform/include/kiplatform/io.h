@@ -20,6 +20,7 @@
 #ifndef KIPLATFORM_IO_H_
 #define KIPLATFORM_IO_H_
 
+#include <stddef.h>
 #include <stdio.h>
 
 class wxString;
@@ -57,6 +58,25 @@ namespace IO
      * This is a no-op on non-Windows platforms.
      */
     void LongPathAdjustment( wxFileName& aFilename );
+
+    /**
+     * Map a whole file in memory, read only.
+     *
+     * The mapping stays valid if the file is deleted or replaced, but not if it is truncated
+     * in place.
+     *
+     * @param aPath is the file to map.
+     * @param aSize receives the size of the file.
+     * @param aHandle receives the platform data to pass to UnmapFile().
+     * @return the first byte of the file, or nullptr if it cannot be mapped (missing, empty or
+     *         not a regular file).
+     */
+    const char* MapFile( const wxString& aPath, size_t& aSize, void*& aHandle );
+
+    /**
+     * Release a mapping made by MapFile().
+     */
+    void UnmapFile( const char* aData, size_t aSize, void* aHandle );
 } // namespace IO
 } // namespace KIPLATFORM
 
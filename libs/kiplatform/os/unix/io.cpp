@@ -25,6 +25,7 @@
 #include <wx/filename.h>
 
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
@@ -78,4 +79,43 @@ bool KIPLATFORM::IO::IsFileHidden( const wxString& aFileName )
 void KIPLATFORM::IO::LongPathAdjustment( wxFileName& aFilename )
 {
     // no-op
-}
\ No newline at end of file
+}
+
+
+const char* KIPLATFORM::IO::MapFile( const wxString& aPath, size_t& aSize, void*& aHandle )
+{
+    aHandle = nullptr;
+
+    int fd = open( aPath.fn_str(), O_RDONLY );
+
+    if( fd < 0 )
+        return nullptr;
+
+    struct stat fileStat;
+
+    if( fstat( fd, &fileStat ) != 0 || !S_ISREG( fileStat.st_mode ) || fileStat.st_size == 0 )
+    {
+        close( fd );
+        return nullptr;
+    }
+
+    void* data = mmap( nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+
+    // The mapping keeps its own reference to the file
+    close( fd );
+
+    if( data == MAP_FAILED )
+        return nullptr;
+
+    posix_madvise( data, fileStat.st_size, POSIX_MADV_SEQUENTIAL );
+
+    aSize = fileStat.st_size;
+    return static_cast<const char*>( data );
+}
+
+
+void KIPLATFORM::IO::UnmapFile( const char* aData, size_t aSize, void* aHandle )
+{
+    if( aData )
+        munmap( const_cast<char*>( aData ), aSize );
+}
@@ -155,4 +155,54 @@ void KIPLATFORM::IO::LongPathAdjustment( wxFileName& aFilename )
         aFilename.RemoveDir( 0 );
         aFilename.RemoveDir( 0 );
     }
-}
\ No newline at end of file
+}
+
+
+const char* KIPLATFORM::IO::MapFile( const wxString& aPath, size_t& aSize, void*& aHandle )
+{
+    aHandle = nullptr;
+
+    HANDLE hFile = CreateFileW( aPath.wc_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+                                NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL );
+
+    if( hFile == INVALID_HANDLE_VALUE )
+        return nullptr;
+
+    LARGE_INTEGER fileSize;
+
+    if( !GetFileSizeEx( hFile, &fileSize ) || fileSize.QuadPart == 0 )
+    {
+        CloseHandle( hFile );
+        return nullptr;
+    }
+
+    HANDLE hMapping = CreateFileMappingW( hFile, NULL, PAGE_READONLY, 0, 0, NULL );
+
+    // The mapping keeps its own reference to the file
+    CloseHandle( hFile );
+
+    if( !hMapping )
+        return nullptr;
+
+    void* data = MapViewOfFile( hMapping, FILE_MAP_READ, 0, 0, 0 );
+
+    if( !data )
+    {
+        CloseHandle( hMapping );
+        return nullptr;
+    }
+
+    aSize = static_cast<size_t>( fileSize.QuadPart );
+    aHandle = hMapping;
+    return static_cast<const char*>( data );
+}
+
+
+void KIPLATFORM::IO::UnmapFile( const char* aData, size_t aSize, void* aHandle )
+{
+    if( aData )
+        UnmapViewOfFile( aData );
+
+    if( aHandle )
+        CloseHandle( static_cast<HANDLE>( aHandle ) );
+}
@@ -143,6 +143,8 @@ BOARD::BOARD() :
 
 BOARD::~BOARD()
 {
+    InvokeListeners( &BOARD_LISTENER::OnBoardDestroyed, *this );
+
     // Untangle group parents before doing any deleting
     for( PCB_GROUP* group : m_groups )
     {
@@ -271,6 +271,12 @@ public:
                                          std::vector<BOARD_ITEM*>& aChangedItems )
     {
     }
+
+    /**
+     * Called from the board destructor.  The listener must forget the board, but must not
+     * remove itself from its listeners.
+     */
+    virtual void OnBoardDestroyed( BOARD& aBoard ) { }
 };
 
 /**
@@ -29,6 +29,7 @@
 #include <lset.h>
 #include <pcb_group.h>
 #include <pcb_track.h>
+#include <zone.h>
 #include <tool/tool_manager.h>
 #include <tools/pcb_selection_tool.h>
 #include <tools/zone_filler_tool.h>
@@ -460,6 +461,8 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
             // if no undo entry is needed, the copy would create a memory leak
             if( aCommitFlags & SKIP_UNDO )
                 delete ent.m_copy;
+            else if( boardItemCopy && boardItemCopy->Type() == PCB_ZONE_T )
+                static_cast<ZONE*>( boardItemCopy )->FreezeFills();
 
             break;
         }
@@ -532,6 +535,9 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
                 ITEM_PICKER itemWrapper( nullptr, boardItem, convert( ent.m_type & CHT_TYPE ) );
                 itemWrapper.SetLink( boardItemCopy );
                 undoList.PushItem( itemWrapper );
+
+                if( boardItemCopy && boardItemCopy->Type() == PCB_ZONE_T )
+                    static_cast<ZONE*>( boardItemCopy )->FreezeFills();
             }
             else
             {
@@ -26,6 +26,7 @@
 
 #include <string>
 
+#include <advanced_config.h>
 #include <confirm.h>
 #include <kidialog.h>
 #include <core/arraydim.h>
@@ -61,6 +62,7 @@
 #include <pcb_io/pcb_io_mgr.h>
 #include <pcb_io/cadstar/pcb_io_cadstar_archive.h>
 #include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr.h>
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr_fill_cache.h>
 #include <dialogs/dialog_export_2581.h>
 #include <dialogs/dialog_map_layers.h>
 #include <dialogs/dialog_export_odbpp.h>
@@ -1080,6 +1082,10 @@ bool PCB_EDIT_FRAME::SavePcbFile( const wxString& aFileName, bool addToHistory,
         return false;
     }
 
+    // Keep the zone fills in binary form, for a faster reopening
+    if( ADVANCED_CFG::GetCfg().m_BoardFillCache )
+        BOARD_FILL_CACHE::WriteForBoardFile( pcbFileName.GetFullPath(), *GetBoard() );
+
     if( !Kiface().IsSingle() )
     {
         WX_STRING_REPORTER backupReporter;
@@ -37,8 +37,11 @@
 #include <scoped_set_reset.h>
 #include <core/mirror.h>
 
+#include <hash.h>
 #include <board_design_settings.h>
+#include <connectivity/connectivity_data.h>
 #include <drc/drc_engine.h>
+#include <pad.h>
 #include <pcb_track.h>
 #include <pcb_shape.h>
 #include <pcb_group.h>
@@ -301,6 +304,7 @@ public:
 
     void Move( const VECTOR2I& aMoveVector ) override
     {
+        m_upToDate = false;
         m_origin += aMoveVector;
         m_end += aMoveVector;
 
@@ -318,6 +322,8 @@ public:
 
     void Rotate( const VECTOR2I& aRotCentre, const EDA_ANGLE& aAngle ) override
     {
+        m_upToDate = false;
+
         if( !this->HasFlag( IN_EDIT ) )
         {
             PCB_GENERATOR::Rotate( aRotCentre, aAngle );
@@ -333,6 +339,8 @@ public:
 
     void Flip( const VECTOR2I& aCentre, FLIP_DIRECTION aFlipDirection ) override
     {
+        m_upToDate = false;
+
         if( !this->HasFlag( IN_EDIT ) )
         {
             PCB_GENERATOR::Flip( aCentre, aFlipDirection );
@@ -343,6 +351,8 @@ public:
 
     void Mirror( const VECTOR2I& aCentre, FLIP_DIRECTION aFlipDirection ) override
     {
+        m_upToDate = false;
+
         if( !this->HasFlag( IN_EDIT ) )
         {
             PCB_GENERATOR::Mirror( aCentre, aFlipDirection );
@@ -515,6 +525,18 @@ protected:
 
     SHAPE_LINE_CHAIN getOutline() const;
 
+    /**
+     * Hash everything the generated meanders depend on, except for the target length and
+     * skew: the pattern geometry, the meander shape settings and the copper of the tuned
+     * net(s).
+     *
+     * @return the hash, or 0 if the pattern has no tuned tracks yet.
+     */
+    size_t updateHash( BOARD* aBoard ) const;
+
+    ///< Return true if the result of the last update satisfies the current target.
+    bool tuningResultInTarget() const;
+
     void baseMirror( const VECTOR2I& aCentre, FLIP_DIRECTION aFlipDirection )
     {
         PCB_GENERATOR::baseMirror( aCentre, aFlipDirection );
@@ -552,6 +574,10 @@ protected:
     wxString              m_tuningInfo;
 
     PNS::MEANDER_PLACER_BASE::TUNING_STATUS m_tuningStatus;
+    long long int         m_tuningResult;       ///< Length (or skew) after the last update
+
+    size_t                m_lastUpdateHash;     ///< updateHash() when last pushed to the board
+    bool                  m_upToDate;           ///< Update() may be skipped; see EditStart()
 
     bool                  m_updateSideFromEnd;
 };
@@ -660,6 +686,9 @@ PCB_TUNING_PATTERN::PCB_TUNING_PATTERN( BOARD_ITEM* aParent, PCB_LAYER_ID aLayer
         m_diffPairGap( 0 ),
         m_tuningMode( aMode ),
         m_tuningStatus( PNS::MEANDER_PLACER_BASE::TUNING_STATUS::TUNED ),
+        m_tuningResult( 0 ),
+        m_lastUpdateHash( 0 ),
+        m_upToDate( false ),
         m_updateSideFromEnd(false)
 {
     m_generatorType = GENERATOR_TYPE;
@@ -776,7 +805,7 @@ void PCB_TUNING_PATTERN::EditStart( GENERATOR_TOOL* aTool, BOARD* aBoard, BOARD_
     int          layer = router->GetInterface()->GetPNSLayerFromBoardLayer( GetLayer() );
 
     aTool->ClearRouterChanges();
-    router->SyncWorld();
+    aTool->SyncRouterWorld();
 
     PNS::RULE_RESOLVER* resolver = router->GetRuleResolver();
     PNS::CONSTRAINT     constraint;
@@ -868,6 +897,112 @@ void PCB_TUNING_PATTERN::EditStart( GENERATOR_TOOL* aTool, BOARD* aBoard, BOARD_
             }
         }
     }
+
+    // If nothing but the target changed since the meanders were last generated and they
+    // already meet the new target, there is no need to regenerate them.
+    m_upToDate = m_lastUpdateHash != 0
+                 && m_tuningStatus == PNS::MEANDER_PLACER_BASE::TUNED
+                 && tuningResultInTarget()
+                 && m_lastUpdateHash == updateHash( aBoard );
+}
+
+
+size_t PCB_TUNING_PATTERN::updateHash( BOARD* aBoard ) const
+{
+    NETINFO_ITEM* net = nullptr;
+
+    for( BOARD_ITEM* item : GetItems() )
+    {
+        if( item->Type() == PCB_TRACE_T || item->Type() == PCB_ARC_T )
+        {
+            net = static_cast<PCB_TRACK*>( item )->GetNet();
+            break;
+        }
+    }
+
+    if( !net )
+        return 0;
+
+    size_t hash = hash_val( static_cast<int>( m_tuningMode ), static_cast<int>( GetLayer() ),
+                            m_origin.x, m_origin.y, m_end.x, m_end.y );
+
+    hash_combine( hash, m_settings.m_minAmplitude, m_settings.m_maxAmplitude,
+                  m_settings.m_spacing, m_settings.m_step, m_settings.m_lenPadToDie,
+                  static_cast<int>( m_settings.m_cornerStyle ),
+                  m_settings.m_cornerRadiusPercentage, m_settings.m_singleSided,
+                  static_cast<int>( m_settings.m_initialSide ), m_settings.m_lengthTolerance );
+
+    for( const std::optional<SHAPE_LINE_CHAIN>* baseLine : { &m_baseLine, &m_baseLineCoupled } )
+    {
+        if( !baseLine->has_value() )
+            continue;
+
+        for( const VECTOR2I& pt : ( *baseLine )->CPoints() )
+            hash_combine( hash, pt.x, pt.y );
+    }
+
+    std::vector<NETINFO_ITEM*> nets = { net };
+
+    if( m_tuningMode != SINGLE )
+    {
+        if( NETINFO_ITEM* coupledNet = aBoard->DpCoupledNet( net ) )
+            nets.push_back( coupledNet );
+    }
+
+    std::shared_ptr<CONNECTIVITY_DATA> connectivity = aBoard->GetConnectivity();
+
+    for( NETINFO_ITEM* tunedNet : nets )
+    {
+        // Connectivity doesn't guarantee any item order, so combine the per-item hashes
+        // in an order-independent way.
+        size_t netHash = 0;
+
+        for( BOARD_CONNECTED_ITEM* item : connectivity->GetNetItems( tunedNet->GetNetCode(),
+                                                                     { PCB_TRACE_T, PCB_ARC_T,
+                                                                       PCB_VIA_T, PCB_PAD_T } ) )
+        {
+            size_t itemHash = hash_val( static_cast<int>( item->Type() ) );
+
+            if( item->Type() == PCB_PAD_T )
+            {
+                const PAD* pad = static_cast<const PAD*>( item );
+                hash_combine( itemHash, pad->GetPosition().x, pad->GetPosition().y,
+                              pad->GetPadToDieLength() );
+            }
+            else
+            {
+                const PCB_TRACK* track = static_cast<const PCB_TRACK*>( item );
+                hash_combine( itemHash, track->GetStart().x, track->GetStart().y,
+                              track->GetEnd().x, track->GetEnd().y, track->GetWidth(),
+                              static_cast<int>( track->GetLayer() ) );
+
+                if( track->Type() == PCB_ARC_T )
+                {
+                    const VECTOR2I& mid = static_cast<const PCB_ARC*>( track )->GetMid();
+                    hash_combine( itemHash, mid.x, mid.y );
+                }
+            }
+
+            netHash += itemHash;
+        }
+
+        hash_combine( hash, netHash );
+    }
+
+    return hash == 0 ? 1 : hash;
+}
+
+
+bool PCB_TUNING_PATTERN::tuningResultInTarget() const
+{
+    if( m_tuningMode == DIFF_PAIR_SKEW )
+    {
+        return m_tuningResult >= m_settings.m_targetSkew.Min()
+               && m_tuningResult <= m_settings.m_targetSkew.Max();
+    }
+
+    return m_tuningResult >= m_settings.m_targetLength.Min()
+           && m_tuningResult <= m_settings.m_targetLength.Max();
 }
 
 
@@ -1127,7 +1262,7 @@ void PCB_TUNING_PATTERN::Remove( GENERATOR_TOOL* aTool, BOARD* aBoard, BOARD_COM
 {
     SetFlags( IN_EDIT );
 
-    aTool->Router()->SyncWorld();
+    aTool->SyncRouterWorld();
 
     PNS::ROUTER* router = aTool->Router();
     PNS_KICAD_IFACE* iface = aTool->GetInterface();
@@ -1355,6 +1490,15 @@ bool PCB_TUNING_PATTERN::Update( GENERATOR_TOOL* aTool, BOARD* aBoard, BOARD_COM
     if( !( GetFlags() & IN_EDIT ) )
         return false;
 
+    // The pattern may have been moved since EditStart() (the move tool starts the edit before
+    // moving it), so check again against the current geometry
+    bool upToDate = m_upToDate && m_lastUpdateHash == updateHash( aBoard );
+
+    m_upToDate = false;
+
+    if( upToDate )
+        return true;
+
     KIGFX::VIEW*     view = aTool->GetManager()->GetView();
     PNS::ROUTER*     router = aTool->Router();
     PNS_KICAD_IFACE* iface = aTool->GetInterface();
@@ -1456,6 +1600,7 @@ bool PCB_TUNING_PATTERN::Update( GENERATOR_TOOL* aTool, BOARD* aBoard, BOARD_COM
     m_settings = placer->MeanderSettings();
     m_lastNetName = iface->GetNetName( startItem->Net() );
     m_tuningStatus = placer->TuningStatus();
+    m_tuningResult = placer->TuningResult();
 
     wxString statusMessage;
 
@@ -1546,6 +1691,8 @@ void PCB_TUNING_PATTERN::EditPush( GENERATOR_TOOL* aTool, BOARD* aBoard, BOARD_C
         aCommit->Push( _( "Edit Tuning Pattern" ), aCommitFlags );
     else
         aCommit->Push( aCommitMsg, aCommitFlags );
+
+    m_lastUpdateHash = updateHash( aBoard );
 }
 
 
@@ -1624,6 +1771,8 @@ bool PCB_TUNING_PATTERN::UpdateFromEditPoints( EDIT_POINTS& aEditPoints )
     VECTOR2I centerlineOffset;
     VECTOR2I centerlineOffsetEnd;
 
+    m_upToDate = false;
+
     if( m_tuningMode == DIFF_PAIR && m_baseLineCoupled && m_baseLineCoupled->SegmentCount() > 0 )
     {
         centerlineOffset = ( m_baseLineCoupled->CPoint( 0 ) - m_origin ) / 2;
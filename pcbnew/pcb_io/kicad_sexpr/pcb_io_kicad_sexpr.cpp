@@ -22,12 +22,18 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <algorithm>
+#include <fstream>
+#include <future>
+#include <map>
+
 #include <wx/dir.h>
 #include <wx/ffile.h>
 #include <wx/log.h>
 #include <wx/msgdlg.h>
 #include <wx/mstream.h>
 
+#include <advanced_config.h>
 #include <board.h>
 #include <board_design_settings.h>
 #include <callback_gal.h>
@@ -37,15 +43,20 @@
 #include <font/fontconfig.h>
 #include <footprint.h>
 #include <io/kicad/kicad_io_utils.h>
+#include <json_common.h>
+#include <json_conversions.h>
 #include <kiface_base.h>
 #include <layer_range.h>
 #include <locale_io.h>
 #include <macros.h>
+#include <mmh3_hash.h>
 #include <pad.h>
+#include <paths.h>
 #include <pcb_dimension.h>
 #include <pcb_generator.h>
 #include <pcb_group.h>
 #include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr.h>
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr_fill_cache.h>
 #include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr_parser.h>
 #include <pcb_reference_image.h>
 #include <pcb_shape.h>
@@ -60,6 +71,7 @@
 #include <progress_reporter.h>
 #include <reporter.h>
 #include <string_utils.h>
+#include <thread_pool.h>
 #include <trace_helpers.h>
 #include <wildcards_and_files_ext.h>
 #include <zone.h>
@@ -71,13 +83,206 @@
 
 using namespace PCB_KEYS_T;
 
+/// Boards with fewer items (footprints, tracks, etc.) are saved on one thread
+static constexpr size_t PARALLEL_SAVE_MIN_ITEMS = 2000;
+
+
+/// Libraries with fewer footprints are saved on one thread
+static constexpr size_t PARALLEL_SAVE_MIN_FOOTPRINTS = 64;
+
+
+/**
+ * Texts drawn with an outline font are saved with their render cache, which is built on demand
+ * with the font libraries.  Items having one must be formatted on the main thread.
+ *
+ * @return true if \a aItem or one of its children is a text drawn with an outline font.
+ */
+static bool hasOutlineText( BOARD_ITEM* aItem )
+{
+    bool outlineText = false;
+
+    auto check =
+            [&]( BOARD_ITEM* aChild )
+            {
+                if( EDA_TEXT* text = dynamic_cast<EDA_TEXT*>( aChild ) )
+                    outlineText |= text->GetFont() && text->GetFont()->IsOutline();
+            };
+
+    check( aItem );
+    aItem->RunOnDescendants( check );
+
+    return outlineText;
+}
+
+
+/// Bump when the content of the footprint library indexes changes
+static constexpr int FP_INDEX_VERSION = 1;
+
+
+/**
+ * A footprint file, as recorded in the index of its library.
+ */
+struct FP_INDEX_ENTRY
+{
+    long long         m_timestamp;
+    long long         m_size;
+    FOOTPRINT_SUMMARY m_summary;
+};
+
+
+/**
+ * @return the path of the index of a footprint library, in the user cache folder.
+ */
+static wxString fpIndexPath( const wxString& aLibPath )
+{
+    MMH3_HASH hash;
+
+    hash.add( std::string( aLibPath.ToUTF8() ) );
+
+    wxFileName fn( PATHS::GetUserCachePath(), hash.digest().ToString(), wxT( "json" ) );
+    fn.AppendDir( wxT( "footprint-index" ) );
+
+    return fn.GetFullPath();
+}
+
+
+/**
+ * Read the index of a footprint library, by file name.  A missing or invalid index is empty.
+ */
+static std::map<wxString, FP_INDEX_ENTRY> readFpIndex( const wxString& aLibPath )
+{
+    std::map<wxString, FP_INDEX_ENTRY> index;
+    wxString                           indexPath = fpIndexPath( aLibPath );
+
+    if( !wxFileExists( indexPath ) )
+        return index;
+
+    try
+    {
+        nlohmann::json json;
+        std::ifstream  indexFile( indexPath.fn_str() );
+
+        indexFile >> json;
+
+        if( json.at( "version" ).get<int>() != FP_INDEX_VERSION
+                || json.at( "library" ).get<wxString>() != aLibPath )
+        {
+            return index;
+        }
+
+        for( const nlohmann::json& file : json.at( "footprints" ) )
+        {
+            FP_INDEX_ENTRY entry;
+
+            entry.m_timestamp = file.at( "timestamp" ).get<long long>();
+            entry.m_size = file.at( "size" ).get<long long>();
+            entry.m_summary.m_Description = file.at( "description" ).get<wxString>();
+            entry.m_summary.m_Keywords = file.at( "keywords" ).get<wxString>();
+            entry.m_summary.m_PadCount = file.at( "pad_count" ).get<unsigned>();
+            entry.m_summary.m_UniquePadCount = file.at( "unique_pad_count" ).get<unsigned>();
+
+            index[file.at( "file" ).get<wxString>()] = entry;
+        }
+    }
+    catch( const nlohmann::json::exception& e )
+    {
+        // It is only a cache, an invalid index is rebuilt by the caller
+        wxLogTrace( traceKicadPcbPlugin, wxT( "Invalid footprint library index '%s': %s" ),
+                    indexPath, e.what() );
+        index.clear();
+    }
+
+    return index;
+}
+
+
+static void writeFpIndex( const wxString& aLibPath,
+                          const std::map<wxString, FP_INDEX_ENTRY>& aIndex )
+{
+    wxString   indexPath = fpIndexPath( aLibPath );
+    wxFileName indexFile( indexPath );
+
+    if( !indexFile.DirExists() && !indexFile.Mkdir( wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL ) )
+        return;
+
+    nlohmann::json json;
+    nlohmann::json footprints = nlohmann::json::array();
+
+    for( const auto& [fileName, entry] : aIndex )
+    {
+        footprints.push_back( { { "file", fileName },
+                                { "timestamp", entry.m_timestamp },
+                                { "size", entry.m_size },
+                                { "description", entry.m_summary.m_Description },
+                                { "keywords", entry.m_summary.m_Keywords },
+                                { "pad_count", entry.m_summary.m_PadCount },
+                                { "unique_pad_count", entry.m_summary.m_UniquePadCount } } );
+    }
+
+    json["version"] = FP_INDEX_VERSION;
+    json["library"] = aLibPath;
+    json["footprints"] = std::move( footprints );
+
+    std::string text = json.dump( 0 );
+    wxString    tmpFileName = wxFileName::CreateTempFileName( indexPath );
+    bool        written = false;
+
+    {
+        wxFFile tmpFile( tmpFileName, wxT( "wb" ) );
+
+        if( tmpFile.IsOpened() )
+            written = tmpFile.Write( text.data(), text.size() ) == text.size() && tmpFile.Close();
+    }
+
+    // It is only a cache, an index which cannot be replaced is rebuilt next time
+    if( !written || !wxRenameFile( tmpFileName, indexPath, true ) )
+        wxRemoveFile( tmpFileName );
+}
+
 
 FP_CACHE_ITEM::FP_CACHE_ITEM( FOOTPRINT* aFootprint, const WX_FILENAME& aFileName ) :
         m_filename( aFileName ),
-        m_footprint( aFootprint )
+        m_footprint( aFootprint ),
+        m_summary( *aFootprint ),
+        m_parseFailed( false )
+{ }
+
+
+FP_CACHE_ITEM::FP_CACHE_ITEM( const WX_FILENAME& aFileName, const FOOTPRINT_SUMMARY& aSummary ) :
+        m_filename( aFileName ),
+        m_summary( aSummary ),
+        m_parseFailed( false )
 { }
 
 
+std::unique_ptr<FOOTPRINT>& FP_CACHE_ITEM::GetFootprint( bool aResolveFonts )
+{
+    if( !m_footprint && !m_parseFailed )
+    {
+        try
+        {
+            MMAP_LINE_READER          reader( m_filename.GetFullPath() );
+            PCB_IO_KICAD_SEXPR_PARSER parser( &reader, nullptr, nullptr );
+
+            parser.SetWorker( !aResolveFonts );
+            m_footprint.reset( dynamic_cast<FOOTPRINT*>( parser.Parse() ) );
+        }
+        catch( const IO_ERROR& ioe )
+        {
+            wxLogTrace( traceKicadPcbPlugin, wxT( "Cannot parse indexed footprint '%s': %s" ),
+                        m_filename.GetFullPath(), ioe.What() );
+        }
+
+        if( m_footprint )
+            m_footprint->SetFPID( LIB_ID( wxEmptyString, m_filename.GetName() ) );
+        else
+            m_parseFailed = true;
+    }
+
+    return m_footprint;
+}
+
+
 FP_CACHE::FP_CACHE( PCB_IO_KICAD_SEXPR* aOwner, const wxString& aLibraryPath )
 {
     m_owner = aOwner;
@@ -85,6 +290,73 @@ FP_CACHE::FP_CACHE( PCB_IO_KICAD_SEXPR* aOwner, const wxString& aLibraryPath )
     m_lib_path.SetPath( aLibraryPath );
     m_cache_timestamp = 0;
     m_cache_dirty = true;
+    m_parallel = false;
+}
+
+
+/**
+ * Call \a aFunc( start, end ) over [0, aCount), in blocks on the thread pool if \a aParallel.
+ */
+template <typename FUNC>
+static void forBlocks( size_t aCount, bool aParallel, FUNC&& aFunc )
+{
+    if( !aParallel )
+    {
+        aFunc( 0, aCount );
+        return;
+    }
+
+    thread_pool& tp = GetKiCadThreadPool();
+
+    tp.parallelize_loop( aCount, aFunc ).wait();
+}
+
+
+/**
+ * Write \a aFootprint to its library file \a aFileName, formatted by \a aPlugin.
+ */
+static void saveFootprintFile( FOOTPRINT* aFootprint, const WX_FILENAME& aFileName,
+                               PCB_IO_KICAD_SEXPR& aPlugin )
+{
+    wxString fileName = aFileName.GetFullPath();
+
+    // Allow file output stream to go out of scope to close the file stream before
+    // renaming the file.
+    {
+#ifdef USE_TMP_FILE
+        fileName = wxFileName::CreateTempFileName( aFileName.GetPath() );
+
+        wxLogTrace( traceKicadPcbPlugin, wxT( "Creating temporary library file '%s'." ),
+                    fileName );
+#else
+        wxLogTrace( traceKicadPcbPlugin, wxT( "Writing library file '%s'." ),
+                    fileName );
+#endif
+
+        PRETTIFIED_FILE_OUTPUTFORMATTER formatter( fileName );
+
+        aPlugin.SetOutputFormatter( &formatter );
+        aPlugin.Format( aFootprint );
+    }
+
+#ifdef USE_TMP_FILE
+    wxRemove( aFileName.GetFullPath() );     // it is not an error if this does not exist
+
+    // Even on Linux you can see an _intermittent_ error when calling wxRename(),
+    // and it is fully inexplicable.  See if this dodges the error.
+    wxMilliSleep( 250L );
+
+    // Preserve the permissions of the current file
+    KIPLATFORM::IO::DuplicatePermissions( aFileName.GetFullPath(), fileName );
+
+    if( !wxRenameFile( fileName, aFileName.GetFullPath() ) )
+    {
+        wxString msg = wxString::Format( _( "Cannot rename temporary file '%s' to '%s'" ),
+                                         fileName,
+                                         aFileName.GetFullPath() );
+        THROW_IO_ERROR( msg );
+    }
+#endif
 }
 
 
@@ -104,14 +376,30 @@ void FP_CACHE::Save( FOOTPRINT* aFootprintFilter )
                                           m_lib_raw_path ) );
     }
 
+    // A full save writes every footprint.  A single one is already in memory: the others are
+    // left as they are.
+    if( !aFootprintFilter )
+        ParseFootprints();
+
+    std::vector<FP_CACHE_ITEM*> entries;
+    wxString                    filterName;
+
+    if( aFootprintFilter )
+        filterName = aFootprintFilter->GetFPID().GetLibItemName();
+
     for( auto it = m_footprints.begin(); it != m_footprints.end(); ++it )
     {
-        FP_CACHE_ITEM*              fpCacheEntry = it->second;
-        std::unique_ptr<FOOTPRINT>& footprint = fpCacheEntry->GetFootprint();
+        FP_CACHE_ITEM* fpCacheEntry = it->second;
 
-        if( aFootprintFilter && footprint.get() != aFootprintFilter )
+        if( aFootprintFilter && it->first != filterName )
             continue;
 
+        // Entries never loaded are unchanged since they were read from their file
+        if( !fpCacheEntry->IsLoaded() )
+            continue;
+
+        std::unique_ptr<FOOTPRINT>& footprint = fpCacheEntry->GetFootprint();
+
         // If we've requested to embed the fonts in the footprint, do so.  Otherwise, clear the
         // embedded fonts from the footprint.  Embedded fonts will be used if available.
         if( footprint->GetAreFontsEmbedded() )
@@ -119,46 +407,77 @@ void FP_CACHE::Save( FOOTPRINT* aFootprintFilter )
         else
             footprint->GetEmbeddedFiles()->ClearEmbeddedFonts();
 
-        WX_FILENAME fn = fpCacheEntry->GetFileName();
-        wxString    fileName = fn.GetFullPath();
+        entries.push_back( fpCacheEntry );
+    }
 
-        // Allow file output stream to go out of scope to close the file stream before
-        // renaming the file.
+    thread_pool& tp = GetKiCadThreadPool();
+
+    if( m_parallel && entries.size() >= PARALLEL_SAVE_MIN_FOOTPRINTS
+            && tp.get_thread_count() > 1 )
+    {
+        // Footprints with outline texts are saved on this thread, the others by worker plugins.
+        // The first error in library order is thrown once all the files are written.
+        std::vector<size_t>             workerEntries;
+        std::vector<size_t>             mainThreadEntries;
+        std::vector<std::exception_ptr> errors( entries.size() );
+
+        for( size_t ii = 0; ii < entries.size(); ++ii )
         {
-#ifdef USE_TMP_FILE
-            fileName = wxFileName::CreateTempFileName( fn.GetPath() );
+            if( hasOutlineText( entries[ii]->GetFootprint().get() ) )
+                mainThreadEntries.push_back( ii );
+            else
+                workerEntries.push_back( ii );
+        }
 
-            wxLogTrace( traceKicadPcbPlugin, wxT( "Creating temporary library file '%s'." ),
-                        fileName );
-#else
-            wxLogTrace( traceKicadPcbPlugin, wxT( "Writing library file '%s'." ),
-                        fileName );
-#endif
+        auto saveEntries =
+                [&]( const std::vector<size_t>& aIndices, size_t aStart, size_t aEnd,
+                     PCB_IO_KICAD_SEXPR& aPlugin )
+                {
+                    for( size_t ii = aStart; ii < aEnd; ++ii )
+                    {
+                        FP_CACHE_ITEM* entry = entries[aIndices[ii]];
+
+                        try
+                        {
+                            saveFootprintFile( entry->GetFootprint().get(), entry->GetFileName(),
+                                               aPlugin );
+                        }
+                        catch( ... )
+                        {
+                            errors[aIndices[ii]] = std::current_exception();
+                        }
+                    }
+                };
 
-            PRETTIFIED_FILE_OUTPUTFORMATTER formatter( fileName );
+        auto saveWorkerEntries =
+                [&]( size_t aStart, size_t aEnd )
+                {
+                    PCB_IO_KICAD_SEXPR worker( *m_owner, nullptr );
 
-            m_owner->SetOutputFormatter( &formatter );
-            m_owner->Format( footprint.get() );
-        }
+                    saveEntries( workerEntries, aStart, aEnd, worker );
+                };
 
-#ifdef USE_TMP_FILE
-        wxRemove( fn.GetFullPath() );     // it is not an error if this does not exist
+        auto returns = tp.parallelize_loop( workerEntries.size(), saveWorkerEntries );
 
-        // Even on Linux you can see an _intermittent_ error when calling wxRename(),
-        // and it is fully inexplicable.  See if this dodges the error.
-        wxMilliSleep( 250L );
+        saveEntries( mainThreadEntries, 0, mainThreadEntries.size(), *m_owner );
 
-        // Preserve the permissions of the current file
-        KIPLATFORM::IO::DuplicatePermissions( fn.GetFullPath(), fileName );
+        returns.wait();
 
-        if( !wxRenameFile( fileName, fn.GetFullPath() ) )
+        for( const std::exception_ptr& error : errors )
         {
-            wxString msg = wxString::Format( _( "Cannot rename temporary file '%s' to '%s'" ),
-                                             fileName,
-                                             fn.GetFullPath() );
-            THROW_IO_ERROR( msg );
+            if( error )
+                std::rethrow_exception( error );
         }
-#endif
+    }
+    else
+    {
+        for( FP_CACHE_ITEM* entry : entries )
+            saveFootprintFile( entry->GetFootprint().get(), entry->GetFileName(), *m_owner );
+    }
+
+    for( FP_CACHE_ITEM* entry : entries )
+    {
+        WX_FILENAME fn = entry->GetFileName();
         m_cache_timestamp += fn.GetTimestamp();
     }
 
@@ -184,6 +503,16 @@ void FP_CACHE::Load()
         THROW_IO_ERROR( msg );
     }
 
+    /// A file which is not in the index, or changed since it was indexed
+    struct FILE_TO_PARSE
+    {
+        WX_FILENAME                m_filename;
+        long long                  m_timestamp;
+        long long                  m_size;
+        std::unique_ptr<FOOTPRINT> m_footprint;
+        wxString                   m_error;
+    };
+
     wxString fullName;
     wxString fileSpec = wxT( "*." ) + wxString( FILEEXT::KiCadFootprintFileExtension );
 
@@ -193,46 +522,127 @@ void FP_CACHE::Load()
 
     if( dir.GetFirst( &fullName, fileSpec ) )
     {
-        wxString cacheError;
+        wxString                           cacheError;
+        std::map<wxString, FP_INDEX_ENTRY> oldIndex = readFpIndex( m_lib_raw_path );
+        std::map<wxString, FP_INDEX_ENTRY> newIndex;
+        std::vector<FILE_TO_PARSE>         filesToParse;
 
         do
         {
             fn.SetFullName( fullName );
 
-            // Queue I/O errors so only files that fail to parse don't get loaded.
-            try
+            wxString  fpName = fn.GetName();
+            long long timestamp = fn.GetTimestamp();
+            long long size = wxFileName::GetSize( fn.GetFullPath() ).GetValue();
+            auto      indexed = oldIndex.find( fullName );
+
+            // Unchanged files are known from the index, and parsed only when needed
+            if( indexed != oldIndex.end() && indexed->second.m_timestamp == timestamp
+                    && indexed->second.m_size == size )
             {
-                FILE_LINE_READER reader( fn.GetFullPath() );
-                PCB_IO_KICAD_SEXPR_PARSER       parser( &reader, nullptr, nullptr );
+                m_footprints.insert( fpName, new FP_CACHE_ITEM( fn, indexed->second.m_summary ) );
+                newIndex[fullName] = indexed->second;
+                continue;
+            }
+
+            filesToParse.push_back( { fn, timestamp, size, nullptr, wxEmptyString } );
+        } while( dir.GetNext( &fullName ) );
 
-                FOOTPRINT* footprint = dynamic_cast<FOOTPRINT*>( parser.Parse() );
-                wxString fpName = fn.GetName();
+        // Queue I/O errors so only files that fail to parse don't get loaded.
+        auto parseFiles =
+                [&]( size_t aStart, size_t aEnd )
+                {
+                    for( size_t ii = aStart; ii < aEnd; ++ii )
+                    {
+                        FILE_TO_PARSE& file = filesToParse[ii];
+
+                        try
+                        {
+                            MMAP_LINE_READER          reader( file.m_filename.GetFullPath() );
+                            PCB_IO_KICAD_SEXPR_PARSER parser( &reader, nullptr, nullptr );
+
+                            parser.SetWorker( m_parallel );
+                            file.m_footprint.reset( dynamic_cast<FOOTPRINT*>( parser.Parse() ) );
+
+                            if( !file.m_footprint )
+                                THROW_IO_ERROR( wxEmptyString );   // caught locally, just below...
+                        }
+                        catch( const IO_ERROR& ioe )
+                        {
+                            file.m_error = ioe.What();
+                        }
+                    }
+                };
 
-                if( !footprint )
-                    THROW_IO_ERROR( wxEmptyString );   // caught locally, just below...
+        forBlocks( filesToParse.size(), m_parallel, parseFiles );
+
+        // Back on this thread, in directory order
+        for( FILE_TO_PARSE& file : filesToParse )
+        {
+            if( FOOTPRINT* footprint = file.m_footprint.release() )
+            {
+                wxString fpName = file.m_filename.GetName();
+
+                if( m_parallel )
+                    PCB_IO_KICAD_SEXPR_PARSER::ResolveFonts( footprint );
 
                 footprint->SetFPID( LIB_ID( wxEmptyString, fpName ) );
-                m_footprints.insert( fpName, new FP_CACHE_ITEM( footprint, fn ) );
+                m_footprints.insert( fpName, new FP_CACHE_ITEM( footprint, file.m_filename ) );
+                newIndex[file.m_filename.GetFullName()] = { file.m_timestamp, file.m_size,
+                                                            FOOTPRINT_SUMMARY( *footprint ) };
             }
-            catch( const IO_ERROR& ioe )
+            else
             {
                 if( !cacheError.IsEmpty() )
                     cacheError += wxT( "\n\n" );
 
                 cacheError += wxString::Format( _( "Unable to read file '%s'" ) + '\n',
-                                                fn.GetFullPath() );
-                cacheError += ioe.What();
+                                                file.m_filename.GetFullPath() );
+                cacheError += file.m_error;
             }
-        } while( dir.GetNext( &fullName ) );
+        }
 
         m_cache_timestamp = GetTimestamp( m_lib_raw_path );
 
+        // Also drop the entries of deleted files
+        if( !filesToParse.empty() || newIndex.size() != oldIndex.size() )
+            writeFpIndex( m_lib_raw_path, newIndex );
+
         if( !cacheError.IsEmpty() )
             THROW_IO_ERROR( cacheError );
     }
 }
 
 
+void FP_CACHE::ParseFootprints()
+{
+    std::vector<FP_CACHE_ITEM*> items;
+
+    for( const auto& footprint : m_footprints )
+    {
+        if( !footprint.second->IsLoaded() )
+            items.push_back( footprint.second );
+    }
+
+    // Each item only parses its own file.  Fonts are loaded back on this thread.
+    forBlocks( items.size(), m_parallel,
+               [&]( size_t aStart, size_t aEnd )
+               {
+                   for( size_t ii = aStart; ii < aEnd; ++ii )
+                       items[ii]->GetFootprint( !m_parallel );
+               } );
+
+    if( m_parallel )
+    {
+        for( FP_CACHE_ITEM* item : items )
+        {
+            if( item->IsLoaded() )
+                PCB_IO_KICAD_SEXPR_PARSER::ResolveFonts( item->GetFootprint().get() );
+        }
+    }
+}
+
+
 void FP_CACHE::Remove( const wxString& aFootprintName )
 {
     FP_CACHE_FOOTPRINT_MAP::const_iterator it = m_footprints.find( aFootprintName );
@@ -260,10 +670,12 @@ bool FP_CACHE::IsPath( const wxString& aPath ) const
 
 void FP_CACHE::SetPath( const wxString& aPath )
 {
+    // Parse the footprints known from the index while their files are still at hand
+    ParseFootprints();
+
     m_lib_raw_path = aPath;
     m_lib_path.SetPath( aPath );
 
-
     for( const auto& footprint : GetFootprints() )
     {
         footprint.second->SetFilePath( aPath );
@@ -776,31 +1188,37 @@ void PCB_IO_KICAD_SEXPR::format( const BOARD* aBoard ) const
                                                                    aBoard->Generators().end() );
     formatHeader( aBoard );
 
-    // Save the footprints.
-    for( BOARD_ITEM* footprint : sorted_footprints )
-        Format( footprint );
-
-    // Save the graphical items on the board (not owned by a footprint)
-    for( BOARD_ITEM* item : sorted_drawings )
-        Format( item );
+    // Footprints, then the graphical items on the board (not owned by a footprint), tracks and
+    // vias, zones, groups and generators.  Do not save PCB_MARKERs, they can be regenerated easily.
+    std::vector<BOARD_ITEM*> items;
 
-    // Do not save PCB_MARKERs, they can be regenerated easily.
+    items.reserve( sorted_footprints.size() + sorted_drawings.size() + sorted_tracks.size()
+                   + sorted_zones.size() + sorted_groups.size() + sorted_generators.size() );
 
-    // Save the tracks and vias.
-    for( PCB_TRACK* track : sorted_tracks )
-        Format( track );
+    items.insert( items.end(), sorted_footprints.begin(), sorted_footprints.end() );
+    items.insert( items.end(), sorted_drawings.begin(), sorted_drawings.end() );
+    items.insert( items.end(), sorted_tracks.begin(), sorted_tracks.end() );
+    items.insert( items.end(), sorted_zones.begin(), sorted_zones.end() );
+    items.insert( items.end(), sorted_groups.begin(), sorted_groups.end() );
+    items.insert( items.end(), sorted_generators.begin(), sorted_generators.end() );
 
-    // Save the polygon (which are the newer technology) zones.
-    for( auto zone : sorted_zones )
-        Format( zone );
+    bool parallel;
 
-    // Save the groups
-    for( BOARD_ITEM* group : sorted_groups )
-        Format( group );
+    if( m_parallelSaveMinItems )
+        parallel = items.size() >= m_parallelSaveMinItems;
+    else
+        parallel = items.size() >= PARALLEL_SAVE_MIN_ITEMS
+                   && GetKiCadThreadPool().get_thread_count() > 1;
 
-    // Save the generators
-    for( BOARD_ITEM* gen : sorted_generators )
-        Format( gen );
+    if( parallel )
+    {
+        formatItemsInParallel( items );
+    }
+    else
+    {
+        for( BOARD_ITEM* item : items )
+            Format( item );
+    }
 
     // Save any embedded files
     // Consolidate the embedded models in footprints into a single map
@@ -829,6 +1247,101 @@ void PCB_IO_KICAD_SEXPR::format( const BOARD* aBoard ) const
 }
 
 
+void PCB_IO_KICAD_SEXPR::formatItemsInParallel( const std::vector<BOARD_ITEM*>& aItems ) const
+{
+    struct CHUNK
+    {
+        size_t      m_first;
+        size_t      m_last;
+        bool        m_mainThread;
+        std::string m_text;
+    };
+
+    thread_pool& tp = GetKiCadThreadPool();
+
+    // A few chunks per thread, as footprints take much longer to format than tracks
+    const size_t minItems = m_parallelSaveMinItems ? m_parallelSaveMinItems
+                                                   : PARALLEL_SAVE_MIN_ITEMS;
+    const size_t chunkSize = std::max<size_t>( { 1, minItems / 4,
+                                                 aItems.size() / ( tp.get_thread_count() * 4 ) } );
+
+    std::vector<CHUNK> chunks;
+
+    for( size_t ii = 0; ii < aItems.size(); ++ii )
+    {
+        bool mainThread = hasOutlineText( aItems[ii] );
+
+        if( chunks.empty() || chunks.back().m_mainThread != mainThread
+                || chunks.back().m_last - chunks.back().m_first >= chunkSize )
+        {
+            chunks.push_back( { ii, ii + 1, mainThread, {} } );
+        }
+        else
+        {
+            chunks.back().m_last = ii + 1;
+        }
+    }
+
+    auto formatChunk =
+            [&]( CHUNK& aChunk )
+            {
+                STRING_FORMATTER   formatter;
+                PCB_IO_KICAD_SEXPR worker( *this, &formatter );
+
+                for( size_t ii = aChunk.m_first; ii < aChunk.m_last; ++ii )
+                    worker.Format( aItems[ii] );
+
+                aChunk.m_text = formatter.GetString();
+            };
+
+    std::vector<std::future<void>> returns;
+
+    for( CHUNK& chunk : chunks )
+    {
+        if( !chunk.m_mainThread )
+            returns.emplace_back( tp.submit( [&formatChunk, &chunk]() { formatChunk( chunk ); } ) );
+    }
+
+    std::exception_ptr error;
+
+    try
+    {
+        for( CHUNK& chunk : chunks )
+        {
+            if( chunk.m_mainThread )
+                formatChunk( chunk );
+        }
+    }
+    catch( ... )
+    {
+        error = std::current_exception();
+    }
+
+    // Wait for all the workers before leaving, they use the chunks
+    for( std::future<void>& ret : returns )
+    {
+        try
+        {
+            ret.get();
+        }
+        catch( ... )
+        {
+            if( !error )
+                error = std::current_exception();
+        }
+    }
+
+    if( error )
+        std::rethrow_exception( error );
+
+    for( CHUNK& chunk : chunks )
+    {
+        m_out->Write( chunk.m_text );
+        std::string().swap( chunk.m_text );
+    }
+}
+
+
 void PCB_IO_KICAD_SEXPR::format( const PCB_DIMENSION_BASE* aDimension ) const
 {
     const PCB_DIM_ALIGNED*    aligned = dynamic_cast<const PCB_DIM_ALIGNED*>( aDimension );
@@ -2670,27 +3183,37 @@ void PCB_IO_KICAD_SEXPR::format( const ZONE* aZone ) const
 PCB_IO_KICAD_SEXPR::PCB_IO_KICAD_SEXPR( int aControlFlags ) : PCB_IO( wxS( "KiCad" ) ),
     m_cache( nullptr ),
     m_ctl( aControlFlags ),
-    m_mapping( new NETINFO_MAPPING() )
+    m_mapping( std::make_shared<NETINFO_MAPPING>() ),
+    m_parallelSaveMinItems( 0 )
 {
     init( nullptr );
     m_out = &m_sf;
 }
 
 
+PCB_IO_KICAD_SEXPR::PCB_IO_KICAD_SEXPR( const PCB_IO_KICAD_SEXPR& aParent,
+                                        OUTPUTFORMATTER* aOut ) :
+        PCB_IO( wxS( "KiCad" ) ),
+        m_cache( nullptr ),
+        m_ctl( aParent.m_ctl ),
+        m_mapping( aParent.m_mapping ),
+        m_parallelSaveMinItems( 0 )
+{
+    init( aParent.m_props );
+    m_board = aParent.m_board;
+    m_out = aOut;
+}
+
+
 PCB_IO_KICAD_SEXPR::~PCB_IO_KICAD_SEXPR()
 {
     delete m_cache;
-    delete m_mapping;
 }
 
 
 BOARD* PCB_IO_KICAD_SEXPR::LoadBoard( const wxString& aFileName, BOARD* aAppendToMe,
                               const std::map<std::string, UTF8>* aProperties, PROJECT* aProject )
 {
-    FILE_LINE_READER reader( aFileName );
-
-    unsigned lineCount = 0;
-
     fontconfig::FONTCONFIG::SetReporter( &WXLOG_REPORTER::GetInstance() );
 
     if( m_progressReporter )
@@ -2699,14 +3222,42 @@ BOARD* PCB_IO_KICAD_SEXPR::LoadBoard( const wxString& aFileName, BOARD* aAppendT
 
         if( !m_progressReporter->KeepRefreshing() )
             THROW_IO_ERROR( _( "Open cancelled by user." ) );
+    }
 
-        while( reader.ReadLine() )
-            lineCount++;
+    MMAP_LINE_READER reader( aFileName );
+    BOARD*           board = nullptr;
+    BOARD_FILL_CACHE fillCache;
 
-        reader.Rewind();
+    // Zone fills saved with the board can be read from its cache instead of its text.  The
+    // board text is only hashed when there is a cache to check it against.
+    if( !aAppendToMe && ADVANCED_CFG::GetCfg().m_BoardFillCache
+            && wxFileExists( BOARD_FILL_CACHE::GetCachePath( aFileName ) ) )
+    {
+        fillCache.Open( aFileName, BOARD_FILL_CACHE::HashText( reader.GetText() ) );
     }
 
-    BOARD* board = DoLoad( reader, aAppendToMe, aProperties, m_progressReporter, lineCount );
+    // New boards can have their items parsed in parallel.  When appending, UUIDs are remapped
+    // in file order and this is left to the serial parser.
+    if( !aAppendToMe )
+    {
+        init( aProperties );
+        board = PCB_IO_KICAD_SEXPR_PARSER::ParseBoardInParallel( reader.GetText(), aFileName,
+                                                                 m_queryUserCallback,
+                                                                 m_progressReporter,
+                                                                 &fillCache );
+    }
+
+    if( !board )
+    {
+        std::string_view text = reader.GetText();
+        unsigned         lineCount = 0;
+
+        if( m_progressReporter )
+            lineCount = static_cast<unsigned>( std::count( text.begin(), text.end(), '\n' ) );
+
+        board = DoLoad( reader, aAppendToMe, aProperties, m_progressReporter, lineCount,
+                        &fillCache );
+    }
 
     // Give the filename to the board if it's new
     if( !aAppendToMe )
@@ -2717,13 +3268,17 @@ BOARD* PCB_IO_KICAD_SEXPR::LoadBoard( const wxString& aFileName, BOARD* aAppendT
 
 
 BOARD* PCB_IO_KICAD_SEXPR::DoLoad( LINE_READER& aReader, BOARD* aAppendToMe, const std::map<std::string, UTF8>* aProperties,
-                           PROGRESS_REPORTER* aProgressReporter, unsigned aLineCount)
+                           PROGRESS_REPORTER* aProgressReporter, unsigned aLineCount,
+                           const BOARD_FILL_CACHE* aFillCache )
 {
     init( aProperties );
 
     PCB_IO_KICAD_SEXPR_PARSER parser( &aReader, aAppendToMe, m_queryUserCallback, aProgressReporter, aLineCount );
     BOARD*     board;
 
+    if( aFillCache && aFillCache->IsOpen() )
+        parser.SetFillCache( aFillCache );
+
     try
     {
         board = dynamic_cast<BOARD*>( parser.Parse() );
@@ -2839,6 +3394,35 @@ const FOOTPRINT* PCB_IO_KICAD_SEXPR::GetEnumeratedFootprint( const wxString& aLi
 }
 
 
+bool PCB_IO_KICAD_SEXPR::GetFootprintSummary( const wxString& aLibraryPath,
+                                              const wxString& aFootprintName,
+                                              FOOTPRINT_SUMMARY& aSummary,
+                                              const std::map<std::string, UTF8>* aProperties )
+{
+    LOCALE_IO toggle;     // toggles on, then off, the C locale.
+
+    init( aProperties );
+
+    try
+    {
+        validateCache( aLibraryPath, false );
+    }
+    catch( const IO_ERROR& )
+    {
+        // do nothing with the error
+    }
+
+    FP_CACHE_FOOTPRINT_MAP& footprints = m_cache->GetFootprints();
+    auto                    it = footprints.find( aFootprintName );
+
+    if( it == footprints.end() )
+        return false;
+
+    aSummary = it->second->GetSummary();
+    return true;
+}
+
+
 bool PCB_IO_KICAD_SEXPR::FootprintExists( const wxString& aLibraryPath, const wxString& aFootprintName,
                                   const std::map<std::string, UTF8>* aProperties )
 {
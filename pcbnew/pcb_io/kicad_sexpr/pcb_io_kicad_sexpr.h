@@ -30,6 +30,7 @@
 #include <ctl_flags.h>
 
 #include <richio.h>
+#include <memory>
 #include <string>
 #include <layer_ids.h>
 #include <lset.h>
@@ -39,6 +40,7 @@
 
 class BOARD;
 class BOARD_ITEM;
+class BOARD_FILL_CACHE;
 class FP_CACHE;
 class LSET;
 class PCB_IO_KICAD_SEXPR_PARSER;
@@ -207,13 +209,35 @@ class FP_CACHE_ITEM
 {
     WX_FILENAME                m_filename;
     std::unique_ptr<FOOTPRINT> m_footprint;
+    FOOTPRINT_SUMMARY          m_summary;
+    bool                       m_parseFailed;
 
 public:
     FP_CACHE_ITEM( FOOTPRINT* aFootprint, const WX_FILENAME& aFileName );
 
+    /**
+     * An item known from the library index, which is parsed when first needed.
+     */
+    FP_CACHE_ITEM( const WX_FILENAME& aFileName, const FOOTPRINT_SUMMARY& aSummary );
+
     const WX_FILENAME& GetFileName() const { return m_filename; }
     void SetFilePath( const wxString& aFilePath ) { m_filename.SetPath( aFilePath ); }
-    std::unique_ptr<FOOTPRINT>& GetFootprint() { return m_footprint; }
+
+    /**
+     * @return the footprint, parsing its file on the first call for items of the library
+     *         index.  It is null if the file cannot be parsed anymore.
+     *
+     * @param aResolveFonts false when called from a worker thread: the fonts of the parsed
+     *                      footprint are then left to PCB_IO_KICAD_SEXPR_PARSER::ResolveFonts().
+     */
+    std::unique_ptr<FOOTPRINT>& GetFootprint( bool aResolveFonts = true );
+
+    /**
+     * @return true if the footprint is in memory, i.e. it was parsed or given to the cache.
+     */
+    bool IsLoaded() const { return m_footprint != nullptr; }
+
+    const FOOTPRINT_SUMMARY& GetSummary() const { return m_summary; }
 };
 
 typedef boost::ptr_map<wxString, FP_CACHE_ITEM> FP_CACHE_FOOTPRINT_MAP;
@@ -229,6 +253,7 @@ class FP_CACHE
                                  // m_cache_timestamp against all the files.
     long long m_cache_timestamp; // A hash of the timestamps for all the footprint
                                  // files.
+    bool m_parallel;             // Parse and save the footprints on the thread pool.
 
 public:
     FP_CACHE( PCB_IO_KICAD_SEXPR* aOwner, const wxString& aLibraryPath );
@@ -241,6 +266,12 @@ public:
 
     FP_CACHE_FOOTPRINT_MAP& GetFootprints() { return m_footprints; }
 
+    /**
+     * Parse and save the footprints on the thread pool.  Off by default: libraries are also
+     * loaded from tasks of the thread pool, which must not wait for other tasks.
+     */
+    void SetParallel( bool aParallel ) { m_parallel = aParallel; }
+
     // Most all functions in this class throw IO_ERROR exceptions.  There are no
     // error codes nor user interface calls from here, nor in any PLUGIN.
     // Catch these exceptions higher up please.
@@ -248,12 +279,33 @@ public:
     /**
      * Save the footprint cache or a single footprint from it to disk
      *
+     * Saving the full library parses all its footprints first, saving a single footprint does
+     * not parse the others.  In parallel mode, the files of large libraries are formatted and
+     * written on the thread pool.  Their contents do not depend on the number of threads.
+     *
      * @param aFootprintFilter if set, save only this footprint, otherwise, save the full library
      */
     void Save( FOOTPRINT* aFootprintFilter = nullptr );
 
+    /**
+     * Read the library.
+     *
+     * The summary of each footprint is kept in an index in the user cache directory, with the
+     * timestamp and size of its file.  Only the files which changed since the last time are
+     * parsed here (on the thread pool in parallel mode), the others are parsed when their
+     * footprint is first needed.
+     */
     void Load();
 
+    /**
+     * Parse all the footprints of the library not parsed yet, on the thread pool in parallel
+     * mode.
+     *
+     * Footprints which cannot be parsed anymore are left null, as with
+     * FP_CACHE_ITEM::GetFootprint().
+     */
+    void ParseFootprints();
+
     void Remove( const wxString& aFootprintName );
 
     /**
@@ -327,7 +379,8 @@ public:
                       const std::map<std::string, UTF8>* aProperties = nullptr, PROJECT* aProject = nullptr ) override;
 
     BOARD* DoLoad( LINE_READER& aReader, BOARD* aAppendToMe, const std::map<std::string, UTF8>* aProperties,
-                     PROGRESS_REPORTER* aProgressReporter, unsigned aLineCount );
+                     PROGRESS_REPORTER* aProgressReporter, unsigned aLineCount,
+                     const BOARD_FILL_CACHE* aFillCache = nullptr );
 
     void FootprintEnumerate( wxArrayString& aFootprintNames, const wxString& aLibraryPath,
                              bool aBestEfforts, const std::map<std::string, UTF8>* aProperties = nullptr ) override;
@@ -336,6 +389,10 @@ public:
                                              const wxString& aFootprintName,
                                              const std::map<std::string, UTF8>* aProperties = nullptr ) override;
 
+    bool GetFootprintSummary( const wxString& aLibraryPath, const wxString& aFootprintName,
+                              FOOTPRINT_SUMMARY& aSummary,
+                              const std::map<std::string, UTF8>* aProperties = nullptr ) override;
+
     bool FootprintExists( const wxString& aLibraryPath, const wxString& aFootprintName,
                           const std::map<std::string, UTF8>* aProperties = nullptr ) override;
 
@@ -386,6 +443,12 @@ public:
 
     void SetOutputFormatter( OUTPUTFORMATTER* aFormatter ) { m_out = aFormatter; }
 
+    /**
+     * Format the items of boards with at least \a aMinItems of them on the thread pool, even
+     * if it has a single thread.  Used by QA; 0 restores the default.
+     */
+    void SetParallelSaveMinItems( size_t aMinItems ) { m_parallelSaveMinItems = aMinItems; }
+
     BOARD_ITEM* Parse( const wxString& aClipboardSourceInput );
 
 protected:
@@ -417,8 +480,20 @@ protected:
     void formatTeardropParameters( const TEARDROP_PARAMETERS& tdParams ) const;
 
 private:
+    /**
+     * Create a plugin formatting items of the board being saved by \a aParent to \a aOut, for
+     * the worker threads of formatItemsInParallel().
+     */
+    PCB_IO_KICAD_SEXPR( const PCB_IO_KICAD_SEXPR& aParent, OUTPUTFORMATTER* aOut );
+
     void format( const BOARD* aBoard ) const;
 
+    /**
+     * Format \a aItems in chunks, in parallel, and write the chunks to m_out in order.  The
+     * output is the same as formatting the items one after the other.
+     */
+    void formatItemsInParallel( const std::vector<BOARD_ITEM*>& aItems ) const;
+
     void format( const PCB_DIMENSION_BASE* aDimension ) const;
 
     void format( const PCB_REFERENCE_IMAGE* aBitmap ) const;
@@ -468,8 +543,11 @@ protected:
     STRING_FORMATTER       m_sf;
     OUTPUTFORMATTER*       m_out;        ///< output any Format()s to this, no ownership
     int                    m_ctl;
-    NETINFO_MAPPING*       m_mapping;    ///< mapping for net codes, so only not empty net codes
-                                         ///< are stored with consecutive integers as net codes
+    std::shared_ptr<NETINFO_MAPPING> m_mapping;  ///< mapping for net codes, so only not empty
+                                                ///< net codes are stored with consecutive
+                                                ///< integers as net codes
+
+    size_t                 m_parallelSaveMinItems;  ///< 0 for the default threshold
 
     std::function<bool( wxString aTitle, int aIcon, wxString aMsg, wxString aAction )> m_queryUserCallback;
 };
@@ -0,0 +1,363 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr_fill_cache.h>
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <set>
+#include <vector>
+
+#include <board.h>
+#include <footprint.h>
+#include <zone.h>
+#include <kiid.h>
+#include <mmh3_hash.h>
+#include <geometry/shape_line_chain.h>
+#include <geometry/shape_poly_set.h>
+#include <kiplatform/io.h>
+
+#include <wx/ffile.h>
+#include <wx/filefn.h>
+
+
+namespace
+{
+
+const char     CACHE_MAGIC[8] = { 'K', 'I', 'F', 'I', 'L', 'L', '0', '1' };
+const uint32_t CACHE_BYTE_ORDER = 0x01020304;
+
+struct CACHE_HEADER
+{
+    char     m_magic[8];
+    uint32_t m_byteOrder;
+    uint32_t m_zoneCount;
+    uint64_t m_hash[2];
+};
+
+struct CACHE_ZONE_ENTRY
+{
+    char     m_uuid[40];        ///< KIID::AsStdString(), zero padded
+    uint64_t m_offset;          ///< of the zone fills, from the start of the file
+};
+
+static_assert( sizeof( CACHE_HEADER ) == 32, "unexpected padding in the fill cache header" );
+static_assert( sizeof( CACHE_ZONE_ENTRY ) == 48, "unexpected padding in the fill cache entries" );
+
+
+template <typename T>
+void append( std::vector<char>& aBuffer, const T& aValue )
+{
+    const char* data = reinterpret_cast<const char*>( &aValue );
+    aBuffer.insert( aBuffer.end(), data, data + sizeof( T ) );
+}
+
+
+template <typename T>
+bool read( const char*& aData, const char* aEnd, T& aValue )
+{
+    if( static_cast<size_t>( aEnd - aData ) < sizeof( T ) )
+        return false;
+
+    memcpy( &aValue, aData, sizeof( T ) );
+    aData += sizeof( T );
+    return true;
+}
+
+
+bool isCacheable( const ZONE* aZone )
+{
+    bool hasFills = false;
+
+    for( PCB_LAYER_ID layer : aZone->GetLayerSet().Seq() )
+    {
+        const std::shared_ptr<SHAPE_POLY_SET>& fill = aZone->GetFilledPolysList( layer );
+
+        for( int ii = 0; ii < fill->OutlineCount(); ++ii )
+        {
+            if( fill->COutline( ii ).ArcCount() )
+                return false;
+
+            hasFills = true;
+        }
+    }
+
+    return hasFills;
+}
+
+} // namespace
+
+
+bool BOARD_FILL_CACHE::ZONE_FILLS::ReadNext( SHAPE_LINE_CHAIN& aChain )
+{
+    uint32_t pointCount = 0;
+
+    if( m_remaining == 0 || !read( m_data, m_end, pointCount ) )
+        return false;
+
+    if( pointCount > static_cast<size_t>( m_end - m_data ) / ( 2 * sizeof( int32_t ) ) )
+    {
+        m_remaining = 0;
+        return false;
+    }
+
+    for( uint32_t ii = 0; ii < pointCount; ++ii )
+    {
+        int32_t xy[2];
+
+        memcpy( xy, m_data, sizeof( xy ) );
+        m_data += sizeof( xy );
+
+        // Same as the parser, which drops repeated vertices
+        aChain.Append( xy[0], xy[1] );
+    }
+
+    --m_remaining;
+    return true;
+}
+
+
+BOARD_FILL_CACHE::~BOARD_FILL_CACHE()
+{
+    if( m_data )
+        KIPLATFORM::IO::UnmapFile( m_data, m_size, m_mapHandle );
+}
+
+
+wxString BOARD_FILL_CACHE::GetCachePath( const wxString& aBoardPath )
+{
+    return aBoardPath + wxS( ".cache" );
+}
+
+
+HASH_128 BOARD_FILL_CACHE::HashText( std::string_view aText )
+{
+    MMH3_HASH hash;
+
+    hash.addData( reinterpret_cast<const uint8_t*>( aText.data() ), aText.size() );
+    return hash.digest();
+}
+
+
+bool BOARD_FILL_CACHE::WriteForBoardFile( const wxString& aBoardPath, const BOARD& aBoard )
+{
+    wxString cachePath = GetCachePath( aBoardPath );
+
+    // Never leave a cache from a previous save behind, even if it would not validate
+    if( wxFileExists( cachePath ) )
+        wxRemoveFile( cachePath );
+
+    size_t      textSize = 0;
+    void*       textHandle = nullptr;
+    const char* text = KIPLATFORM::IO::MapFile( aBoardPath, textSize, textHandle );
+
+    if( !text )
+        return false;
+
+    HASH_128 boardHash = HashText( std::string_view( text, textSize ) );
+
+    KIPLATFORM::IO::UnmapFile( text, textSize, textHandle );
+
+    // Zones by UUID, for the sorted entry table.  Duplicated UUIDs cannot be told apart when
+    // loading, so these zones are left out.
+    std::map<std::string, const ZONE*> zones;
+    std::set<std::string>              duplicates;
+
+    auto addZone =
+            [&]( const ZONE* aZone )
+            {
+                std::string uuid = aZone->m_Uuid.AsStdString();
+
+                if( !zones.emplace( uuid, aZone ).second )
+                    duplicates.insert( uuid );
+            };
+
+    for( const ZONE* zone : aBoard.Zones() )
+        addZone( zone );
+
+    for( const FOOTPRINT* footprint : aBoard.Footprints() )
+    {
+        for( const ZONE* zone : footprint->Zones() )
+            addZone( zone );
+    }
+
+    for( const std::string& uuid : duplicates )
+        zones.erase( uuid );
+
+    std::erase_if( zones,
+                   []( const std::pair<const std::string, const ZONE*>& aEntry )
+                   {
+                       return !isCacheable( aEntry.second );
+                   } );
+
+    CACHE_HEADER header;
+
+    memcpy( header.m_magic, CACHE_MAGIC, sizeof( CACHE_MAGIC ) );
+    header.m_byteOrder = CACHE_BYTE_ORDER;
+    header.m_zoneCount = static_cast<uint32_t>( zones.size() );
+    header.m_hash[0] = boardHash.Value64[0];
+    header.m_hash[1] = boardHash.Value64[1];
+
+    std::vector<char> buffer;
+    size_t            entryOffset = sizeof( CACHE_HEADER );
+
+    append( buffer, header );
+    buffer.resize( entryOffset + zones.size() * sizeof( CACHE_ZONE_ENTRY ) );
+
+    for( const auto& [uuid, zone] : zones )
+    {
+        CACHE_ZONE_ENTRY entry = {};
+
+        memcpy( entry.m_uuid, uuid.data(), std::min( uuid.size(), sizeof( entry.m_uuid ) ) );
+        entry.m_offset = buffer.size();
+
+        memcpy( buffer.data() + entryOffset, &entry, sizeof( entry ) );
+        entryOffset += sizeof( entry );
+
+        uint32_t polygonCount = 0;
+
+        for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+            polygonCount += zone->GetFilledPolysList( layer )->OutlineCount();
+
+        append( buffer, polygonCount );
+
+        // The order in which PCB_IO_KICAD_SEXPR::format() writes the filled polygons
+        for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+        {
+            const std::shared_ptr<SHAPE_POLY_SET>& fill = zone->GetFilledPolysList( layer );
+
+            for( int ii = 0; ii < fill->OutlineCount(); ++ii )
+            {
+                const std::vector<VECTOR2I>& points = fill->COutline( ii ).CPoints();
+
+                append( buffer, static_cast<uint32_t>( points.size() ) );
+
+                for( const VECTOR2I& pt : points )
+                {
+                    append( buffer, static_cast<int32_t>( pt.x ) );
+                    append( buffer, static_cast<int32_t>( pt.y ) );
+                }
+            }
+        }
+    }
+
+    wxFFile file( cachePath, wxT( "wb" ) );
+
+    if( !file.IsOpened() || file.Write( buffer.data(), buffer.size() ) != buffer.size()
+            || !file.Close() )
+    {
+        file.Close();
+        wxRemoveFile( cachePath );
+        return false;
+    }
+
+    return true;
+}
+
+
+bool BOARD_FILL_CACHE::Open( const wxString& aBoardPath, const HASH_128& aBoardHash )
+{
+    wxCHECK( !m_data, false );
+
+    m_data = KIPLATFORM::IO::MapFile( GetCachePath( aBoardPath ), m_size, m_mapHandle );
+
+    if( !m_data )
+        return false;
+
+    const char*  cur = m_data;
+    CACHE_HEADER header;
+
+    bool valid = read( cur, m_data + m_size, header )
+                    && memcmp( header.m_magic, CACHE_MAGIC, sizeof( CACHE_MAGIC ) ) == 0
+                    && header.m_byteOrder == CACHE_BYTE_ORDER
+                    && header.m_hash[0] == aBoardHash.Value64[0]
+                    && header.m_hash[1] == aBoardHash.Value64[1]
+                    && header.m_zoneCount <= ( m_size - sizeof( CACHE_HEADER ) )
+                                                     / sizeof( CACHE_ZONE_ENTRY );
+
+    if( !valid )
+    {
+        KIPLATFORM::IO::UnmapFile( m_data, m_size, m_mapHandle );
+        m_data = nullptr;
+        m_size = 0;
+        m_mapHandle = nullptr;
+        return false;
+    }
+
+    m_zoneCount = header.m_zoneCount;
+    return true;
+}
+
+
+BOARD_FILL_CACHE::ZONE_FILLS BOARD_FILL_CACHE::Find( const KIID& aZone ) const
+{
+    ZONE_FILLS fills;
+
+    if( !m_data )
+        return fills;
+
+    char        key[sizeof( CACHE_ZONE_ENTRY::m_uuid )] = {};
+    std::string uuid = aZone.AsStdString();
+
+    memcpy( key, uuid.data(), std::min( uuid.size(), sizeof( key ) ) );
+
+    // Binary search in the sorted entry table
+    const char* entries = m_data + sizeof( CACHE_HEADER );
+    size_t      lo = 0;
+    size_t      hi = m_zoneCount;
+
+    while( lo < hi )
+    {
+        size_t           mid = lo + ( hi - lo ) / 2;
+        CACHE_ZONE_ENTRY entry;
+
+        memcpy( &entry, entries + mid * sizeof( CACHE_ZONE_ENTRY ), sizeof( entry ) );
+
+        int cmp = memcmp( entry.m_uuid, key, sizeof( key ) );
+
+        if( cmp < 0 )
+        {
+            lo = mid + 1;
+        }
+        else if( cmp > 0 )
+        {
+            hi = mid;
+        }
+        else
+        {
+            if( entry.m_offset >= m_size )
+                break;
+
+            fills.m_data = m_data + entry.m_offset;
+            fills.m_end = m_data + m_size;
+
+            if( !read( fills.m_data, fills.m_end, fills.m_remaining ) )
+                fills.m_remaining = 0;
+
+            break;
+        }
+    }
+
+    return fills;
+}
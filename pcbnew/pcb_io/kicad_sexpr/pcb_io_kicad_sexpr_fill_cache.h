@@ -0,0 +1,129 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef PCB_IO_KICAD_SEXPR_FILL_CACHE_H_
+#define PCB_IO_KICAD_SEXPR_FILL_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include <hash_128.h>
+#include <wx/string.h>
+
+class BOARD;
+class KIID;
+class SHAPE_LINE_CHAIN;
+
+
+/**
+ * A binary copy of the zone fills of a board file, kept next to it.
+ *
+ * Zone fills are most of the text of large boards, and the slowest part to parse.  When the
+ * cache is written after a save, the next load takes the fill vertices from it and only skips
+ * over their text.  The cache holds the hash of the board file it was written for, and is
+ * ignored if the board file was changed since.
+ *
+ * The file is mapped in memory and read in place.  It holds, in native byte order:
+ *  - a header: magic, byte order marker, zone count and board file hash;
+ *  - the zone entries, sorted by UUID, each with the offset of its fills;
+ *  - for each zone, the number of filled polygons then, for each of them in file order, the
+ *    number of vertices and their coordinates.
+ *
+ * Zones with arcs in their fills are not cached.
+ */
+class BOARD_FILL_CACHE
+{
+public:
+    /**
+     * The filled polygons of a zone, read in the order they appear in the board file.
+     */
+    class ZONE_FILLS
+    {
+    public:
+        ZONE_FILLS() = default;
+
+        /**
+         * Append the vertices of the next filled polygon to \a aChain.
+         *
+         * @return false if there are no more polygons, or the cache is truncated.
+         */
+        bool ReadNext( SHAPE_LINE_CHAIN& aChain );
+
+    private:
+        friend class BOARD_FILL_CACHE;
+
+        const char* m_data = nullptr;
+        const char* m_end = nullptr;
+        uint32_t    m_remaining = 0;
+    };
+
+    BOARD_FILL_CACHE() = default;
+
+    ~BOARD_FILL_CACHE();
+
+    BOARD_FILL_CACHE( const BOARD_FILL_CACHE& ) = delete;
+    BOARD_FILL_CACHE& operator=( const BOARD_FILL_CACHE& ) = delete;
+
+    /**
+     * @return the path of the cache of a board file.
+     */
+    static wxString GetCachePath( const wxString& aBoardPath );
+
+    /**
+     * @return the hash identifying the text of a board file.
+     */
+    static HASH_128 HashText( std::string_view aText );
+
+    /**
+     * Write the cache of a board file, from the board it was just saved from.
+     *
+     * @return false if the board file cannot be read or the cache cannot be written.  A stale
+     *         cache is removed in that case.
+     */
+    static bool WriteForBoardFile( const wxString& aBoardPath, const BOARD& aBoard );
+
+    /**
+     * Map the cache of a board file.
+     *
+     * @param aBoardPath is the board file.
+     * @param aBoardHash is the HashText() of its content.
+     * @return false if there is no valid cache for this content.
+     */
+    bool Open( const wxString& aBoardPath, const HASH_128& aBoardHash );
+
+    bool IsOpen() const { return m_data != nullptr; }
+
+    /**
+     * @return the fills of zone \a aZone, which are empty if it is not cached.
+     */
+    ZONE_FILLS Find( const KIID& aZone ) const;
+
+private:
+    const char* m_data = nullptr;
+    size_t      m_size = 0;
+    void*       m_mapHandle = nullptr;
+    uint32_t    m_zoneCount = 0;
+};
+
+#endif // PCB_IO_KICAD_SEXPR_FILL_CACHE_H_
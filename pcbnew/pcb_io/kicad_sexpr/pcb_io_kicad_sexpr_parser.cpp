@@ -27,8 +27,13 @@
  * @brief Pcbnew s-expression file format parser implementation.
  */
 
+#include <algorithm>
 #include <cerrno>
 #include <charconv>
+#include <future>
+#include <optional>
+#include <set>
+#include <string_view>
 #include <confirm.h>
 #include <macros.h>
 #include <fmt/format.h>
@@ -63,10 +68,12 @@
 #include <locale_io.h>
 #include <zones.h>
 #include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr_parser.h>
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr_fill_cache.h>
 #include <convert_basic_shapes_to_polygon.h>    // for RECT_CHAMFER_POSITIONS definition
 #include <math/util.h>                           // KiROUND, Clamp
 #include <string_utils.h>
 #include <stroke_params_parser.h>
+#include <thread_pool.h>
 #include <wx/log.h>
 #include <progress_reporter.h>
 #include <board_stackup_manager/stackup_predefined_prms.h>
@@ -194,29 +201,25 @@ void PCB_IO_KICAD_SEXPR_PARSER::pushValueIntoMap( int aIndex, int aValue )
 
 int PCB_IO_KICAD_SEXPR_PARSER::parseBoardUnits()
 {
-    // There should be no major rounding issues here, since the values in
-    // the file are in mm and get converted to nano-meters.
+    // The values in the file are in mm with at most 6 decimals, and get converted to
+    // nanometres exactly with integer arithmetic.  Other forms go through a double; there
+    // should be no major rounding issues there either.
     // See test program tools/test-nm-biu-to-ascii-mm-round-tripping.cpp
     // to confirm or experiment.  Use a similar strategy in both places, here
     // and in the test program. Make that program with:
     // $ make test-nm-biu-to-ascii-mm-round-tripping
-    auto retval = parseDouble() * pcbIUScale.IU_PER_MM;
-
+    //
     // N.B. we currently represent board units as integers.  Any values that are
     // larger or smaller than those board units represent undefined behavior for
     // the system.  We limit values to the largest that is visible on the screen
-    return KiROUND( std::clamp( retval, -INT_LIMIT, INT_LIMIT ) );
+    return parseScaledInt( pcbIUScale.IU_PER_MM, INT_LIMIT );
 }
 
 
 int PCB_IO_KICAD_SEXPR_PARSER::parseBoardUnits( const char* aExpected )
 {
-    auto retval = parseDouble( aExpected ) * pcbIUScale.IU_PER_MM;
-
-    // N.B. we currently represent board units as integers.  Any values that are
-    // larger or smaller than those board units represent undefined behavior for
-    // the system.  We limit values to the largest that is visible on the screen
-    return KiROUND( std::clamp( retval, -INT_LIMIT, INT_LIMIT ) );
+    NeedNUMBER( aExpected );
+    return parseBoardUnits();
 }
 
 
@@ -868,18 +871,25 @@ BOARD_ITEM* PCB_IO_KICAD_SEXPR_PARSER::Parse()
         THROW_PARSE_ERROR( err, CurSource(), CurLine(), CurLineNumber(), CurOffset() );
     }
 
-    const std::vector<wxString>* embeddedFonts = item->GetEmbeddedFiles()->UpdateFontFiles();
+    if( !m_isWorker )
+        ResolveFonts( item );
+
+    resolveGroups( item );
 
-    item->RunOnDescendants(
+    return item;
+}
+
+
+void PCB_IO_KICAD_SEXPR_PARSER::ResolveFonts( BOARD_ITEM* aItem )
+{
+    const std::vector<wxString>* embeddedFonts = aItem->GetEmbeddedFiles()->UpdateFontFiles();
+
+    aItem->RunOnDescendants(
             [&]( BOARD_ITEM* aChild )
             {
                 if( EDA_TEXT* textItem = dynamic_cast<EDA_TEXT*>( aChild ) )
                     textItem->ResolveFont( embeddedFonts );
             } );
-
-    resolveGroups( item );
-
-    return item;
 }
 
 
@@ -899,6 +909,278 @@ BOARD* PCB_IO_KICAD_SEXPR_PARSER::parseBOARD()
 }
 
 
+/// Older files may need fix-ups of the whole board while their items are parsed
+static constexpr int PARALLEL_LOAD_MIN_VERSION = 20230517;
+
+/// Items are parsed in chunks of at least this size, to keep the per thread work worth it
+static constexpr size_t PARALLEL_LOAD_MIN_CHUNK = 256 * 1024;
+
+
+/// A list found at the top level of a board by scanBoardText()
+struct BOARD_TEXT_LIST
+{
+    std::string_view m_keyword;
+    std::string_view m_text;
+};
+
+
+static bool isSexprSep( char aChar )
+{
+    // Same separators as DSNLEXER
+    switch( aChar )
+    {
+    case ' ':
+    case '\n':
+    case '\r':
+    case '\t':
+    case '\0':
+    case '(':
+    case ')':
+    case '|':
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+
+/**
+ * Find the lists at the top level of a board file, without tokenizing them.
+ *
+ * Quoted strings and comment lines are skipped the way DSNLEXER does, so that the parentheses
+ * they hold are not counted.
+ *
+ * @return false if the text is not a single (kicad_pcb ...) list or is malformed; the parser
+ *         will tell what is wrong.
+ */
+static bool scanBoardText( std::string_view aText, std::vector<BOARD_TEXT_LIST>& aLists )
+{
+    const char* const end = aText.data() + aText.size();
+    const char*       cur = aText.data();
+    const char*       listStart = nullptr;
+    bool              lineStart = true;
+    bool              rootDone = false;
+    int               depth = 0;
+
+    auto keywordAt =
+            [&]( const char* aListStart )
+            {
+                const char* first = aListStart + 1;
+
+                while( first < end && isSexprSep( *first ) && *first != '(' && *first != ')' )
+                    ++first;
+
+                const char* last = first;
+
+                while( last < end && !isSexprSep( *last ) )
+                    ++last;
+
+                return std::string_view( first, last - first );
+            };
+
+    while( cur < end )
+    {
+        if( lineStart )
+        {
+            lineStart = false;
+
+            const char* first = cur;
+
+            while( first < end && ( *first == ' ' || *first == '\t' || *first == '\r' ) )
+                ++first;
+
+            // Comments are lines starting with '#'
+            if( first < end && *first == '#' )
+            {
+                cur = std::find( first, end, '\n' );
+                continue;
+            }
+        }
+
+        switch( *cur )
+        {
+        case '\n':
+            lineStart = true;
+            ++cur;
+            break;
+
+        case '(':
+            if( rootDone )
+                return false;
+
+            if( depth == 0 && keywordAt( cur ) != "kicad_pcb" )
+                return false;
+
+            if( depth == 1 )
+                listStart = cur;
+
+            ++depth;
+            ++cur;
+            break;
+
+        case ')':
+            if( --depth < 0 )
+                return false;
+
+            ++cur;
+
+            if( depth == 1 )
+            {
+                std::string_view text( listStart, cur - listStart );
+                aLists.push_back( { keywordAt( listStart ), text } );
+            }
+            else if( depth == 0 )
+                rootDone = true;
+
+            break;
+
+        case '"':
+            if( depth == 0 )
+                return false;
+
+            // Strings cannot span lines
+            for( ++cur; cur < end && *cur != '"'; ++cur )
+            {
+                if( *cur == '\\' )
+                    ++cur;
+
+                if( cur >= end || *cur == '\n' )
+                    return false;
+            }
+
+            if( cur >= end )
+                return false;
+
+            ++cur;
+            break;
+
+        default:
+            if( isSexprSep( *cur ) )
+            {
+                ++cur;
+                break;
+            }
+
+            if( depth == 0 )
+                return false;
+
+            while( cur < end && !isSexprSep( *cur ) )
+                ++cur;
+
+            break;
+        }
+    }
+
+    return rootDone;
+}
+
+
+static bool isBoardItemKeyword( std::string_view aKeyword )
+{
+    // The items parseBoardItem() knows about
+    static const std::set<std::string_view> itemKeywords = {
+        "gr_arc", "gr_curve", "gr_line", "gr_poly", "gr_circle", "gr_rect", "image", "gr_text",
+        "gr_text_box", "table", "dimension", "module", "footprint", "segment", "arc", "via",
+        "zone", "target"
+    };
+
+    return itemKeywords.count( aKeyword ) > 0;
+}
+
+
+BOARD* PCB_IO_KICAD_SEXPR_PARSER::ParseBoardInParallel( std::string_view aText,
+        const wxString& aSource,
+        std::function<bool( wxString, int, wxString, wxString )> aQueryUserCallback,
+        PROGRESS_REPORTER* aProgressReporter, const BOARD_FILL_CACHE* aFillCache )
+{
+    std::vector<BOARD_TEXT_LIST> lists;
+
+    if( !scanBoardText( aText, lists ) || lists.empty() || lists[0].m_keyword != "version" )
+        return nullptr;
+
+    const char* versionText = lists[0].m_keyword.data() + lists[0].m_keyword.size();
+    const char* versionEnd = lists[0].m_text.data() + lists[0].m_text.size();
+    int         version = 0;
+
+    while( versionText < versionEnd && isSexprSep( *versionText ) && *versionText != ')' )
+        ++versionText;
+
+    std::from_chars( versionText, versionEnd, version );
+
+    if( version < PARALLEL_LOAD_MIN_VERSION )
+        return nullptr;
+
+    size_t itemBytes = 0;
+
+    for( const BOARD_TEXT_LIST& list : lists )
+    {
+        if( isBoardItemKeyword( list.m_keyword ) )
+            itemBytes += list.m_text.size();
+    }
+
+    thread_pool& tp = GetKiCadThreadPool();
+
+    if( tp.get_thread_count() < 2 || itemBytes < 2 * PARALLEL_LOAD_MIN_CHUNK )
+        return nullptr;
+
+    // A few chunks per thread, so that a slow one (large zone fills) does not hold the others
+    size_t chunkSize = std::max( PARALLEL_LOAD_MIN_CHUNK,
+                                 itemBytes / ( 4 * tp.get_thread_count() ) );
+
+    std::string              context( "(kicad_pcb" );
+    std::vector<std::string> chunks;
+
+    for( const BOARD_TEXT_LIST& list : lists )
+    {
+        if( isBoardItemKeyword( list.m_keyword ) )
+        {
+            if( chunks.empty() || chunks.back().size() >= chunkSize )
+            {
+                chunks.emplace_back();
+                chunks.back().reserve( chunkSize + list.m_text.size() );
+            }
+
+            chunks.back().append( list.m_text ).append( "\n" );
+        }
+        else
+        {
+            context.append( "\n" ).append( list.m_text );
+        }
+    }
+
+    context.append( "\n)\n" );
+
+    unsigned lineCount = 0;
+
+    if( aProgressReporter )
+        lineCount = static_cast<unsigned>( std::count( aText.begin(), aText.end(), '\n' ) );
+
+    STRING_LINE_READER        reader( context, aSource );
+    PCB_IO_KICAD_SEXPR_PARSER parser( &reader, nullptr, std::move( aQueryUserCallback ),
+                                      aProgressReporter, lineCount );
+
+    parser.m_parallelChunks = std::move( chunks );
+    parser.m_fillCache = aFillCache;
+
+    try
+    {
+        return dynamic_cast<BOARD*>( parser.Parse() );
+    }
+    catch( const PARSE_ERROR& )
+    {
+        // Let the serial parser report it, with the right line number
+        delete parser.m_board;
+        return nullptr;
+    }
+    catch( ... )
+    {
+        delete parser.m_board;
+        throw;
+    }
+}
+
+
 BOARD* PCB_IO_KICAD_SEXPR_PARSER::parseBOARD_unchecked()
 {
     T token;
@@ -1005,56 +1287,19 @@ BOARD* PCB_IO_KICAD_SEXPR_PARSER::parseBOARD_unchecked()
         case T_gr_poly:
         case T_gr_circle:
         case T_gr_rect:
-            item = parsePCB_SHAPE( m_board );
-            m_board->Add( item, ADD_MODE::BULK_APPEND, true );
-            bulkAddedItems.push_back( item );
-            break;
-
         case T_image:
-            item = parsePCB_REFERENCE_IMAGE( m_board );
-            m_board->Add( item, ADD_MODE::BULK_APPEND, true );
-            bulkAddedItems.push_back( item );
-            break;
-
         case T_gr_text:
-            item = parsePCB_TEXT( m_board );
-            m_board->Add( item, ADD_MODE::BULK_APPEND, true );
-            bulkAddedItems.push_back( item );
-            break;
-
         case T_gr_text_box:
-            item = parsePCB_TEXTBOX( m_board );
-            m_board->Add( item, ADD_MODE::BULK_APPEND, true );
-            bulkAddedItems.push_back( item );
-            break;
-
         case T_table:
-            item = parsePCB_TABLE( m_board );
-            m_board->Add( item, ADD_MODE::BULK_APPEND, true );
-            bulkAddedItems.push_back( item );
-            break;
-
         case T_dimension:
-            item = parseDIMENSION( m_board );
-            m_board->Add( item, ADD_MODE::BULK_APPEND, true );
-            bulkAddedItems.push_back( item );
-            break;
-
         case T_module:      // legacy token
         case T_footprint:
-            item = parseFOOTPRINT();
-            m_board->Add( item, ADD_MODE::BULK_APPEND, true );
-            bulkAddedItems.push_back( item );
-            break;
-
         case T_segment:
-            item = parsePCB_TRACK();
-            m_board->Add( item, ADD_MODE::BULK_APPEND, true );
-            bulkAddedItems.push_back( item );
-            break;
-
         case T_arc:
-            item = parseARC();
+        case T_via:
+        case T_zone:
+        case T_target:
+            item = parseBoardItem( token );
             m_board->Add( item, ADD_MODE::BULK_APPEND, true );
             bulkAddedItems.push_back( item );
             break;
@@ -1067,24 +1312,6 @@ BOARD* PCB_IO_KICAD_SEXPR_PARSER::parseBOARD_unchecked()
             parseGENERATOR( m_board );
             break;
 
-        case T_via:
-            item = parsePCB_VIA();
-            m_board->Add( item, ADD_MODE::BULK_APPEND, true );
-            bulkAddedItems.push_back( item );
-            break;
-
-        case T_zone:
-            item = parseZONE( m_board );
-            m_board->Add( item, ADD_MODE::BULK_APPEND, true );
-            bulkAddedItems.push_back( item );
-            break;
-
-        case T_target:
-            item = parsePCB_TARGET();
-            m_board->Add( item, ADD_MODE::BULK_APPEND, true );
-            bulkAddedItems.push_back( item );
-            break;
-
         case T_embedded_fonts:
         {
             m_board->GetEmbeddedFiles()->SetAreFontsEmbedded( parseBool() );
@@ -1117,6 +1344,9 @@ BOARD* PCB_IO_KICAD_SEXPR_PARSER::parseBOARD_unchecked()
         }
     }
 
+    if( !m_parallelChunks.empty() )
+        parseItemsInParallel( bulkAddedItems );
+
     if( bulkAddedItems.size() > 0 )
         m_board->FinalizeBulkAdd( bulkAddedItems );
 
@@ -1242,6 +1472,179 @@ BOARD* PCB_IO_KICAD_SEXPR_PARSER::parseBOARD_unchecked()
 }
 
 
+BOARD_ITEM* PCB_IO_KICAD_SEXPR_PARSER::parseBoardItem( T aToken )
+{
+    switch( aToken )
+    {
+    case T_gr_arc:
+    case T_gr_curve:
+    case T_gr_line:
+    case T_gr_poly:
+    case T_gr_circle:
+    case T_gr_rect:     return parsePCB_SHAPE( m_board );
+    case T_image:       return parsePCB_REFERENCE_IMAGE( m_board );
+    case T_gr_text:     return parsePCB_TEXT( m_board );
+    case T_gr_text_box: return parsePCB_TEXTBOX( m_board );
+    case T_table:       return parsePCB_TABLE( m_board );
+    case T_dimension:   return parseDIMENSION( m_board );
+    case T_module:      // legacy token
+    case T_footprint:   return parseFOOTPRINT();
+    case T_segment:     return parsePCB_TRACK();
+    case T_arc:         return parseARC();
+    case T_via:         return parsePCB_VIA();
+    case T_zone:        return parseZONE( m_board );
+    case T_target:      return parsePCB_TARGET();
+
+    default:
+        wxString err;
+        err.Printf( _( "Unknown token '%s'" ), FromUTF8() );
+        THROW_PARSE_ERROR( err, CurSource(), CurLine(), CurLineNumber(), CurOffset() );
+    }
+}
+
+
+void PCB_IO_KICAD_SEXPR_PARSER::parseBoardItems( std::vector<BOARD_ITEM*>& aItems )
+{
+    for( T token = NextTok(); token != T_EOF; token = NextTok() )
+    {
+        if( token != T_LEFT )
+            Expecting( T_LEFT );
+
+        aItems.push_back( parseBoardItem( NextTok() ) );
+    }
+}
+
+
+void PCB_IO_KICAD_SEXPR_PARSER::parseItemsInParallel( std::vector<BOARD_ITEM*>& aBulkAddedItems )
+{
+    const size_t chunkCount = m_parallelChunks.size();
+
+    std::vector<std::unique_ptr<STRING_LINE_READER>>        readers( chunkCount );
+    std::vector<std::unique_ptr<PCB_IO_KICAD_SEXPR_PARSER>> workers( chunkCount );
+    std::vector<std::vector<BOARD_ITEM*>>                   chunkItems( chunkCount );
+    std::vector<unsigned>                                   chunkLines( chunkCount );
+    std::vector<std::future<void>>                          returns;
+    std::atomic<bool>                                       cancelled( false );
+
+    returns.reserve( chunkCount );
+
+    for( size_t ii = 0; ii < chunkCount; ++ii )
+    {
+        const std::string& chunk = m_parallelChunks[ii];
+
+        chunkLines[ii] = static_cast<unsigned>( std::count( chunk.begin(), chunk.end(), '\n' ) );
+
+        readers[ii] = std::make_unique<STRING_LINE_READER>( chunk, CurSource() );
+        workers[ii] = std::make_unique<PCB_IO_KICAD_SEXPR_PARSER>( readers[ii].get(), nullptr,
+                                                                   nullptr );
+
+        PCB_IO_KICAD_SEXPR_PARSER* worker = workers[ii].get();
+
+        worker->m_board = m_board;
+        worker->m_isWorker = true;
+        worker->m_layerIndices = m_layerIndices;
+        worker->m_layerMasks = m_layerMasks;
+        worker->m_netCodes = m_netCodes;
+        worker->m_tooRecent = m_tooRecent;
+        worker->m_requiredVersion = m_requiredVersion;
+        worker->m_generatorVersion = m_generatorVersion;
+        worker->m_fillCache = m_fillCache;
+
+        // The reader has its own copy
+        std::string().swap( m_parallelChunks[ii] );
+    }
+
+    m_parallelChunks.clear();
+
+    thread_pool& tp = GetKiCadThreadPool();
+
+    for( size_t ii = 0; ii < chunkCount; ++ii )
+    {
+        returns.emplace_back( tp.submit(
+                [&, ii]()
+                {
+                    if( !cancelled )
+                        workers[ii]->parseBoardItems( chunkItems[ii] );
+                } ) );
+    }
+
+    unsigned doneLines = reader->LineNumber();
+
+    for( size_t ii = 0; ii < chunkCount; ++ii )
+    {
+        while( returns[ii].wait_for( std::chrono::milliseconds( 250 ) )
+                != std::future_status::ready )
+        {
+            if( m_progressReporter )
+            {
+                m_progressReporter->SetCurrentProgress( (double) doneLines
+                                                        / std::max( 1U, m_lineCount ) );
+
+                if( !m_progressReporter->KeepRefreshing() )
+                    cancelled = true;
+            }
+        }
+
+        doneLines += chunkLines[ii];
+    }
+
+    auto deleteItems =
+            [&]()
+            {
+                for( std::vector<BOARD_ITEM*>& items : chunkItems )
+                {
+                    for( BOARD_ITEM* item : items )
+                        delete item;
+                }
+            };
+
+    // Rethrow the first error, once no worker uses the items anymore
+    for( std::future<void>& ret : returns )
+    {
+        try
+        {
+            ret.get();
+        }
+        catch( ... )
+        {
+            deleteItems();
+            throw;
+        }
+    }
+
+    if( cancelled )
+    {
+        deleteItems();
+        THROW_IO_ERROR( _( "Open cancelled by user." ) );
+    }
+
+    // Attach the items, and merge what the workers have learned, in file order
+    for( size_t ii = 0; ii < chunkCount; ++ii )
+    {
+        PCB_IO_KICAD_SEXPR_PARSER* worker = workers[ii].get();
+
+        for( BOARD_ITEM* item : chunkItems[ii] )
+        {
+            m_board->Add( item, ADD_MODE::BULK_APPEND, true );
+            aBulkAddedItems.push_back( item );
+        }
+
+        for( const auto& [zone, netName] : worker->m_deferredZoneNets )
+            fixupZoneNet( zone, netName );
+
+        for( const auto& [footprint, classNames] : worker->m_deferredComponentClasses )
+            footprint->ResolveComponentClassNames( m_board, classNames );
+
+        m_undefinedLayers.insert( worker->m_undefinedLayers.begin(),
+                                  worker->m_undefinedLayers.end() );
+
+        // Footprint groups; board groups are in the main parser's text
+        std::move( worker->m_groupInfos.begin(), worker->m_groupInfos.end(),
+                   std::back_inserter( m_groupInfos ) );
+    }
+}
+
+
 void PCB_IO_KICAD_SEXPR_PARSER::resolveGroups( BOARD_ITEM* aParent )
 {
     auto getItem =
@@ -4881,7 +5284,11 @@ FOOTPRINT* PCB_IO_KICAD_SEXPR_PARSER::parseFOOTPRINT_unchecked( wxArrayString* a
 
             footprint->SetTransientComponentClassNames( componentClassNames );
 
-            if( m_board )
+            // The component class manager is not thread safe: worker parsers leave the
+            // resolution to the main one.
+            if( m_isWorker )
+                m_deferredComponentClasses.emplace_back( footprint.get(), componentClassNames );
+            else if( m_board )
                 footprint->ResolveComponentClassNames( m_board, componentClassNames );
 
             break;
@@ -6618,6 +7025,9 @@ ZONE* PCB_IO_KICAD_SEXPR_PARSER::parseZONE( BOARD_ITEM_CONTAINER* aParent )
     std::map<PCB_LAYER_ID, std::vector<SEG>> legacySegs;
     PCB_LAYER_ID filledLayer;
     bool         addedFilledPolygons = false;
+
+    // Looked up at the first filled polygon, once the zone UUID is known
+    std::optional<BOARD_FILL_CACHE::ZONE_FILLS> cachedFills;
     bool         isStrokedFill = true;
 
     std::unique_ptr<ZONE> zone = std::make_unique<ZONE>( aParent );
@@ -7098,8 +7508,18 @@ ZONE* PCB_IO_KICAD_SEXPR_PARSER::parseZONE( BOARD_ITEM_CONTAINER* aParent )
                 if( island )
                     zone->SetIsIsland( filledLayer, idx );
 
-                for( token = NextTok();  token != T_RIGHT;  token = NextTok() )
-                    parseOutlinePoints( chain );
+                if( m_fillCache && !cachedFills )
+                    cachedFills = m_fillCache->Find( zone->m_Uuid );
+
+                if( cachedFills && cachedFills->ReadNext( chain ) )
+                {
+                    SkipList();
+                }
+                else
+                {
+                    for( token = NextTok();  token != T_RIGHT;  token = NextTok() )
+                        parseOutlinePoints( chain );
+                }
 
                 NeedRIGHT();
 
@@ -7289,27 +7709,12 @@ ZONE* PCB_IO_KICAD_SEXPR_PARSER::parseZONE( BOARD_ITEM_CONTAINER* aParent )
     if( zone_has_net
         && ( !zone->GetNet() || zone->GetNet()->GetNetname() != netnameFromfile ) )
     {
-        // Can happens which old boards, with nonexistent nets ...
-        // or after being edited by hand
-        // We try to fix the mismatch.
-        NETINFO_ITEM* net = m_board->FindNet( netnameFromfile );
-
-        if( net )   // An existing net has the same net name. use it for the zone
-        {
-            zone->SetNetCode( net->GetNetCode() );
-        }
-        else    // Not existing net: add a new net to keep trace of the zone netname
-        {
-            int newnetcode = m_board->GetNetCount();
-            net = new NETINFO_ITEM( m_board, netnameFromfile, newnetcode );
-            m_board->Add( net, ADD_MODE::INSERT, true );
-
-            // Store the new code mapping
-            pushValueIntoMap( newnetcode, net->GetNetCode() );
-
-            // and update the zone netcode
-            zone->SetNetCode( net->GetNetCode() );
-        }
+        // Worker parsers cannot add nets to the board: the main parser does it once they are
+        // done.
+        if( m_isWorker )
+            m_deferredZoneNets.emplace_back( zone.get(), netnameFromfile );
+        else
+            fixupZoneNet( zone.get(), netnameFromfile );
     }
 
     if( zone->IsTeardropArea() && m_requiredVersion < 20230517 )
@@ -7322,6 +7727,32 @@ ZONE* PCB_IO_KICAD_SEXPR_PARSER::parseZONE( BOARD_ITEM_CONTAINER* aParent )
 }
 
 
+void PCB_IO_KICAD_SEXPR_PARSER::fixupZoneNet( ZONE* aZone, const wxString& aNetName )
+{
+    // Can happens which old boards, with nonexistent nets ...
+    // or after being edited by hand
+    // We try to fix the mismatch.
+    NETINFO_ITEM* net = m_board->FindNet( aNetName );
+
+    if( net )   // An existing net has the same net name. use it for the zone
+    {
+        aZone->SetNetCode( net->GetNetCode() );
+    }
+    else    // Not existing net: add a new net to keep trace of the zone netname
+    {
+        int newnetcode = m_board->GetNetCount();
+        net = new NETINFO_ITEM( m_board, aNetName, newnetcode );
+        m_board->Add( net, ADD_MODE::INSERT, true );
+
+        // Store the new code mapping
+        pushValueIntoMap( newnetcode, net->GetNetCode() );
+
+        // and update the zone netcode
+        aZone->SetNetCode( net->GetNetCode() );
+    }
+}
+
+
 PCB_TARGET* PCB_IO_KICAD_SEXPR_PARSER::parsePCB_TARGET()
 {
     wxCHECK_MSG( CurTok() == T_target, nullptr,
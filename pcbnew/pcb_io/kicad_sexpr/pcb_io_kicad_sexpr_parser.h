@@ -40,7 +40,9 @@
 #include <string_any_map.h>
 
 #include <chrono>
+#include <string_view>
 #include <unordered_map>
+#include <unordered_set>
 
 
 class PCB_ARC;
@@ -67,6 +69,7 @@ class SHAPE_LINE_CHAIN;
 struct LAYER;
 class PROGRESS_REPORTER;
 class TEARDROP_PARAMETERS;
+class BOARD_FILL_CACHE;
 
 
 /**
@@ -99,6 +102,44 @@ public:
 
     BOARD_ITEM* Parse();
 
+    /**
+     * Parse a board file held in memory, spreading the parsing of its footprints, zones,
+     * tracks and graphic items over the threads of the KiCad thread pool.
+     *
+     * A structural scan first finds the top level lists of the file.  The sections describing
+     * the board (layers, setup, nets, groups...) are then parsed on the calling thread, and the
+     * items in chunks by worker parsers sharing these settings.  The items are added to the
+     * board in file order once they are all parsed.
+     *
+     * @return the new board, or nullptr if the file is better parsed serially: too small, in a
+     *         format needing legacy fix-ups which depend on file order, or holding a parse
+     *         error (which Parse() then reports with its line number).
+     */
+    static BOARD* ParseBoardInParallel( std::string_view aText, const wxString& aSource,
+            std::function<bool( wxString, int, wxString, wxString )> aQueryUserCallback,
+            PROGRESS_REPORTER* aProgressReporter = nullptr,
+            const BOARD_FILL_CACHE* aFillCache = nullptr );
+
+    /**
+     * Take the zone fills from \a aFillCache instead of parsing them, when it holds them.
+     *
+     * The cache must be valid for the text being parsed, and outlive the parser.
+     */
+    void SetFillCache( const BOARD_FILL_CACHE* aFillCache ) { m_fillCache = aFillCache; }
+
+    /**
+     * Mark the parser as running on a worker thread.  Parse() then leaves the fonts of the
+     * texts unresolved, as loading them is not thread-safe: the caller must pass the parsed
+     * item to ResolveFonts() on the main thread.
+     */
+    void SetWorker( bool aWorker ) { m_isWorker = aWorker; }
+
+    /**
+     * Resolve the fonts of the texts of \a aItem and of its descendants, loading outline fonts
+     * as needed.  Must be called on the main thread.
+     */
+    static void ResolveFonts( BOARD_ITEM* aItem );
+
     /**
      * @param aInitialComments may be a pointer to a heap allocated initial comment block
      *                         or NULL.  If not NULL, then caller has given ownership of a
@@ -212,6 +253,12 @@ private:
     void parseNETINFO_ITEM();
     void parseNETCLASS();
 
+    /**
+     * Fix a copper zone whose net name does not match its net code, adding a net for
+     * \a aNetName if the board has none.
+     */
+    void fixupZoneNet( ZONE* aZone, const wxString& aNetName );
+
     void parseTEARDROP_PARAMETERS( TEARDROP_PARAMETERS* tdParams );
 
     void parseTextBoxContent( PCB_TEXTBOX* aTextBox );
@@ -248,6 +295,15 @@ private:
     // Parse a board, but do not replace PARSE_ERROR with FUTURE_FORMAT_ERROR automatically.
     BOARD*      parseBOARD_unchecked();
 
+    // Parse one of the items which can be found at the top level of a board.
+    BOARD_ITEM* parseBoardItem( PCB_KEYS_T::T aToken );
+
+    // Parse a list of top level board items, up to the end of the input.
+    void        parseBoardItems( std::vector<BOARD_ITEM*>& aItems );
+
+    // Parse m_parallelChunks with worker parsers and add their items to the board.
+    void        parseItemsInParallel( std::vector<BOARD_ITEM*>& aBulkAddedItems );
+
     /**
      * Parse the current token for the layer definition of a #BOARD_ITEM object.
      *
@@ -425,6 +481,22 @@ private:
     std::vector<GROUP_INFO>     m_groupInfos;
     std::vector<GENERATOR_INFO> m_generatorInfos;
 
+    ///< Top level items left out of the text by ParseBoardInParallel(), in file order
+    std::vector<std::string>    m_parallelChunks;
+
+    ///< true for parsers running on worker threads, which must not modify the board nor load
+    ///< fonts
+    bool                        m_isWorker = false;
+
+    ///< optional; zone fills of the text being parsed, may be nullptr
+    const BOARD_FILL_CACHE*     m_fillCache = nullptr;
+
+    ///< Zone net fix-ups left by a worker parser to the main one
+    std::vector<std::pair<ZONE*, wxString>> m_deferredZoneNets;
+
+    ///< Footprint component classes left by a worker parser to the main one
+    std::vector<std::pair<FOOTPRINT*, std::unordered_set<wxString>>> m_deferredComponentClasses;
+
     std::function<bool( wxString aTitle, int aIcon, wxString aMsg, wxString aAction )> m_queryUserCallback;
 };
 
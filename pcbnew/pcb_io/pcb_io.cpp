@@ -26,6 +26,7 @@
 #include <pcb_io/pcb_io.h>
 #include <pcb_io/pcb_io_mgr.h>
 #include <ki_exception.h>
+#include <footprint.h>
 #include <wx/log.h>
 #include <wx/filename.h>
 #include <wx/translation.h>
@@ -39,6 +40,15 @@
                                       wxString::FromUTF8( aCaller ) ) );
 
 
+FOOTPRINT_SUMMARY::FOOTPRINT_SUMMARY( const FOOTPRINT& aFootprint ) :
+        m_Description( aFootprint.GetLibDescription() ),
+        m_Keywords( aFootprint.GetKeywords() ),
+        m_PadCount( aFootprint.GetPadCount( DO_NOT_INCLUDE_NPTH ) ),
+        m_UniquePadCount( aFootprint.GetUniquePadCount( DO_NOT_INCLUDE_NPTH ) )
+{
+}
+
+
 bool PCB_IO::CanReadBoard( const wxString& aFileName ) const
 {
     const std::vector<std::string>& exts = GetBoardFileDesc().m_FileExtensions;
@@ -133,6 +143,22 @@ const FOOTPRINT* PCB_IO::GetEnumeratedFootprint( const wxString& aLibraryPath,
 }
 
 
+bool PCB_IO::GetFootprintSummary( const wxString& aLibraryPath, const wxString& aFootprintName,
+                                  FOOTPRINT_SUMMARY& aSummary,
+                                  const std::map<std::string, UTF8>* aProperties )
+{
+    // default implementation
+    const FOOTPRINT* footprint = GetEnumeratedFootprint( aLibraryPath, aFootprintName,
+                                                         aProperties );
+
+    if( !footprint )
+        return false;
+
+    aSummary = FOOTPRINT_SUMMARY( *footprint );
+    return true;
+}
+
+
 bool PCB_IO::FootprintExists( const wxString& aLibraryPath, const wxString& aFootprintName,
                               const std::map<std::string, UTF8>* aProperties )
 {
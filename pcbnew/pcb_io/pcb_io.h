@@ -39,6 +39,23 @@ class FOOTPRINT;
 class PROJECT;
 class PROGRESS_REPORTER;
 
+
+/**
+ * What the footprint browsers show of a library footprint.
+ */
+struct FOOTPRINT_SUMMARY
+{
+    FOOTPRINT_SUMMARY() = default;
+
+    explicit FOOTPRINT_SUMMARY( const FOOTPRINT& aFootprint );
+
+    wxString m_Description;
+    wxString m_Keywords;
+    unsigned m_PadCount = 0;             ///< not counting NPTH pads
+    unsigned m_UniquePadCount = 0;       ///< not counting NPTH pads
+};
+
+
 /**
  * A base class that #BOARD loading and saving plugins should derive from.
  *
@@ -238,6 +255,18 @@ public:
                                                      const wxString& aFootprintName,
                                                      const std::map<std::string, UTF8>* aProperties = nullptr );
 
+    /**
+     * Fetch the #FOOTPRINT_SUMMARY of a footprint, after FootprintEnumerate().
+     *
+     * Plugins keeping an index of their libraries return it without loading the footprint.
+     *
+     * @return false if the footprint cannot be found or loaded.
+     */
+    virtual bool GetFootprintSummary( const wxString& aLibraryPath,
+                                      const wxString& aFootprintName,
+                                      FOOTPRINT_SUMMARY& aSummary,
+                                      const std::map<std::string, UTF8>* aProperties = nullptr );
+
     /**
      * Check for the existence of a footprint.
      */
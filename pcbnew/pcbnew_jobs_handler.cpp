@@ -41,6 +41,7 @@
 #include <jobs/job_export_pcb_3d.h>
 #include <jobs/job_pcb_render.h>
 #include <jobs/job_pcb_drc.h>
+#include <jobs/job_pcb_route.h>
 #include <lset.h>
 #include <cli/exit_codes.h>
 #include <exporters/place_file_exporter.h>
@@ -74,6 +75,10 @@
 #include <project_pcb.h>
 #include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr.h>
 #include <reporter.h>
+#include <router/pns_autorouter.h>
+#include <router/pns_kicad_iface.h>
+#include <router/pns_routing_settings.h>
+#include <ratsnest/ratsnest_data.h>
 #include <wildcards_and_files_ext.h>
 #include <export_vrml.h>
 #include <wx/wfstream.h>
@@ -236,6 +241,11 @@ PCBNEW_JOBS_HANDLER::PCBNEW_JOBS_HANDLER( KIWAY* aKiway ) :
               {
                   return true;
               } );
+    Register( "route", std::bind( &PCBNEW_JOBS_HANDLER::JobRoute, this, std::placeholders::_1 ),
+              []( JOB* job, wxWindow* aParent ) -> bool
+              {
+                  return true;
+              } );
     Register( "drc", std::bind( &PCBNEW_JOBS_HANDLER::JobExportDrc, this, std::placeholders::_1 ),
               []( JOB* job, wxWindow* aParent ) -> bool
               {
@@ -1577,9 +1587,14 @@ int PCBNEW_JOBS_HANDLER::JobExportFpUpgrade( JOB* aJob )
         PCB_IO_KICAD_SEXPR pcb_io( CTL_FOR_LIBRARY );
         FP_CACHE           fpLib( &pcb_io, upgradeJob->m_libraryPath );
 
+        // The footprint files are independent: parse and save them on the thread pool.  All the
+        // reporting is done from this thread, in library order.
+        fpLib.SetParallel( true );
+
         try
         {
             fpLib.Load();
+            fpLib.ParseFootprints();
         }
         catch( ... )
         {
@@ -1591,15 +1606,17 @@ int PCBNEW_JOBS_HANDLER::JobExportFpUpgrade( JOB* aJob )
 
         for( const auto& footprint : fpLib.GetFootprints() )
         {
-            if( footprint.second->GetFootprint()->GetFileFormatVersionAtLoad()
-                < SEXPR_BOARD_FILE_VERSION )
-            {
+            const std::unique_ptr<FOOTPRINT>& fp = footprint.second->GetFootprint();
+
+            if( fp && fp->GetFileFormatVersionAtLoad() < SEXPR_BOARD_FILE_VERSION )
                 shouldSave = true;
-            }
         }
 
         if( shouldSave )
         {
+            m_reporter->Report( _( "Saving footprint library in updated format\n" ),
+                                RPT_SEVERITY_ACTION );
+
             try
             {
                 if( !upgradeJob->m_outputLibraryPath.IsEmpty() )
@@ -1668,6 +1685,9 @@ int PCBNEW_JOBS_HANDLER::JobExportFpSvg( JOB* aJob )
     {
         const std::unique_ptr<FOOTPRINT>& fp = it->second->GetFootprint();
 
+        if( !fp )
+            continue;
+
         if( !svgJob->m_footprint.IsEmpty() )
         {
             if( fp->GetFPID().GetLibItemName().wx_str() != svgJob->m_footprint )
@@ -1958,6 +1978,117 @@ int PCBNEW_JOBS_HANDLER::JobExportDrc( JOB* aJob )
 }
 
 
+int PCBNEW_JOBS_HANDLER::JobRoute( JOB* aJob )
+{
+    JOB_PCB_ROUTE* routeJob = dynamic_cast<JOB_PCB_ROUTE*>( aJob );
+
+    if( routeJob == nullptr )
+        return CLI::EXIT_CODES::ERR_UNKNOWN;
+
+    BOARD* brd = getBoard( routeJob->m_filename );
+
+    if( !brd )
+        return CLI::EXIT_CODES::ERR_INVALID_INPUT_FILE;
+
+    aJob->SetTitleBlock( brd->GetTitleBlock() );
+    brd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
+    brd->SynchronizeProperties();
+
+    // Route in place unless told otherwise
+    if( routeJob->GetConfiguredOutputPath().IsEmpty() )
+        routeJob->SetWorkingOutputPath( wxFileName( brd->GetFileName() ).GetFullName() );
+
+    wxString outPath = routeJob->GetFullOutputPath( brd->GetProject() );
+
+    if( !PATHS::EnsurePathExists( outPath, true ) )
+    {
+        m_reporter->Report( _( "Failed to create output directory\n" ), RPT_SEVERITY_ERROR );
+        return CLI::EXIT_CODES::ERR_INVALID_OUTPUT_CONFLICT;
+    }
+
+    brd->BuildConnectivity();
+
+    std::shared_ptr<CONNECTIVITY_DATA> connectivity = brd->GetConnectivity();
+
+    // The interface must outlive the router
+    PNS_KICAD_IFACE_BATCH iface;
+    PNS::ROUTER           router;
+    PNS::ROUTING_SETTINGS settings( nullptr, "" );
+
+    iface.SetBoard( brd );
+    router.SetInterface( &iface );
+    router.ClearWorld();
+    router.SyncWorld();
+
+    settings.SetMode( PNS::RM_Walkaround );
+    router.LoadSettings( &settings );
+    router.SetMode( PNS::PNS_MODE_ROUTE_SINGLE );
+
+    PNS::AUTOROUTER autorouter( &router );
+
+    auto addNet =
+            [&]( NETINFO_ITEM* aNet )
+            {
+                if( RN_NET* rnNet = connectivity->GetRatsnestForNet( aNet->GetNetCode() ) )
+                    autorouter.AddRatsnest( rnNet );
+            };
+
+    if( routeJob->m_nets.empty() )
+    {
+        for( NETINFO_ITEM* net : brd->GetNetInfo() )
+        {
+            if( net->GetNetCode() > 0 )
+                addNet( net );
+        }
+    }
+    else
+    {
+        for( const wxString& netName : routeJob->m_nets )
+        {
+            if( NETINFO_ITEM* net = brd->FindNet( netName ) )
+            {
+                addNet( net );
+            }
+            else
+            {
+                m_reporter->Report( wxString::Format( _( "Net '%s' not found\n" ), netName ),
+                                    RPT_SEVERITY_WARNING );
+            }
+        }
+    }
+
+    int total = static_cast<int>( autorouter.Connections().size() );
+    int failed = autorouter.Run( routeJob->m_shoveRetries );
+
+    m_reporter->Report( wxString::Format( _( "Routed %d of %d connections\n" ),
+                                          total - failed, total ),
+                        RPT_SEVERITY_INFO );
+
+    try
+    {
+        IO_RELEASER<PCB_IO> pi( PCB_IO_MGR::PluginFind( PCB_IO_MGR::KICAD_SEXP ) );
+        pi->SaveBoard( outPath, brd, nullptr );
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        m_reporter->Report( wxString::Format( _( "Error saving board file '%s'.\n%s" ),
+                                              outPath,
+                                              ioe.What() ),
+                            RPT_SEVERITY_ERROR );
+
+        return CLI::EXIT_CODES::ERR_UNKNOWN;
+    }
+
+    m_reporter->Report( wxString::Format( _( "Saved board to %s\n" ), outPath ),
+                        RPT_SEVERITY_ACTION );
+
+    if( routeJob->m_exitCodeUnrouted && failed > 0 )
+        return CLI::EXIT_CODES::ERR_UNROUTED;
+
+    return CLI::EXIT_CODES::SUCCESS;
+}
+
+
 int PCBNEW_JOBS_HANDLER::JobExportIpc2581( JOB* aJob )
 {
     JOB_EXPORT_PCB_IPC2581* job = dynamic_cast<JOB_EXPORT_PCB_IPC2581*>( aJob );
@@ -48,6 +48,7 @@ public:
     int JobExportFpUpgrade( JOB* aJob );
     int JobExportFpSvg( JOB* aJob );
     int JobExportDrc( JOB* aJob );
+    int JobRoute( JOB* aJob );
     int JobExportIpc2581( JOB* aJob );
     int JobExportOdb( JOB* aJob );
 
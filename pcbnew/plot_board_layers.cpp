@@ -45,6 +45,7 @@
 #include <pcb_painter.h>
 #include <gbr_metadata.h>
 #include <advanced_config.h>
+#include <thread_pool.h>
 
 /*
  * Plot a solder mask layer.  Solder mask layers have a minimum thickness value and cannot be
@@ -1061,8 +1062,8 @@ void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
 
     // Combine the current areas to initial areas. This is mandatory because inflate/deflate
     // transform is not perfect, and we want the initial areas perfectly kept
-    areas.BooleanAdd( initialPolys );
-    areas.Fracture();
+    areas.BooleanAdd( initialPolys, GetKiCadThreadPool() );
+    areas.Fracture( GetKiCadThreadPool() );
 
     itemplotter.PlotZone( &zone, layer, areas );
 }
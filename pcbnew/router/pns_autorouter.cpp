@@ -0,0 +1,168 @@
+/*
+ * KiRouter - a push-and-(sometimes-)shove PCB router
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+
+#include <ratsnest/ratsnest_data.h>
+#include <settings/json_settings_internals.h>
+
+#include "pns_autorouter.h"
+#include "pns_node.h"
+#include "pns_placement_algo.h"
+#include "pns_router.h"
+#include "pns_routing_settings.h"
+#include "pns_sizes_settings.h"
+
+namespace PNS {
+
+
+AUTOROUTER::AUTOROUTER( ROUTER* aRouter ) :
+        m_router( aRouter )
+{
+}
+
+
+void AUTOROUTER::AddConnection( const BOARD_ITEM* aStartParent, const VECTOR2I& aStart,
+                                const BOARD_ITEM* aEndParent, const VECTOR2I& aEnd )
+{
+    m_connections.push_back( { aStartParent, aStart, aEndParent, aEnd } );
+}
+
+
+void AUTOROUTER::AddRatsnest( RN_NET* aNet, const std::set<BOARD_CONNECTED_ITEM*>* aItems )
+{
+    for( const CN_EDGE& edge : aNet->GetEdges() )
+    {
+        std::shared_ptr<const CN_ANCHOR> source = edge.GetSourceNode();
+        std::shared_ptr<const CN_ANCHOR> target = edge.GetTargetNode();
+
+        if( !source || source->Dirty() || !source->Valid()
+                || !target || target->Dirty() || !target->Valid() )
+        {
+            continue;
+        }
+
+        if( aItems && !aItems->count( source->Parent() ) && !aItems->count( target->Parent() ) )
+            continue;
+
+        AddConnection( source->Parent(), source->Pos(), target->Parent(), target->Pos() );
+    }
+}
+
+
+bool AUTOROUTER::routeConnection( const CONNECTION& aConnection )
+{
+    NODE* world = m_router->GetWorld();
+    ITEM* startItem = world->FindItemByParent( aConnection.m_startParent );
+    ITEM* endItem = world->FindItemByParent( aConnection.m_endParent );
+
+    // Zones and other anchors which have no counterpart in the router's world cannot be
+    // routed to.
+    if( !startItem || !endItem )
+        return false;
+
+    // Without vias, the route has to stay on a layer both ends are on
+    if( !startItem->Layers().Overlaps( endItem->Layers() ) )
+        return false;
+
+    int layer = startItem->Layers().Intersection( endItem->Layers() ).Start();
+
+    SIZES_SETTINGS sizes( m_router->Sizes() );
+    m_router->GetInterface()->ImportSizes( sizes, startItem, nullptr, aConnection.m_start );
+    m_router->UpdateSizes( sizes );
+
+    if( !m_router->StartRouting( aConnection.m_start, startItem, layer ) )
+        return false;
+
+    // Same approach as ROUTER::Finish(): keep moving towards the target until the head
+    // settles, then only fix the route if it actually got there.
+    PLACEMENT_ALGO* placer = m_router->Placer();
+    VECTOR2I        lastEnd;
+    int             triesLeft = 5;
+
+    do
+    {
+        lastEnd = placer->CurrentEnd();
+        m_router->Move( aConnection.m_end, endItem );
+    } while( placer->CurrentEnd() != lastEnd && --triesLeft );
+
+    bool routed = false;
+
+    if( placer->CurrentEnd() == aConnection.m_end
+            && endItem->Layers().Overlaps( m_router->GetCurrentLayer() ) )
+    {
+        routed = m_router->FixRoute( aConnection.m_end, endItem, false, false );
+    }
+
+    m_router->StopRouting();
+    return routed;
+}
+
+
+int AUTOROUTER::Run( int aShoveRetries,
+                     const std::function<void( const CONNECTION& )>& aOnRouted )
+{
+    // Shortest connections first: they have the fewest alternatives and block the least.
+    std::stable_sort( m_connections.begin(), m_connections.end(),
+                      []( const CONNECTION& aA, const CONNECTION& aB )
+                      {
+                          return ( aA.m_end - aA.m_start ).SquaredEuclideanNorm()
+                                 < ( aB.m_end - aB.m_start ).SquaredEuclideanNorm();
+                      } );
+
+    // Route with a copy of the settings: the mode changes below must not end up in the
+    // user's settings.
+    ROUTING_SETTINGS& userSettings = m_router->Settings();
+    ROUTING_SETTINGS  settings( nullptr, "" );
+
+    userSettings.Store();
+    settings.Internals()->CloneFrom( *userSettings.Internals() );
+    settings.Load();
+    m_router->LoadSettings( &settings );
+
+    int failed = static_cast<int>( m_connections.size() );
+
+    for( int pass = 0; pass <= aShoveRetries && failed > 0; pass++ )
+    {
+        // The retries shove whatever is in the way; nothing routed so far is ripped up.
+        if( pass > 0 )
+            settings.SetMode( RM_Shove );
+
+        failed = 0;
+
+        for( CONNECTION& connection : m_connections )
+        {
+            if( connection.m_routed )
+                continue;
+
+            connection.m_routed = routeConnection( connection );
+
+            if( !connection.m_routed )
+                failed++;
+            else if( aOnRouted )
+                aOnRouted( connection );
+        }
+    }
+
+    m_router->LoadSettings( &userSettings );
+
+    return failed;
+}
+
+}
@@ -0,0 +1,94 @@
+/*
+ * KiRouter - a push-and-(sometimes-)shove PCB router
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __PNS_AUTOROUTER_H
+#define __PNS_AUTOROUTER_H
+
+#include <functional>
+#include <set>
+#include <vector>
+
+#include <math/vector2d.h>
+
+class BOARD_ITEM;
+class BOARD_CONNECTED_ITEM;
+class RN_NET;
+
+namespace PNS {
+
+class ROUTER;
+
+/**
+ * Routes a batch of point-to-point connections (typically ratsnest edges) without any user
+ * interaction, using an already synchronized ROUTER.
+ *
+ * Connections are attempted shortest first, in walkaround mode.  Those which cannot be
+ * completed are then retried in shove mode, so that the tracks routed so far can be pushed
+ * aside to make way for them.  Nothing is ever ripped up and rerouted: a connection which
+ * cannot be shoved through stays unrouted.  The user's routing settings are left untouched.
+ *
+ * No vias are placed: connections whose ends share no copper layer, or which end on an item
+ * the router does not know about (such as a zone), are reported as unrouted.
+ */
+class AUTOROUTER
+{
+public:
+    struct CONNECTION
+    {
+        const BOARD_ITEM* m_startParent;
+        VECTOR2I          m_start;
+        const BOARD_ITEM* m_endParent;
+        VECTOR2I          m_end;
+        bool              m_routed = false;
+    };
+
+    AUTOROUTER( ROUTER* aRouter );
+
+    void AddConnection( const BOARD_ITEM* aStartParent, const VECTOR2I& aStart,
+                        const BOARD_ITEM* aEndParent, const VECTOR2I& aEnd );
+
+    /**
+     * Add the unrouted ratsnest edges of \a aNet.  If \a aItems is given, only the edges with
+     * at least one end on one of these items are added.
+     */
+    void AddRatsnest( RN_NET* aNet, const std::set<BOARD_CONNECTED_ITEM*>* aItems = nullptr );
+
+    /**
+     * Route all the connections added so far.
+     *
+     * @param aShoveRetries is the number of shove mode passes made over the connections which
+     *                      the first (walkaround) pass could not route.
+     * @param aOnRouted is called after each connection has been routed and committed.
+     * @return the number of connections that could not be routed.
+     */
+    int Run( int aShoveRetries = 2,
+             const std::function<void( const CONNECTION& )>& aOnRouted = nullptr );
+
+    const std::vector<CONNECTION>& Connections() const { return m_connections; }
+
+private:
+    bool routeConnection( const CONNECTION& aConnection );
+
+    ROUTER*                 m_router;
+    std::vector<CONNECTION> m_connections;
+};
+
+}
+
+#endif
@@ -19,6 +19,7 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <cmath>
@@ -338,17 +339,24 @@ void DP_GATEWAYS::BuildOrthoProjections( DP_GATEWAYS& aEntries, const VECTOR2I&
 }
 
 
-bool DP_GATEWAYS::FitGateways( DP_GATEWAYS& aEntry, DP_GATEWAYS& aTarget, bool aPrefDiagonal,
-                               DIFF_PAIR& aDp )
+bool DP_GATEWAYS::FitGateways( const DP_GATEWAYS& aEntry, const DP_GATEWAYS& aTarget,
+                               bool aPrefDiagonal, DIFF_PAIR& aDp )
 {
-    DP_CANDIDATE best;
+    struct CANDIDATE
+    {
+        int score;
+        int index;
+        const DP_GATEWAY* entry;
+        const DP_GATEWAY* target;
+        bool preferred;
+    };
 
-    int bestScore = -1000;
-    bool found = false;
+    std::vector<CANDIDATE> candidates;
+    candidates.reserve( aEntry.CGateways().size() * aTarget.CGateways().size() * 2 );
 
-    for( const DP_GATEWAY& g_entry : aEntry.Gateways() )
+    for( const DP_GATEWAY& g_entry : aEntry.CGateways() )
     {
-        for( const DP_GATEWAY& g_target : aTarget.Gateways() )
+        for( const DP_GATEWAY& g_target : aTarget.CGateways() )
         {
             for( bool preferred : { false, true } )
             {
@@ -356,29 +364,34 @@ bool DP_GATEWAYS::FitGateways( DP_GATEWAYS& aEntry, DP_GATEWAYS& aTarget, bool a
                 score += g_entry.Priority();
                 score += g_target.Priority();
 
-                if( score >= bestScore )
-                {
-                    DIFF_PAIR l( m_gap );
-
-                    if( l.BuildInitial( g_entry, g_target, preferred ? aPrefDiagonal
-                                                                     : !aPrefDiagonal ) )
-                    {
-                        best.p = l.CP();
-                        best.n = l.CN();
-                        bestScore = score;
-                        found = true;
-                    }
-                }
+                candidates.push_back( { score, (int) candidates.size(), &g_entry, &g_target,
+                                        preferred } );
             }
         }
     }
 
+    // Building the initial traces is what costs, and only the best scoring candidate which
+    // can actually be built matters.  Try them best first (the later one wins between equal
+    // scores) and stop at the first that fits.
+    std::sort( candidates.begin(), candidates.end(),
+               []( const CANDIDATE& aA, const CANDIDATE& aB )
+               {
+                   if( aA.score != aB.score )
+                       return aA.score > aB.score;
+
+                   return aA.index > aB.index;
+               } );
 
-    if( found )
+    for( const CANDIDATE& c : candidates )
     {
-        aDp.SetGap( m_gap );
-        aDp.SetShape( best.p, best.n );
-        return true;
+        DIFF_PAIR l( m_gap );
+
+        if( l.BuildInitial( *c.entry, *c.target, c.preferred ? aPrefDiagonal : !aPrefDiagonal ) )
+        {
+            aDp.SetGap( m_gap );
+            aDp.SetShape( l.CP(), l.CN() );
+            return true;
+        }
     }
 
     return false;
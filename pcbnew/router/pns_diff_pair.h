@@ -197,8 +197,8 @@ public:
                        bool aViaMode = false );
     void BuildFromPrimitivePair( const DP_PRIMITIVE_PAIR& aPair, bool aPreferDiagonal );
 
-    bool FitGateways( DP_GATEWAYS& aEntry, DP_GATEWAYS& aTarget, bool aPrefDiagonal,
-                      DIFF_PAIR& aDp );
+    bool FitGateways( const DP_GATEWAYS& aEntry, const DP_GATEWAYS& aTarget,
+                      bool aPrefDiagonal, DIFF_PAIR& aDp );
 
     std::vector<DP_GATEWAY>& Gateways() { return m_gateways; }
 
@@ -19,6 +19,8 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <geometry/shape_segment.h>
+
 #include "pns_walkaround.h"
 #include "pns_shove.h"
 #include "pns_router.h"
@@ -655,6 +657,7 @@ void DIFF_PAIR_PLACER::initPlacement()
     m_orthoMode = false;
     m_currentEndItem = nullptr;
     m_startDiagonal = m_initialDiagonal;
+    m_gatewayCache.clear();
 
     NODE* world = Router()->GetWorld();
 
@@ -670,23 +673,88 @@ void DIFF_PAIR_PLACER::initPlacement()
 }
 
 
+bool DIFF_PAIR_PLACER::GATEWAY_CACHE_KEY::operator==( const GATEWAY_CACHE_KEY& aOther ) const
+{
+    return anchorP == aOther.anchorP && anchorN == aOther.anchorN
+            && kindP == aOther.kindP && kindN == aOther.kindN
+            && dirP == aOther.dirP && dirN == aOther.dirN
+            && shapeType == aOther.shapeType && shapeBBox == aOther.shapeBBox
+            && shapeSeg == aOther.shapeSeg && shapeWidth == aOther.shapeWidth
+            && gap == aOther.gap && diagonal == aOther.diagonal;
+}
+
+
+const DP_GATEWAYS& DIFF_PAIR_PLACER::pairGateways( const DP_PRIMITIVE_PAIR& aPair )
+{
+    const size_t maxCachedPairs = 4;
+
+    GATEWAY_CACHE_KEY key;
+    key.anchorP = aPair.AnchorP();
+    key.anchorN = aPair.AnchorN();
+    key.gap = gap();
+    key.diagonal = m_startDiagonal;
+
+    if( aPair.PrimP() && aPair.PrimN() )
+    {
+        key.kindP = aPair.PrimP()->Kind();
+        key.kindN = aPair.PrimN()->Kind();
+
+        if( aPair.Directional() )
+        {
+            key.dirP = aPair.DirP();
+            key.dirN = aPair.DirN();
+        }
+        else if( const SHAPE* shape = aPair.PrimP()->Shape( -1 ) )
+        {
+            key.shapeType = shape->Type();
+            key.shapeBBox = shape->BBox();
+
+            if( shape->Type() == SH_SEGMENT )
+            {
+                key.shapeSeg = static_cast<const SHAPE_SEGMENT*>( shape )->GetSeg();
+                key.shapeWidth = static_cast<const SHAPE_SEGMENT*>( shape )->GetWidth();
+            }
+        }
+    }
+
+    for( auto it = m_gatewayCache.begin(); it != m_gatewayCache.end(); ++it )
+    {
+        if( it->first == key )
+        {
+            m_gatewayCache.splice( m_gatewayCache.begin(), m_gatewayCache, it );
+            return m_gatewayCache.front().second;
+        }
+    }
+
+    DP_GATEWAYS gws( gap() );
+    gws.BuildFromPrimitivePair( aPair, m_startDiagonal );
+
+    if( m_gatewayCache.size() >= maxCachedPairs )
+        m_gatewayCache.pop_back();
+
+    m_gatewayCache.emplace( m_gatewayCache.begin(), key, std::move( gws ) );
+
+    return m_gatewayCache.front().second;
+}
+
+
 bool DIFF_PAIR_PLACER::routeHead( const VECTOR2I& aP )
 {
     m_fitOk = false;
 
-    DP_GATEWAYS gwsEntry( gap() );
-    DP_GATEWAYS gwsTarget( gap() );
+    DP_GATEWAYS gwsCursor( gap() );
+    const DP_GATEWAYS* gwsTarget = &gwsCursor;
 
     if( !m_prevPair )
         m_prevPair = m_start;
 
-    gwsEntry.BuildFromPrimitivePair( *m_prevPair, m_startDiagonal );
+    const DP_GATEWAYS& gwsEntry = pairGateways( *m_prevPair );
 
     DP_PRIMITIVE_PAIR target;
 
     if( FindDpPrimitivePair( m_currentNode, aP, m_currentEndItem, target ) )
     {
-        gwsTarget.BuildFromPrimitivePair( target, m_startDiagonal );
+        gwsTarget = &pairGateways( target );
         m_snapOnTarget = true;
     }
     else
@@ -705,19 +773,19 @@ bool DIFF_PAIR_PLACER::routeHead( const VECTOR2I& aP )
         // on the extension of the starting segment pair of the DP)
         int lead_dist = ( fpProj - fp ).EuclideanNorm();
 
-        gwsTarget.SetFitVias( m_placingVia, m_sizes.ViaDiameter(), viaGap() );
+        gwsCursor.SetFitVias( m_placingVia, m_sizes.ViaDiameter(), viaGap() );
 
         // far from the initial segment extension line -> allow a 45-degree obtuse turn
         if( lead_dist > ( m_sizes.DiffPairGap() + m_sizes.DiffPairWidth() ) / 2 )
         {
-            gwsTarget.BuildForCursor( fp );
+            gwsCursor.BuildForCursor( fp );
         }
         else
         {
             // close to the initial segment extension line -> keep straight part only, project
             // as close as possible to the cursor.
-            gwsTarget.BuildForCursor( fpProj );
-            gwsTarget.FilterByOrientation( DIRECTION_45::ANG_STRAIGHT | DIRECTION_45::ANG_HALF_FULL,
+            gwsCursor.BuildForCursor( fpProj );
+            gwsCursor.FilterByOrientation( DIRECTION_45::ANG_STRAIGHT | DIRECTION_45::ANG_HALF_FULL,
                                            DIRECTION_45( dirV ) );
         }
 
@@ -727,7 +795,7 @@ bool DIFF_PAIR_PLACER::routeHead( const VECTOR2I& aP )
     m_currentTrace.SetGap( gap() );
     m_currentTrace.SetLayer( m_currentLayer );
 
-    bool result = gwsEntry.FitGateways( gwsEntry, gwsTarget, m_startDiagonal, m_currentTrace );
+    bool result = gwsCursor.FitGateways( gwsEntry, *gwsTarget, m_startDiagonal, m_currentTrace );
 
     if( result )
     {
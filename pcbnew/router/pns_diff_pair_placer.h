@@ -23,6 +23,8 @@
 #ifndef __PNS_DIFF_PLACER_H
 #define __PNS_DIFF_PLACER_H
 
+#include <list>
+
 #include <math/vector2d.h>
 
 #include "pns_sizes_settings.h"
@@ -214,6 +216,30 @@ private:
                       bool aWindCw, bool aSolidsOnly );
     bool propagateDpHeadForces ( const VECTOR2I& aP, VECTOR2I& aNewP );
 
+    /**
+     * Everything DP_GATEWAYS::BuildFromPrimitivePair() depends on.  Geometry is stored rather
+     * than item pointers as the primitives usually live in branches which get discarded (and
+     * their memory reused) between head updates.
+     */
+    struct GATEWAY_CACHE_KEY
+    {
+        VECTOR2I     anchorP, anchorN;
+        int          kindP = 0, kindN = 0;
+        DIRECTION_45 dirP, dirN;
+        int          shapeType = -1;
+        BOX2I        shapeBBox;
+        SEG          shapeSeg;
+        int          shapeWidth = 0;
+        int          gap = 0;
+        bool         diagonal = false;
+
+        bool operator==( const GATEWAY_CACHE_KEY& aOther ) const;
+    };
+
+    ///< Return the gateways for a primitive pair, reusing the ones built for previous head
+    ///< updates when the pair hasn't changed.
+    const DP_GATEWAYS& pairGateways( const DP_PRIMITIVE_PAIR& aPair );
+
     enum State {
         RT_START = 0,
         RT_ROUTE = 1,
@@ -232,6 +258,10 @@ private:
     DP_PRIMITIVE_PAIR m_start;
     std::optional<DP_PRIMITIVE_PAIR> m_prevPair;
 
+    ///< Recently built primitive pair gateways, most recent first.  A list, so that handing
+    ///< out the target gateways doesn't invalidate the entry ones.
+    std::list<std::pair<GATEWAY_CACHE_KEY, DP_GATEWAYS>> m_gatewayCache;
+
     ///< current algorithm iteration
     int m_iteration;
 
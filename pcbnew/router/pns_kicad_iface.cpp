@@ -1735,25 +1735,7 @@ void PNS_KICAD_IFACE_BASE::SyncWorld( PNS::NODE *aWorld )
     }
 
     for( PCB_TRACK* t : m_board->Tracks() )
-    {
-        KICAD_T type = t->Type();
-
-        if( type == PCB_TRACE_T )
-        {
-            if( std::unique_ptr<PNS::SEGMENT> segment = syncTrack( t ) )
-                aWorld->Add( std::move( segment ), true );
-        }
-        else if( type == PCB_ARC_T )
-        {
-            if( std::unique_ptr<PNS::ARC> arc = syncArc( static_cast<PCB_ARC*>( t ) ) )
-                aWorld->Add( std::move( arc ), true );
-        }
-        else if( type == PCB_VIA_T )
-        {
-            if( std::unique_ptr<PNS::VIA> via = syncVia( static_cast<PCB_VIA*>( t ) ) )
-                aWorld->Add( std::move( via ) );
-        }
-    }
+        syncTrackItem( aWorld, t );
 
     // NB: if this were ever to become a long-lived object we would need to dirty its
     // clearance cache here....
@@ -1765,6 +1747,58 @@ void PNS_KICAD_IFACE_BASE::SyncWorld( PNS::NODE *aWorld )
 }
 
 
+void PNS_KICAD_IFACE_BASE::UpdateWorld( PNS::NODE* aWorld,
+                                        const std::set<const BOARD_ITEM*>& aRemoved,
+                                        const std::set<PCB_TRACK*>& aUpdated )
+{
+    std::set<const BOARD_ITEM*> staleParents( aRemoved );
+
+    staleParents.insert( aUpdated.begin(), aUpdated.end() );
+
+    m_world = aWorld;
+
+    aWorld->KillChildren();
+    aWorld->RemoveByParents( staleParents );
+
+    for( PCB_TRACK* t : aUpdated )
+        syncTrackItem( aWorld, t );
+
+    aWorld->FixupVirtualVias();
+
+    if( m_ruleResolver )
+    {
+        int worstClearance = m_board->GetMaxClearanceValue() + m_ruleResolver->ClearanceEpsilon();
+
+        if( worstClearance > aWorld->GetMaxClearance() )
+            aWorld->SetMaxClearance( worstClearance );
+
+        m_ruleResolver->ClearCaches();
+    }
+}
+
+
+void PNS_KICAD_IFACE_BASE::syncTrackItem( PNS::NODE* aWorld, PCB_TRACK* aTrack )
+{
+    KICAD_T type = aTrack->Type();
+
+    if( type == PCB_TRACE_T )
+    {
+        if( std::unique_ptr<PNS::SEGMENT> segment = syncTrack( aTrack ) )
+            aWorld->Add( std::move( segment ), true );
+    }
+    else if( type == PCB_ARC_T )
+    {
+        if( std::unique_ptr<PNS::ARC> arc = syncArc( static_cast<PCB_ARC*>( aTrack ) ) )
+            aWorld->Add( std::move( arc ), true );
+    }
+    else if( type == PCB_VIA_T )
+    {
+        if( std::unique_ptr<PNS::VIA> via = syncVia( static_cast<PCB_VIA*>( aTrack ) ) )
+            aWorld->Add( std::move( via ) );
+    }
+}
+
+
 void PNS_KICAD_IFACE::EraseView()
 {
     for( BOARD_ITEM* item : m_hiddenItems )
@@ -1775,7 +1809,9 @@ void PNS_KICAD_IFACE::EraseView()
     if( m_previewItems )
     {
         m_previewItems->FreeItems();
-        m_view->Update( m_previewItems );
+
+        if( m_view )
+            m_view->Update( m_previewItems );
     }
 
     if( m_debugDecorator )
@@ -1791,7 +1827,8 @@ void PNS_KICAD_IFACE_BASE::SetDebugDecorator( PNS::DEBUG_DECORATOR *aDec )
 
 void PNS_KICAD_IFACE::DisplayItem( const PNS::ITEM* aItem, int aClearance, bool aEdit, int aFlags )
 {
-    if( aItem->IsVirtual() )
+    // Nothing to preview on when routing without a view (e.g. QA)
+    if( !m_view || aItem->IsVirtual() )
         return;
 
     if( ZONE* zone = dynamic_cast<ZONE*>( aItem->Parent() ) )
@@ -1840,6 +1877,9 @@ void PNS_KICAD_IFACE::DisplayItem( const PNS::ITEM* aItem, int aClearance, bool
 
 void PNS_KICAD_IFACE::DisplayPathLine( const SHAPE_LINE_CHAIN& aLine, int aImportance )
 {
+    if( !m_view )
+        return;
+
     ROUTER_PREVIEW_ITEM* pitem = new ROUTER_PREVIEW_ITEM( aLine, this, m_view );
     pitem->SetDepth( pitem->GetOriginDepth() - ROUTER_PREVIEW_ITEM::PathOverlayDepth );
 
@@ -1859,6 +1899,9 @@ void PNS_KICAD_IFACE::DisplayPathLine( const SHAPE_LINE_CHAIN& aLine, int aImpor
 
 void PNS_KICAD_IFACE::DisplayRatline( const SHAPE_LINE_CHAIN& aRatline, PNS::NET_HANDLE aNet )
 {
+    if( !m_view )
+        return;
+
     ROUTER_PREVIEW_ITEM* pitem = new ROUTER_PREVIEW_ITEM( aRatline, this, m_view );
 
     KIGFX::RENDER_SETTINGS*     renderSettings = m_view->GetPainter()->GetSettings();
@@ -1907,7 +1950,7 @@ void PNS_KICAD_IFACE::HideItem( PNS::ITEM* aItem )
 {
     BOARD_ITEM* parent = aItem->Parent();
 
-    if( parent )
+    if( parent && m_view )
     {
         if( m_view->IsVisible( parent ) )
             m_hiddenItems.insert( parent );
@@ -1959,7 +2002,7 @@ void PNS_KICAD_IFACE_BASE::UpdateItem( PNS::ITEM* aItem )
 }
 
 
-void PNS_KICAD_IFACE::modifyBoardItem( PNS::ITEM* aItem )
+bool PNS_KICAD_IFACE_BASE::updateBoardItem( PNS::ITEM* aItem )
 {
     BOARD_ITEM* board_item = aItem->Parent();
 
@@ -1971,13 +2014,11 @@ void PNS_KICAD_IFACE::modifyBoardItem( PNS::ITEM* aItem )
         PCB_ARC*         arc_board = static_cast<PCB_ARC*>( board_item );
         const SHAPE_ARC* arc_shape = static_cast<const SHAPE_ARC*>( arc->Shape( -1 ) );
 
-        m_commit->Modify( arc_board );
-
         arc_board->SetStart( VECTOR2I( arc_shape->GetP0() ) );
         arc_board->SetEnd( VECTOR2I( arc_shape->GetP1() ) );
         arc_board->SetMid( VECTOR2I( arc_shape->GetArcMid() ) );
         arc_board->SetWidth( arc->Width() );
-        break;
+        return true;
     }
 
     case PNS::ITEM::SEGMENT_T:
@@ -1986,12 +2027,10 @@ void PNS_KICAD_IFACE::modifyBoardItem( PNS::ITEM* aItem )
         PCB_TRACK*    track = static_cast<PCB_TRACK*>( board_item );
         const SEG&    s = seg->Seg();
 
-        m_commit->Modify( track );
-
         track->SetStart( VECTOR2I( s.A.x, s.A.y ) );
         track->SetEnd( VECTOR2I( s.B.x, s.B.y ) );
         track->SetWidth( seg->Width() );
-        break;
+        return true;
     }
 
     case PNS::ITEM::VIA_T:
@@ -1999,8 +2038,6 @@ void PNS_KICAD_IFACE::modifyBoardItem( PNS::ITEM* aItem )
         PCB_VIA*  via_board = static_cast<PCB_VIA*>( board_item );
         PNS::VIA* via = static_cast<PNS::VIA*>( aItem );
 
-        m_commit->Modify( via_board );
-
         via_board->SetPosition( VECTOR2I( via->Pos().x, via->Pos().y ) );
         via_board->SetWidth( PADSTACK::ALL_LAYERS, via->Diameter( 0 ) );
         via_board->SetDrill( via->Drill() );
@@ -2009,10 +2046,18 @@ void PNS_KICAD_IFACE::modifyBoardItem( PNS::ITEM* aItem )
         via_board->SetIsFree( via->IsFree() );
         via_board->SetLayerPair( GetBoardLayerFromPNSLayer( via->Layers().Start() ),
                                  GetBoardLayerFromPNSLayer( via->Layers().End() ) );
-        break;
+        return true;
+    }
+
+    default:
+        return false;
     }
+}
 
-    case PNS::ITEM::SOLID_T:
+
+void PNS_KICAD_IFACE::modifyBoardItem( PNS::ITEM* aItem )
+{
+    if( aItem->Kind() == PNS::ITEM::SOLID_T )
     {
         if( aItem->Parent()->Type() == PCB_PAD_T )
         {
@@ -2024,13 +2069,12 @@ void PNS_KICAD_IFACE::modifyBoardItem( PNS::ITEM* aItem )
             m_fpOffsets[pad].p_old = pad->GetPosition();
             m_fpOffsets[pad].p_new = pos;
         }
-        break;
-    }
 
-    default:
-        m_commit->Modify( aItem->Parent() );
-        break;
+        return;
     }
+
+    m_commit->Modify( aItem->Parent() );
+    updateBoardItem( aItem );
 }
 
 
@@ -2045,7 +2089,7 @@ void PNS_KICAD_IFACE_BASE::AddItem( PNS::ITEM* aItem )
 }
 
 
-BOARD_CONNECTED_ITEM* PNS_KICAD_IFACE::createBoardItem( PNS::ITEM* aItem )
+BOARD_CONNECTED_ITEM* PNS_KICAD_IFACE_BASE::createBoardItem( PNS::ITEM* aItem )
 {
     BOARD_CONNECTED_ITEM* newBoardItem = nullptr;
     NETINFO_ITEM* net = static_cast<NETINFO_ITEM*>( aItem->Net() );
@@ -2096,15 +2140,6 @@ BOARD_CONNECTED_ITEM* PNS_KICAD_IFACE::createBoardItem( PNS::ITEM* aItem )
         break;
     }
 
-    case PNS::ITEM::SOLID_T:
-    {
-        PAD*     pad = static_cast<PAD*>( aItem->Parent() );
-        VECTOR2I pos = static_cast<PNS::SOLID*>( aItem )->Pos();
-
-        m_fpOffsets[pad].p_new = pos;
-        return nullptr;
-    }
-
     default:
         return nullptr;
     }
@@ -2121,6 +2156,21 @@ BOARD_CONNECTED_ITEM* PNS_KICAD_IFACE::createBoardItem( PNS::ITEM* aItem )
 }
 
 
+BOARD_CONNECTED_ITEM* PNS_KICAD_IFACE::createBoardItem( PNS::ITEM* aItem )
+{
+    if( aItem->Kind() == PNS::ITEM::SOLID_T )
+    {
+        PAD*     pad = static_cast<PAD*>( aItem->Parent() );
+        VECTOR2I pos = static_cast<PNS::SOLID*>( aItem )->Pos();
+
+        m_fpOffsets[pad].p_new = pos;
+        return nullptr;
+    }
+
+    return PNS_KICAD_IFACE_BASE::createBoardItem( aItem );
+}
+
+
 void PNS_KICAD_IFACE::AddItem( PNS::ITEM* aItem )
 {
     BOARD_CONNECTED_ITEM* boardItem = createBoardItem( aItem );
@@ -2163,6 +2213,58 @@ void PNS_KICAD_IFACE::Commit()
 }
 
 
+PNS_KICAD_IFACE_BATCH::~PNS_KICAD_IFACE_BATCH()
+{
+}
+
+
+void PNS_KICAD_IFACE_BATCH::AddItem( PNS::ITEM* aItem )
+{
+    if( BOARD_CONNECTED_ITEM* boardItem = createBoardItem( aItem ) )
+    {
+        aItem->SetParent( boardItem );
+        m_board->Add( boardItem, ADD_MODE::APPEND );
+    }
+}
+
+
+void PNS_KICAD_IFACE_BATCH::UpdateItem( PNS::ITEM* aItem )
+{
+    updateBoardItem( aItem );
+}
+
+
+void PNS_KICAD_IFACE_BATCH::RemoveItem( PNS::ITEM* aItem )
+{
+    BOARD_ITEM* parent = aItem->Parent();
+
+    // The batch router never moves footprints, so only tracks and vias can go
+    if( parent && parent->Type() != PCB_PAD_T )
+    {
+        m_board->Remove( parent );
+        m_removedItems.emplace_back( parent );
+    }
+}
+
+
+int PNS_KICAD_IFACE_BATCH::GetNetCode( PNS::NET_HANDLE aNet ) const
+{
+    if( aNet )
+        return static_cast<NETINFO_ITEM*>( aNet )->GetNetCode();
+    else
+        return -1;
+}
+
+
+wxString PNS_KICAD_IFACE_BATCH::GetNetName( PNS::NET_HANDLE aNet ) const
+{
+    if( aNet )
+        return static_cast<NETINFO_ITEM*>( aNet )->GetNetname();
+    else
+        return wxEmptyString;
+}
+
+
 EDA_UNITS PNS_KICAD_IFACE::GetUnits() const
 {
     return static_cast<EDA_UNITS>( m_tool->GetManager()->GetSettings()->m_System.units );
@@ -31,6 +31,7 @@ class PNS_PCBNEW_DEBUG_DECORATOR;
 
 class BOARD;
 class BOARD_COMMIT;
+class BOARD_CONNECTED_ITEM;
 class PCB_TEXT;
 class PCB_DISPLAY_OPTIONS;
 class PCB_TOOL_BASE;
@@ -57,6 +58,17 @@ public:
     void EraseView() override {};
     void SetBoard( BOARD* aBoard );
     void SyncWorld( PNS::NODE* aWorld ) override;
+
+    /**
+     * Bring a world built by SyncWorld() up to date with a set of modified tracks and vias,
+     * instead of rebuilding it from scratch.
+     *
+     * @param aRemoved board items no longer on the board.  They are never dereferenced.
+     * @param aUpdated tracks, arcs and vias added to or modified on the board.
+     */
+    void UpdateWorld( PNS::NODE* aWorld, const std::set<const BOARD_ITEM*>& aRemoved,
+                      const std::set<PCB_TRACK*>& aUpdated );
+
     bool IsAnyLayerVisible( const PNS_LAYER_RANGE& aLayer ) const override { return true; };
     bool IsFlashedOnLayer( const PNS::ITEM* aItem, int aLayer ) const override;
     bool IsFlashedOnLayer( const PNS::ITEM* aItem, const PNS_LAYER_RANGE& aLayer ) const override;
@@ -108,11 +120,23 @@ protected:
     std::unique_ptr<PNS::SEGMENT> syncTrack( PCB_TRACK* aTrack );
     std::unique_ptr<PNS::ARC>     syncArc( PCB_ARC* aArc );
     std::unique_ptr<PNS::VIA>     syncVia( PCB_VIA* aVia );
+    void syncTrackItem( PNS::NODE* aWorld, PCB_TRACK* aTrack );
     bool syncTextItem( PNS::NODE* aWorld, PCB_TEXT* aText, PCB_LAYER_ID aLayer );
     bool syncGraphicalItem( PNS::NODE* aWorld, PCB_SHAPE* aItem );
     bool syncZone( PNS::NODE* aWorld, ZONE* aZone, SHAPE_POLY_SET* aBoardOutline );
     bool inheritTrackWidth( PNS::ITEM* aItem, int* aInheritedWidth );
 
+    /**
+     * Create a board track, arc or via matching \a aItem.  Returns nullptr for other items.
+     */
+    BOARD_CONNECTED_ITEM* createBoardItem( PNS::ITEM* aItem );
+
+    /**
+     * Copy the geometry of \a aItem to its parent track, arc or via.  Returns false (leaving the
+     * parent untouched) for other items.
+     */
+    bool updateBoardItem( PNS::ITEM* aItem );
+
 protected:
     PNS::NODE* m_world;
     BOARD*     m_board;
@@ -169,4 +193,26 @@ protected:
 };
 
 
+/**
+ * Router interface for routing without an editor (e.g. from the command line).  Router changes
+ * are applied straight to the board; there is no commit and no undo.
+ */
+class PNS_KICAD_IFACE_BATCH : public PNS_KICAD_IFACE_BASE
+{
+public:
+    ~PNS_KICAD_IFACE_BATCH() override;
+
+    void AddItem( PNS::ITEM* aItem ) override;
+    void UpdateItem( PNS::ITEM* aItem ) override;
+    void RemoveItem( PNS::ITEM* aItem ) override;
+
+    int GetNetCode( PNS::NET_HANDLE aNet ) const override;
+    wxString GetNetName( PNS::NET_HANDLE aNet ) const override;
+
+private:
+    /// Removed board items are kept alive as long as the router may still refer to them
+    std::vector<std::unique_ptr<BOARD_ITEM>> m_removedItems;
+};
+
+
 #endif
@@ -1583,6 +1583,26 @@ void NODE::RemoveByMarker( int aMarker )
 }
 
 
+void NODE::RemoveByParents( const std::set<const BOARD_ITEM*>& aParents )
+{
+    std::vector<ITEM*> garbage;
+
+    for( ITEM* item : *m_index )
+    {
+        if( item->OfKind( ITEM::HOLE_T ) )
+            continue;
+
+        if( aParents.count( item->Parent() ) )
+            garbage.emplace_back( item );
+        else if( item->IsVirtual() && item->OfKind( ITEM::VIA_T ) )
+            garbage.emplace_back( item );
+    }
+
+    for( ITEM* item : garbage )
+        Remove( item );
+}
+
+
 SEGMENT* NODE::findRedundantSegment( const VECTOR2I& A, const VECTOR2I& B, const PNS_LAYER_RANGE& lr,
                                      NET_HANDLE aNet )
 {
@@ -471,6 +471,13 @@ public:
 
     void RemoveByMarker( int aMarker );
 
+    /**
+     * Remove, in a single pass over the index, all items whose parent is one of \a aParents,
+     * along with all virtual vias (FixupVirtualVias() recreates them).  Holes go along with
+     * their pads and vias.
+     */
+    void RemoveByParents( const std::set<const BOARD_ITEM*>& aParents );
+
     ITEM* FindItemByParent( const BOARD_ITEM* aParent );
 
     std::vector<ITEM*> FindItemsByParent( const BOARD_ITEM* aParent );
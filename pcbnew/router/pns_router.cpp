@@ -84,6 +84,12 @@ ROUTER* ROUTER::GetInstance()
 }
 
 
+void ROUTER::SetInstance( ROUTER* aRouter )
+{
+    theRouter = aRouter;
+}
+
+
 ROUTER::~ROUTER()
 {
     ClearWorld();
@@ -111,7 +117,10 @@ void ROUTER::ClearWorld()
         m_world.reset();
     }
 
+    // Whatever was being routed or dragged lived in the world
     m_placer.reset();
+    m_dragger.reset();
+    m_state = IDLE;
 }
 
 
@@ -146,6 +146,12 @@ public:
 
     static ROUTER* GetInstance();
 
+    /**
+     * Make \a aRouter the instance returned by GetInstance().  Needed by tools that keep their
+     * router alive across invocations while other tools create (and destroy) their own.
+     */
+    static void SetInstance( ROUTER* aRouter );
+
     void ClearWorld();
     void SyncWorld();
 
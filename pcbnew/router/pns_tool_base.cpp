@@ -27,6 +27,7 @@ using namespace std::placeholders;
 #include <geometry/geometry_utils.h>
 #include <pcb_painter.h>
 #include <pcbnew_settings.h>
+#include <pcb_track.h>
 #include <view/view_controls.h>
 
 #include <tools/pcb_grid_helper.h>
@@ -59,11 +60,19 @@ TOOL_BASE::TOOL_BASE( const std::string& aToolName ) :
     m_gridHelper = nullptr;
 
     m_cancelled = false;
+
+    m_listenedBoard = nullptr;
+    m_listenedBoardId = niluuid;
+    m_worldNeedsSync = true;
 }
 
 
 TOOL_BASE::~TOOL_BASE()
 {
+    // Boards tell their listeners when they are destroyed, so this one is still alive
+    if( m_listenedBoard )
+        m_listenedBoard->RemoveListener( this );
+
     delete m_gridHelper;
     delete m_router;
     delete m_iface; // Delete after m_router because PNS::NODE dtor needs m_ruleResolver
@@ -72,38 +81,258 @@ TOOL_BASE::~TOOL_BASE()
 
 void TOOL_BASE::Reset( RESET_REASON aReason )
 {
-    delete m_gridHelper;
-    delete m_router;
-    delete m_iface; // Delete after m_router because PNS::NODE dtor needs m_ruleResolver
+    // The view and the board are kept across rendering engine switches and redraws, which may
+    // also happen while routing
+    if( aReason == RESET_REASON::GAL_SWITCH || aReason == RESET_REASON::REDRAW )
+        return;
 
     if( aReason == RESET_REASON::SHUTDOWN )
     {
+        detachWorld();
+
+        delete m_gridHelper;
+        delete m_router;
+        delete m_iface; // Delete after m_router because PNS::NODE dtor needs m_ruleResolver
+
         m_gridHelper = nullptr;
         m_router = nullptr;
         m_iface = nullptr;
         return;
     }
 
-    m_iface = new PNS_KICAD_IFACE;
-    m_iface->SetBoard( board() );
-    m_iface->SetView( getView() );
-    m_iface->SetHostTool( this );
+    // The router is created once and kept across model reloads, as a suspended routing or
+    // dragging loop may still refer to it
+    if( !m_router )
+    {
+        m_iface = new PNS_KICAD_IFACE;
+        m_iface->SetHostTool( this );
+
+        m_router = new ROUTER;
+        m_router->SetInterface( m_iface );
+
+        // Without an editor frame (QA) the router uses default settings
+        if( getToolHolderInternal() )
+        {
+            PCBNEW_SETTINGS* settings = frame()->GetPcbNewSettings();
+
+            if( !settings->m_PnsSettings )
+            {
+                settings->m_PnsSettings = std::make_unique<ROUTING_SETTINGS>( settings,
+                                                                              "tools.pns" );
+            }
+
+            m_router->LoadSettings( settings->m_PnsSettings.get() );
+        }
+        else
+        {
+            m_defaultSettings = std::make_unique<ROUTING_SETTINGS>( nullptr, "" );
+            m_router->LoadSettings( m_defaultSettings.get() );
+        }
+    }
+
+    // The board is identified by its UUID as well, as a new board may be allocated at the
+    // address of a deleted one
+    bool sameBoard = m_listenedBoard && m_listenedBoard == board()
+                     && m_listenedBoardId == board()->m_Uuid;
 
-    m_router = new ROUTER;
-    m_router->SetInterface( m_iface );
-    m_router->ClearWorld();
-    m_router->SyncWorld();
+    // A model reload only drops the world.  It is rebuilt by the next routing action, so
+    // loading a board (which resets the tools more than once) does not sync it.
+    if( aReason == RESET_REASON::MODEL_RELOAD || !sameBoard )
+    {
+        detachWorld();
+
+        m_iface->SetBoard( board() );
+        m_iface->SetView( getView() );
+
+        // The view items of the grid helper are dropped along with the old board's
+        delete m_gridHelper;
+        m_gridHelper = nullptr;
+
+        if( getToolHolderInternal() )
+            m_gridHelper = new PCB_GRID_HELPER( m_toolMgr, frame()->GetMagneticItemsSettings() );
+    }
+
+    if( aReason == RESET_REASON::RUN )
+    {
+        ROUTER::SetInstance( m_router );
+        syncWorld();
+    }
 
     m_router->UpdateSizes( m_savedSizes );
+}
+
+
+void TOOL_BASE::detachWorld()
+{
+    // A deleted board has already cleared m_listenedBoard through OnBoardDestroyed()
+    if( m_listenedBoard )
+        m_listenedBoard->RemoveListener( this );
+
+    m_listenedBoard = nullptr;
 
-    PCBNEW_SETTINGS* settings = frame()->GetPcbNewSettings();
+    if( m_router )
+    {
+        // The board the items were routed on may already be gone, so the route in progress is
+        // dropped without touching it
+        m_router->ClearWorld();
+        m_iface->EraseView();
+    }
 
-    if( !settings->m_PnsSettings )
-        settings->m_PnsSettings = std::make_unique<ROUTING_SETTINGS>( settings, "tools.pns" );
+    m_startItem = nullptr;
+    m_endItem = nullptr;
+
+    invalidateWorld();
+}
+
+
+void TOOL_BASE::syncWorld()
+{
+    if( m_listenedBoard != board() )
+    {
+        detachWorld();
+        m_iface->SetBoard( board() );
+
+        board()->AddListener( this );
+        m_listenedBoard = board();
+        m_listenedBoardId = board()->m_Uuid;
+    }
+
+    if( m_worldNeedsSync || !m_router->GetWorld() )
+    {
+        m_router->SyncWorld();
+    }
+    else if( !m_removedItems.empty() || !m_updatedTracks.empty() )
+    {
+        m_iface->UpdateWorld( m_router->GetWorld(), m_removedItems, m_updatedTracks );
+    }
+
+    m_worldNeedsSync = false;
+    m_removedItems.clear();
+    m_updatedTracks.clear();
+}
+
+
+void TOOL_BASE::invalidateWorld()
+{
+    m_worldNeedsSync = true;
+    m_removedItems.clear();
+    m_updatedTracks.clear();
+}
 
-    m_router->LoadSettings( settings->m_PnsSettings.get() );
 
-    m_gridHelper = new PCB_GRID_HELPER( m_toolMgr, frame()->GetMagneticItemsSettings() );
+void TOOL_BASE::onItemChanged( BOARD& aBoard, BOARD_ITEM* aItem, bool aRemoved )
+{
+    if( &aBoard != m_listenedBoard || m_worldNeedsSync )
+        return;
+
+    switch( aItem->Type() )
+    {
+    case PCB_TRACE_T:
+    case PCB_ARC_T:
+    case PCB_VIA_T:
+    {
+        PCB_TRACK* track = static_cast<PCB_TRACK*>( aItem );
+
+        if( aRemoved )
+        {
+            m_updatedTracks.erase( track );
+            m_removedItems.insert( track );
+        }
+        else
+        {
+            m_updatedTracks.insert( track );
+        }
+
+        break;
+    }
+
+    // Not part of the router world
+    case PCB_GROUP_T:
+    case PCB_GENERATOR_T:
+    case PCB_MARKER_T:
+    case PCB_DIM_ALIGNED_T:
+    case PCB_DIM_LEADER_T:
+    case PCB_DIM_CENTER_T:
+    case PCB_DIM_RADIAL_T:
+    case PCB_DIM_ORTHOGONAL_T:
+    case PCB_TARGET_T:
+    case PCB_REFERENCE_IMAGE_T:
+    case PCB_TABLE_T:
+    case PCB_TABLECELL_T:
+    case PCB_NETINFO_T:
+        break;
+
+    default:
+        invalidateWorld();
+        break;
+    }
+}
+
+
+void TOOL_BASE::OnBoardItemAdded( BOARD& aBoard, BOARD_ITEM* aItem )
+{
+    onItemChanged( aBoard, aItem, false );
+}
+
+
+void TOOL_BASE::OnBoardItemsAdded( BOARD& aBoard, std::vector<BOARD_ITEM*>& aItems )
+{
+    for( BOARD_ITEM* item : aItems )
+        onItemChanged( aBoard, item, false );
+}
+
+
+void TOOL_BASE::OnBoardItemRemoved( BOARD& aBoard, BOARD_ITEM* aItem )
+{
+    onItemChanged( aBoard, aItem, true );
+}
+
+
+void TOOL_BASE::OnBoardItemsRemoved( BOARD& aBoard, std::vector<BOARD_ITEM*>& aItems )
+{
+    for( BOARD_ITEM* item : aItems )
+        onItemChanged( aBoard, item, true );
+}
+
+
+void TOOL_BASE::OnBoardItemChanged( BOARD& aBoard, BOARD_ITEM* aItem )
+{
+    onItemChanged( aBoard, aItem, false );
+}
+
+
+void TOOL_BASE::OnBoardItemsChanged( BOARD& aBoard, std::vector<BOARD_ITEM*>& aItems )
+{
+    for( BOARD_ITEM* item : aItems )
+        onItemChanged( aBoard, item, false );
+}
+
+
+void TOOL_BASE::OnBoardDestroyed( BOARD& aBoard )
+{
+    if( &aBoard == m_listenedBoard )
+    {
+        m_listenedBoard = nullptr;
+        invalidateWorld();
+    }
+}
+
+
+void TOOL_BASE::OnBoardNetSettingsChanged( BOARD& aBoard )
+{
+    if( &aBoard == m_listenedBoard )
+        invalidateWorld();
+}
+
+
+void TOOL_BASE::OnBoardCompositeUpdate( BOARD& aBoard, std::vector<BOARD_ITEM*>& aAddedItems,
+                                        std::vector<BOARD_ITEM*>& aRemovedItems,
+                                        std::vector<BOARD_ITEM*>& aChangedItems )
+{
+    // Removals first so that an item re-added at a recycled address is not dropped again
+    OnBoardItemsRemoved( aBoard, aRemovedItems );
+    OnBoardItemsAdded( aBoard, aAddedItems );
+    OnBoardItemsChanged( aBoard, aChangedItems );
 }
 
 
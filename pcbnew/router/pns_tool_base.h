@@ -27,6 +27,7 @@
 
 #include <math/vector2d.h>
 #include <tools/pcb_tool_base.h>
+#include <board.h>
 #include <board_commit.h>
 
 #include <widgets/msgpanel.h>
@@ -41,7 +42,7 @@ class PNS_TUNE_STATUS_POPUP;
 namespace PNS
 {
 
-class TOOL_BASE : public PCB_TOOL_BASE
+class TOOL_BASE : public PCB_TOOL_BASE, public BOARD_LISTENER
 {
 public:
     TOOL_BASE( const std::string& aToolName );
@@ -53,7 +54,39 @@ public:
 
     PNS_KICAD_IFACE* GetInterface() const;
 
+    void OnBoardItemAdded( BOARD& aBoard, BOARD_ITEM* aItem ) override;
+    void OnBoardItemsAdded( BOARD& aBoard, std::vector<BOARD_ITEM*>& aItems ) override;
+    void OnBoardItemRemoved( BOARD& aBoard, BOARD_ITEM* aItem ) override;
+    void OnBoardItemsRemoved( BOARD& aBoard, std::vector<BOARD_ITEM*>& aItems ) override;
+    void OnBoardItemChanged( BOARD& aBoard, BOARD_ITEM* aItem ) override;
+    void OnBoardItemsChanged( BOARD& aBoard, std::vector<BOARD_ITEM*>& aItems ) override;
+    void OnBoardNetSettingsChanged( BOARD& aBoard ) override;
+    void OnBoardDestroyed( BOARD& aBoard ) override;
+    void OnBoardCompositeUpdate( BOARD& aBoard, std::vector<BOARD_ITEM*>& aAddedItems,
+                                 std::vector<BOARD_ITEM*>& aRemovedItems,
+                                 std::vector<BOARD_ITEM*>& aChangedItems ) override;
+
 protected:
+    /**
+     * Bring the router world up to date with the board.
+     *
+     * The world is built from scratch for a board it was not built for (e.g. after a model
+     * reload).  Track and via changes reported by the board since the last synchronization are
+     * applied to the existing world; any other change to routing-relevant items rebuilds it.
+     */
+    void syncWorld();
+
+    /**
+     * Force the next syncWorld() to rebuild the router world from scratch.
+     */
+    void invalidateWorld();
+
+    /**
+     * Stop listening to the board and drop the router world, including anything being routed
+     * or dragged.  The next syncWorld() rebuilds it for the current board.
+     */
+    void detachWorld();
+
     bool checkSnap( ITEM* aItem );
 
     const VECTOR2I snapToItem( ITEM* aSnapToItem, const VECTOR2I& aP);
@@ -81,7 +114,19 @@ protected:
 
     bool             m_cancelled;
 
+    ///< Router settings used when there is no editor frame to get them from
+    std::unique_ptr<ROUTING_SETTINGS> m_defaultSettings;
+
     static const unsigned int COORDS_PADDING; // Padding from coordinates limits for this tool
+
+private:
+    void onItemChanged( BOARD& aBoard, BOARD_ITEM* aItem, bool aRemoved );
+
+    BOARD*                      m_listenedBoard;
+    KIID                        m_listenedBoardId;
+    bool                        m_worldNeedsSync;   ///< The world must be rebuilt from scratch
+    std::set<const BOARD_ITEM*> m_removedItems;     ///< Never dereferenced
+    std::set<PCB_TRACK*>        m_updatedTracks;
 };
 
 }
@@ -73,6 +73,7 @@ using namespace std::placeholders;
 #include "router_tool.h"
 #include "router_status_view_item.h"
 #include "pns_router.h"
+#include "pns_autorouter.h"
 #include "pns_itemset.h"
 #include "pns_logger.h"
 #include "pns_placement_algo.h"
@@ -529,6 +530,8 @@ bool ROUTER_TOOL::Init()
     menu.AddItem( PCB_ACTIONS::routerAttemptFinish,   hasOtherEnd );
     menu.AddItem( PCB_ACTIONS::routerAutorouteSelected, notRoutingCond
                                                             && SELECTION_CONDITIONS::NotEmpty );
+    menu.AddItem( PCB_ACTIONS::routerBatchRouteSelected, notRoutingCond
+                                                            && SELECTION_CONDITIONS::NotEmpty );
     menu.AddItem( PCB_ACTIONS::breakTrack,            notRoutingCond );
 
     menu.AddItem( PCB_ACTIONS::drag45Degree,          notRoutingCond );
@@ -568,8 +571,7 @@ void ROUTER_TOOL::Reset( RESET_REASON aReason )
 {
     m_lastTargetLayer = UNDEFINED_LAYER;
 
-    if( aReason == RUN )
-        TOOL_BASE::Reset( aReason );
+    TOOL_BASE::Reset( aReason );
 }
 
 // Saves the complete event log and the dump of the PCB, allowing us to
@@ -1595,6 +1597,8 @@ int ROUTER_TOOL::RouteSelected( const TOOL_EVENT& aEvent )
     // Set initial cursor
     setCursor();
 
+    syncWorld();
+
     // Get all connected board items, adding pads for any footprints selected
     std::vector<BOARD_CONNECTED_ITEM*> itemList;
 
@@ -1692,6 +1696,77 @@ int ROUTER_TOOL::RouteSelected( const TOOL_EVENT& aEvent )
 }
 
 
+int ROUTER_TOOL::BatchRouteSelected( const TOOL_EVENT& aEvent )
+{
+    PCB_EDIT_FRAME* frame = getEditFrame<PCB_EDIT_FRAME>();
+
+    if( m_router->RoutingInProgress() )
+        return 0;
+
+    PCB_SELECTION& selection = m_toolMgr->GetTool<PCB_SELECTION_TOOL>()->GetSelection();
+
+    // Get all connected board items, adding pads for any footprints selected
+    std::set<BOARD_CONNECTED_ITEM*> items;
+    std::set<int>                   netcodes;
+
+    for( EDA_ITEM* item : selection )
+    {
+        if( item->Type() == PCB_FOOTPRINT_T )
+        {
+            for( PAD* pad : static_cast<FOOTPRINT*>( item )->Pads() )
+            {
+                items.insert( pad );
+                netcodes.insert( pad->GetNetCode() );
+            }
+        }
+        else if( BOARD_CONNECTED_ITEM* bci = dynamic_cast<BOARD_CONNECTED_ITEM*>( item ) )
+        {
+            items.insert( bci );
+            netcodes.insert( bci->GetNetCode() );
+        }
+    }
+
+    std::shared_ptr<CONNECTIVITY_DATA> connectivity = frame->GetBoard()->GetConnectivity();
+    PNS::AUTOROUTER                    autorouter( m_router );
+
+    for( int netcode : netcodes )
+    {
+        if( RN_NET* net = connectivity->GetRatsnestForNet( netcode ) )
+            autorouter.AddRatsnest( net, &items );
+    }
+
+    if( autorouter.Connections().empty() )
+        return 0;
+
+    m_toolMgr->RunAction( PCB_ACTIONS::selectionClear );
+
+    syncWorld();
+    m_router->SetMode( PNS::PNS_MODE_ROUTE_SINGLE );
+    m_iface->SetStartLayerFromPCBNew( frame->GetActiveLayer() );
+
+    // Everything the batch routes goes into a single undo step
+    m_iface->SetCommitFlags( 0 );
+
+    int failed = autorouter.Run( 2,
+            [&]( const PNS::AUTOROUTER::CONNECTION& )
+            {
+                m_iface->SetCommitFlags( APPEND_UNDO );
+            } );
+
+    m_iface->SetCommitFlags( 0 );
+
+    if( failed > 0 )
+    {
+        frame->ShowInfoBarWarning( wxString::Format( _( "%d of %d connections could not be "
+                                                        "routed." ),
+                                                     failed,
+                                                     (int) autorouter.Connections().size() ) );
+    }
+
+    return 0;
+}
+
+
 int ROUTER_TOOL::MainLoop( const TOOL_EVENT& aEvent )
 {
     if( m_inRouterTool )
@@ -1741,6 +1816,9 @@ int ROUTER_TOOL::MainLoop( const TOOL_EVENT& aEvent )
         if( !evt->IsDrag() )
             setCursor();
 
+        // Rebuilds the world after a model reload; otherwise only applies pending board changes
+        syncWorld();
+
         if( evt->IsCancelInteractive() )
         {
             frame->PopTool( aEvent );
@@ -1765,7 +1843,13 @@ int ROUTER_TOOL::MainLoop( const TOOL_EVENT& aEvent )
         }
         else if( evt->Action() == TA_UNDO_REDO_POST || evt->Action() == TA_MODEL_CHANGE )
         {
-            m_router->SyncWorld();
+            // Commits, undo and redo only touch what the board listener has recorded; a model
+            // change sent as a command (e.g. after editing the board setup) may affect
+            // everything.
+            if( evt->Category() == TC_COMMAND )
+                invalidateWorld();
+
+            syncWorld();
         }
         else if( evt->IsMotion() )
         {
@@ -1892,6 +1976,10 @@ void ROUTER_TOOL::performDragging( int aMode )
     {
         ctls->ForceCursorPosition( false );
 
+        // The drag is dropped along with the router world by a model reload
+        if( !m_router->RoutingInProgress() )
+            break;
+
         if( evt->IsMotion() )
         {
             updateEndItem( *evt );
@@ -2164,6 +2252,7 @@ int ROUTER_TOOL::InlineDrag( const TOOL_EVENT& aEvent )
     frame()->PushTool( aEvent );
     Activate();
 
+    syncWorld();
     m_startItem = nullptr;
 
     PNS::ITEM*    startItem = nullptr;
@@ -2354,6 +2443,10 @@ int ROUTER_TOOL::InlineDrag( const TOOL_EVENT& aEvent )
     {
         setCursor();
 
+        // The drag is dropped along with the router world by a model reload
+        if( !m_router->RoutingInProgress() )
+            break;
+
         if( evt->IsCancelInteractive() )
         {
             if( wasLocked )
@@ -2576,6 +2669,7 @@ int ROUTER_TOOL::InlineBreakTrack( const TOOL_EVENT& aEvent )
 
     Activate();
 
+    syncWorld();
     m_startItem = m_router->GetWorld()->FindItemByParent( item );
 
     TOOL_MANAGER* toolManager = frame()->GetToolManager();
@@ -2815,6 +2909,7 @@ void ROUTER_TOOL::setTransitions()
     Go( &ROUTER_TOOL::RouteSelected,          PCB_ACTIONS::routerRouteSelected.MakeEvent() );
     Go( &ROUTER_TOOL::RouteSelected,          PCB_ACTIONS::routerRouteSelectedFromEnd.MakeEvent() );
     Go( &ROUTER_TOOL::RouteSelected,          PCB_ACTIONS::routerAutorouteSelected.MakeEvent() );
+    Go( &ROUTER_TOOL::BatchRouteSelected,     PCB_ACTIONS::routerBatchRouteSelected.MakeEvent() );
     Go( &ROUTER_TOOL::DpDimensionsDialog,     PCB_ACTIONS::routerDiffPairDialog.MakeEvent() );
     Go( &ROUTER_TOOL::SettingsDialog,         PCB_ACTIONS::routerSettingsDialog.MakeEvent() );
     Go( &ROUTER_TOOL::ChangeRouterMode,       PCB_ACTIONS::routerHighlightMode.MakeEvent() );
@@ -38,6 +38,7 @@ public:
 
     int MainLoop( const TOOL_EVENT& aEvent );
     int RouteSelected( const TOOL_EVENT& aEvent );
+    int BatchRouteSelected( const TOOL_EVENT& aEvent );
 
     int InlineBreakTrack( const TOOL_EVENT& aEvent );
     bool CanInlineDrag( int aDragMode );
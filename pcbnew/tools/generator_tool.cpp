@@ -172,6 +172,8 @@ int GENERATOR_TOOL::RegenerateAllOfType( const TOOL_EVENT& aEvent )
     if( generatorType == wxS( "*" ) )
         commitMsg = _( "Regenerate All" );
 
+    BeginBatchUpdate();
+
     for( PCB_GENERATOR* generator : board()->Generators() )
     {
         if( generatorType == wxS( "*" ) || generator->GetGeneratorType() == generatorType )
@@ -187,6 +189,8 @@ int GENERATOR_TOOL::RegenerateAllOfType( const TOOL_EVENT& aEvent )
         }
     }
 
+    EndBatchUpdate();
+
     frame()->RefreshCanvas();
     return 0;
 }
@@ -228,6 +232,8 @@ int GENERATOR_TOOL::RegenerateSelected( const TOOL_EVENT& aEvent )
                } );
 #endif
 
+    BeginBatchUpdate();
+
     for( PCB_GENERATOR* gen : generators )
     {
         gen->EditStart( this, board(), &commit );
@@ -237,6 +243,8 @@ int GENERATOR_TOOL::RegenerateSelected( const TOOL_EVENT& aEvent )
         commitFlags |= APPEND_UNDO;
     }
 
+    EndBatchUpdate();
+
     frame()->RefreshCanvas();
     return 0;
 }
@@ -111,8 +111,34 @@ const std::vector<GENERATOR_PNS_CHANGES>& GENERATOR_TOOL_PNS_PROXY::GetRouterCha
 }
 
 
+void GENERATOR_TOOL_PNS_PROXY::SyncRouterWorld()
+{
+    if( m_inBatchUpdate && m_batchWorldSynced )
+        return;
+
+    m_router->SyncWorld();
+    m_batchWorldSynced = m_inBatchUpdate;
+}
+
+
+void GENERATOR_TOOL_PNS_PROXY::BeginBatchUpdate()
+{
+    m_inBatchUpdate = true;
+    m_batchWorldSynced = false;
+}
+
+
+void GENERATOR_TOOL_PNS_PROXY::EndBatchUpdate()
+{
+    m_inBatchUpdate = false;
+    m_batchWorldSynced = false;
+}
+
+
 GENERATOR_TOOL_PNS_PROXY::GENERATOR_TOOL_PNS_PROXY( const std::string& aToolName ) :
-        PNS::TOOL_BASE( aToolName )
+        PNS::TOOL_BASE( aToolName ),
+        m_inBatchUpdate( false ),
+        m_batchWorldSynced( false )
 {
 }
 
@@ -143,11 +169,24 @@ void GENERATOR_TOOL_PNS_PROXY::Reset( RESET_REASON aReason )
 
     m_router = new PNS::ROUTER;
     m_router->SetInterface( m_iface );
-    m_router->ClearWorld();
-    m_router->SyncWorld();
+
+    // The world is built by SyncRouterWorld() when a generator is edited
+
+    m_batchWorldSynced = false;
 
     m_router->UpdateSizes( m_savedSizes );
 
+    // Without an editor frame (QA) the router uses default settings and there is no grid
+    if( !getToolHolderInternal() )
+    {
+        if( !m_defaultSettings )
+            m_defaultSettings = std::make_unique<PNS::ROUTING_SETTINGS>( nullptr, "" );
+
+        m_router->LoadSettings( m_defaultSettings.get() );
+        m_gridHelper = nullptr;
+        return;
+    }
+
     PCBNEW_SETTINGS* settings = frame()->GetPcbNewSettings();
 
     if( !settings->m_PnsSettings )
@@ -51,6 +51,20 @@ public:
 
     void                                      ClearRouterChanges();
     const std::vector<GENERATOR_PNS_CHANGES>& GetRouterChanges();
+
+    /**
+     * Synchronize the router world with the board.  Inside a batch update the world is only
+     * built for the first generator: every generator pushes its router changes to the board
+     * before the next one starts, so the world tracks the board without being rebuilt.
+     */
+    void SyncRouterWorld();
+
+    void BeginBatchUpdate();
+    void EndBatchUpdate();
+
+private:
+    bool m_inBatchUpdate;
+    bool m_batchWorldSynced;
 };
 
 #endif // GENERATOR_TOOL_PNS_PROXY_H
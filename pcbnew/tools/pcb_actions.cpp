@@ -2404,6 +2404,13 @@ TOOL_ACTION PCB_ACTIONS::routerAutorouteSelected( TOOL_ACTION_ARGS()
         .Flags( AF_ACTIVATE )
         .Parameter( PNS::PNS_MODE_ROUTE_SINGLE ) );
 
+TOOL_ACTION PCB_ACTIONS::routerBatchRouteSelected( TOOL_ACTION_ARGS()
+        .Name( "pcbnew.InteractiveRouter.BatchRoute" )
+        .Scope( AS_GLOBAL )
+        .FriendlyName( _( "Autoroute Selected Without Interaction" ) )
+        .Tooltip( _( "Route the ratsnest of the selected items in one go, leaving any "
+                     "connections that cannot be completed unrouted." ) ) );
+
 TOOL_ACTION PCB_ACTIONS::breakTrack( TOOL_ACTION_ARGS()
         .Name( "pcbnew.InteractiveRouter.BreakTrack" )
         .Scope( AS_GLOBAL )
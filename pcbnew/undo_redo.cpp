@@ -36,6 +36,7 @@ using namespace std::placeholders;
 #include <footprint.h>
 #include <lset.h>
 #include <pad.h>
+#include <zone.h>
 #include <origin_viewitem.h>
 #include <connectivity/connectivity_data.h>
 #include <tool/tool_manager.h>
@@ -456,6 +457,10 @@ void PCB_BASE_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList )
 
             item->SwapItemData( image );
 
+            // Keep the zone copies of the undo list compact
+            if( image->Type() == PCB_ZONE_T )
+                static_cast<ZONE*>( image )->FreezeFills();
+
             item->ClearFlags( UR_TRANSIENT );
             image->SetFlags( UR_TRANSIENT );
 
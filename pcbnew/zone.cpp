@@ -25,6 +25,7 @@
 
 #include <advanced_config.h>
 #include <bitmaps.h>
+#include <geometry/frozen_poly_set.h>
 #include <geometry/geometry_utils.h>
 #include <geometry/shape_null.h>
 #include <pcb_edit_frame.h>
@@ -36,6 +37,7 @@
 #include <zone.h>
 #include <footprint.h>
 #include <string_utils.h>
+#include <thread_pool.h>
 #include <math_for_graphics.h>
 #include <properties/property_validators.h>
 #include <settings/color_settings.h>
@@ -192,6 +194,8 @@ void ZONE::InitDataFromSrcInCopyCtor( const ZONE& aZone )
                 m_insulatedIslands[layer] = aZone.m_insulatedIslands.at( layer );
             } );
 
+    m_frozenFills             = aZone.m_frozenFills;
+
     m_borderStyle             = aZone.m_borderStyle;
     m_borderHatchPitch        = aZone.m_borderHatchPitch;
     m_borderHatchLines        = aZone.m_borderHatchLines;
@@ -426,6 +430,7 @@ bool ZONE::UnFill()
         pair.second->RemoveAllContours();
     }
 
+    m_previousFills.clear();
     m_isFilled = false;
     m_fillFlags.reset();
 
@@ -1300,22 +1305,69 @@ void ZONE::swapData( BOARD_ITEM* aImage )
     assert( aImage->Type() == PCB_ZONE_T );
 
     std::swap( *static_cast<ZONE*>( this ), *static_cast<ZONE*>( aImage) );
+
+    // The image may have been kept in compact form (see FreezeFills()), but this is the zone
+    // which will be displayed
+    ThawFills();
+}
+
+
+void ZONE::FreezeFills()
+{
+    for( auto& [layer, fill] : m_FilledPolysList )
+    {
+        if( fill && !fill->IsEmpty() )
+        {
+            m_frozenFills[layer] = std::make_shared<FROZEN_POLY_SET>( *fill );
+            fill = std::make_shared<SHAPE_POLY_SET>();
+        }
+    }
+
+    m_previousFills.clear();
+}
+
+
+void ZONE::ThawFills()
+{
+    for( const auto& [layer, frozen] : m_frozenFills )
+        m_FilledPolysList[layer] = std::make_shared<SHAPE_POLY_SET>( frozen->Thaw() );
+
+    m_frozenFills.clear();
 }
 
 
 void ZONE::CacheTriangulation( PCB_LAYER_ID aLayer )
 {
+    auto cacheFill =
+            [&]( PCB_LAYER_ID aFillLayer, SHAPE_POLY_SET& aFill )
+            {
+                auto previous = m_previousFills.find( aFillLayer );
+
+                if( previous != m_previousFills.end() )
+                {
+                    aFill.CacheTriangulation( GetKiCadThreadPool(), previous->second.get() );
+                    m_previousFills.erase( previous );
+                }
+                else
+                {
+                    aFill.CacheTriangulation( GetKiCadThreadPool() );
+                }
+            };
+
     if( aLayer == UNDEFINED_LAYER )
     {
         for( auto& [ layer, poly ] : m_FilledPolysList )
-            poly->CacheTriangulation();
+            cacheFill( layer, *poly );
+
+        // Also those of layers the zone is no longer on
+        m_previousFills.clear();
 
         m_Poly->CacheTriangulation( false );
     }
     else
     {
         if( m_FilledPolysList.count( aLayer ) )
-            m_FilledPolysList[ aLayer ]->CacheTriangulation();
+            cacheFill( aLayer, *m_FilledPolysList[ aLayer ] );
     }
 }
 
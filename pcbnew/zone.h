@@ -38,6 +38,7 @@
 #include <teardrop/teardrop_types.h>
 
 
+class FROZEN_POLY_SET;
 class LINE_READER;
 class PCB_EDIT_FRAME;
 class BOARD;
@@ -647,9 +648,28 @@ public:
      */
     void SetFilledPolysList( PCB_LAYER_ID aLayer, const SHAPE_POLY_SET& aPolysList )
     {
-        m_FilledPolysList[aLayer] = std::make_shared<SHAPE_POLY_SET>( aPolysList );
+        std::shared_ptr<SHAPE_POLY_SET>& fill = m_FilledPolysList[aLayer];
+
+        if( fill && fill->TriangulatedPolyCount() > 0 )
+            m_previousFills[aLayer] = fill;
+
+        fill = std::make_shared<SHAPE_POLY_SET>( aPolysList );
+        m_frozenFills.erase( aLayer );
     }
 
+    /**
+     * Replace the fills by compact, read-only copies.
+     *
+     * This is meant for zones which are kept but neither displayed nor tested, such as the
+     * copies held by the undo list.  The fills read as empty until ThawFills() is called.
+     */
+    void FreezeFills();
+
+    /**
+     * Restore the fills stored by FreezeFills(), if any.
+     */
+    void ThawFills();
+
     /**
      * Check if a given filled polygon is an insulated island.
      *
@@ -943,6 +963,14 @@ protected:
      */
     std::map<PCB_LAYER_ID, std::shared_ptr<SHAPE_POLY_SET>> m_FilledPolysList;
 
+    /// Triangulated fills replaced since the last CacheTriangulation(), whose triangles are
+    /// reused for the parts of the new fills which didn't change.  Released once that
+    /// triangulation is done, or when the zone is unfilled.
+    std::map<PCB_LAYER_ID, std::shared_ptr<SHAPE_POLY_SET>> m_previousFills;
+
+    /// Fills stored by FreezeFills(); shared between copies as they are never modified
+    std::map<PCB_LAYER_ID, std::shared_ptr<const FROZEN_POLY_SET>> m_frozenFills;
+
     /// Temp variables used while filling
     LSET                                   m_fillFlags;
 
@@ -146,6 +146,7 @@ void SaveCopyOfZones( PICKED_ITEMS_LIST& aPickList, BOARD* aPcb )
         ZONE* zoneDup = new ZONE( *zone );
         zoneDup->SetParent( aPcb );
         zoneDup->SetParentGroup( nullptr );
+        zoneDup->FreezeFills();
 
         ITEM_PICKER picker( nullptr, zone, UNDO_REDO::CHANGED );
         picker.SetLink( zoneDup );
@@ -139,3 +139,34 @@ def test_pcb_export_gerber( kitest: KiTestFixture,
         # Comparison DPI = 5080 => 1px == 5um. I.e. allowable error of 15 um after eroding
         assert utils.gerbers_are_equivalent( str( generated_gerber_path ), gbr_source_path, 5080,
                                              originInches, windowsizeInches )
+
+
+def test_pcb_route( kitest: KiTestFixture ):
+    input_file = kitest.get_data_file_path( "pcbnew/autoroute_basic.kicad_pcb" )
+    output_dir = str( kitest.get_output_path( "cli/route/" ) )
+    output_path = Path( output_dir + "/autoroute_basic-routed.kicad_pcb" )
+
+    if output_path.exists():
+        output_path.unlink()
+
+    # One connection has its pads on opposite sides, and one ends on a zone: neither can be
+    # routed without vias
+    command = ["kicad-cli", "pcb", "route", "--exit-code-unrouted", "-o", str( output_path ),
+               input_file]
+
+    stdout, stderr, exitcode = utils.run_and_capture( command )
+    assert exitcode == 7  # ERR_UNROUTED
+    assert "Routed 2 of 4 connections" in stdout
+    assert output_path.exists()
+
+    kitest.add_attachment( output_path )
+
+    # Routing only the nets which can be completed succeeds
+    output_path.unlink()
+    command = ["kicad-cli", "pcb", "route", "--exit-code-unrouted", "--nets", "smd_pair,tht_pair",
+               "-o", str( output_path ), input_file]
+
+    stdout, stderr, exitcode = utils.run_and_capture( command )
+    assert exitcode == 0
+    assert "Routed 2 of 2 connections" in stdout
+    assert output_path.exists()
@@ -0,0 +1,115 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <lib_tree_model.h>
+#include <lib_tree_search_index.h>
+
+
+namespace
+{
+
+class TEST_TREE_ITEM : public LIB_TREE_ITEM
+{
+public:
+    TEST_TREE_ITEM( const wxString& aName, const wxString& aKeywords, const wxString& aDesc ) :
+            m_name( aName ),
+            m_keywords( aKeywords ),
+            m_desc( aDesc )
+    {}
+
+    LIB_ID GetLIB_ID() const override { return LIB_ID( wxS( "Lib" ), m_name ); }
+    wxString GetName() const override { return m_name; }
+    wxString GetLibNickname() const override { return wxS( "Lib" ); }
+    wxString GetDesc() override { return m_desc; }
+
+    std::vector<SEARCH_TERM> GetSearchTerms() override
+    {
+        return { SEARCH_TERM( m_name, 8 ), SEARCH_TERM( m_keywords, 4 ),
+                 SEARCH_TERM( m_desc, 1 ) };
+    }
+
+private:
+    wxString m_name;
+    wxString m_keywords;
+    wxString m_desc;
+};
+
+} // namespace
+
+
+BOOST_AUTO_TEST_SUITE( LibTreeSearchIndex )
+
+
+/**
+ * The index must score items exactly as EDA_COMBINED_MATCHER, whatever the kind of pattern and
+ * the order the patterns are searched for.
+ */
+BOOST_AUTO_TEST_CASE( MatchesCombinedMatcher )
+{
+    LIB_TREE_NODE_ROOT     root;
+    LIB_TREE_NODE_LIBRARY& lib = root.AddLib( wxS( "Lib" ), wxEmptyString );
+
+    // Enough items to be scored in parallel
+    for( int ii = 0; ii < 5000; ++ii )
+    {
+        wxString name = wxString::Format( wxS( "R_%04d_Res%d" ), ii, ii % 7 );
+        wxString keywords = wxString::Format( wxS( "resistor value=%dk" ), ii % 100 );
+        wxString desc = wxString::Format( wxS( "Resistor, %d ohm, package %s" ), ii,
+                                          ii % 3 ? wxS( "0603" ) : wxS( "0805" ) );
+
+        TEST_TREE_ITEM item( name, keywords, desc );
+        lib.AddItem( &item );
+    }
+
+    LIB_TREE_SEARCH_INDEX index;
+
+    const std::vector<wxString> patterns = {
+        wxS( "r" ), wxS( "r_" ), wxS( "r_00" ), wxS( "r_0012" ), wxS( "r_0012_res5" ),
+        wxS( "0603" ), wxS( "res" ), wxS( "resistor" ), wxS( "ohm," ), wxS( "zzz" ),
+        wxS( "r_0*_res3" ), wxS( "/^r_01.*res2$/" ), wxS( "value>50k" ), wxS( "value=" ),
+        wxS( "r_001" ), wxS( "" )
+    };
+
+    for( const wxString& pattern : patterns )
+    {
+        BOOST_TEST_CONTEXT( pattern )
+        {
+            EDA_COMBINED_MATCHER matcher( pattern, CTX_LIBITEM );
+
+            index.ScoreItems( root, pattern );
+
+            for( std::unique_ptr<LIB_TREE_NODE>& node : lib.m_Children )
+            {
+                LIB_TREE_NODE_ITEM*      item = static_cast<LIB_TREE_NODE_ITEM*>( node.get() );
+                std::vector<SEARCH_TERM> terms = item->m_SearchTerms;
+
+                BOOST_REQUIRE_EQUAL( item->m_TermsScore, matcher.ScoreTerms( terms ) );
+            }
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -26,9 +26,16 @@
  * Test suite for general string functions
  */
 
+#include <filesystem>
+#include <fstream>
+#include <limits>
+
+#include <fmt/format.h>
+
 #include <qa_utils/wx_utils/unit_test_utils.h>
 
 // Code under test
+#include <dsnlexer.h>
 #include <richio.h>
 
 /**
@@ -80,4 +87,171 @@ BOOST_AUTO_TEST_CASE( VPrint )
     output.clear();
 }
 
+
+/**
+ * Check that the memory mapped reader returns the same lines as the file reader, both in place
+ * and copied.
+ */
+BOOST_AUTO_TEST_CASE( MmapLineReader )
+{
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "richio_mmap.txt";
+    const std::string           text = "(first line)\n\n(third \"line\")\nno newline at end";
+
+    {
+        std::ofstream file( path, std::ios::binary );
+        file << text;
+    }
+
+    FILE_LINE_READER fileReader( path.string() );
+    MMAP_LINE_READER mmapReader( path.string() );
+    MMAP_LINE_READER inPlaceReader( path.string() );
+
+    BOOST_CHECK( mmapReader.GetText() == text );
+
+    for( ;; )
+    {
+        char*       line = fileReader.ReadLine();
+        char*       mmapLine = mmapReader.ReadLine();
+        unsigned    length;
+        const char* inPlaceLine = inPlaceReader.ReadLineInPlace( length );
+
+        BOOST_REQUIRE_EQUAL( fileReader.Length(), mmapReader.Length() );
+        BOOST_REQUIRE_EQUAL( fileReader.Length(), length );
+        BOOST_CHECK_EQUAL( fileReader.LineNumber(), inPlaceReader.LineNumber() );
+
+        if( !line )
+        {
+            BOOST_CHECK( !mmapLine );
+            break;
+        }
+
+        BOOST_CHECK_EQUAL( std::string( line ), std::string( mmapLine ) );
+        BOOST_CHECK_EQUAL( std::string( line ), std::string( inPlaceLine, length ) );
+    }
+
+    std::filesystem::remove( path );
+}
+
+
+/**
+ * Check that DSNLEXER reports the current line when lexing in place.
+ */
+BOOST_AUTO_TEST_CASE( LexInPlace )
+{
+    DSNLEXER lexer( "(a b)\n(c \"d e\")\n", wxT( "test" ) );
+
+    std::vector<std::string> tokens;
+
+    for( int tok = lexer.NextTok(); tok != DSN_EOF; tok = lexer.NextTok() )
+    {
+        tokens.push_back( lexer.CurText() );
+
+        if( tokens.back() == "d e" )
+        {
+            BOOST_CHECK_EQUAL( std::string( lexer.CurLine() ), std::string( "(c \"d e\")\n" ) );
+            BOOST_CHECK_EQUAL( lexer.CurLineNumber(), 2 );
+        }
+    }
+
+    BOOST_CHECK_EQUAL( tokens.size(), 8 );
+}
+
+
+/**
+ * Give access to the protected number parsing of DSNLEXER.
+ */
+class NUMBER_LEXER : public DSNLEXER
+{
+public:
+    NUMBER_LEXER( const std::string& aText ) : DSNLEXER( aText ) {}
+
+    using DSNLEXER::parseScaledInt;
+};
+
+
+/**
+ * Check that numbers are converted to internal units as the double path does, but with exact
+ * rounding of ties.
+ */
+BOOST_AUTO_TEST_CASE( ParseScaledInt )
+{
+    const double limit = std::numeric_limits<int>::max() - 10;
+
+    const std::vector<std::pair<std::string, int>> cases = {
+        { "0", 0 },
+        { "-0", 0 },
+        { "1", 1000000 },
+        { "-12.5", -12500000 },
+        { "0.000001", 1 },
+        { "123.456789", 123456789 },
+        { ".25", 250000 },
+        { "3.", 3000000 },
+        { "1.2345675", 1234568 },       // tie, away from zero
+        { "-1.2345675", -1234568 },
+        { "1.23456749999", 1234567 },
+        { "1e3", 1000000000 },          // exponent, through parseDouble()
+        { "99999999", 2147483637 },     // clamped
+        { "-99999999999999999999999", -2147483637 },
+    };
+
+    for( const auto& [text, expected] : cases )
+    {
+        NUMBER_LEXER lexer( text );
+
+        BOOST_REQUIRE_EQUAL( lexer.NextTok(), DSN_NUMBER );
+        BOOST_CHECK_EQUAL( lexer.parseScaledInt( 1e6, limit ), expected );
+    }
+
+    // Same results as scaling the double for everything KiCad writes
+    for( int value : { 1, -7, 254000, -1270001, 999999999, 2147483636 } )
+    {
+        NUMBER_LEXER lexer( fmt::format( "{}{}.{:06}", value < 0 ? "-" : "", std::abs( value ) / 1000000,
+                                         std::abs( value ) % 1000000 ) );
+
+        lexer.NextTok();
+        BOOST_CHECK_EQUAL( lexer.parseScaledInt( 1e6, limit ), value );
+    }
+
+    NUMBER_LEXER notANumber( "(abc)" );
+    notANumber.NextTok();
+    notANumber.NextTok();
+
+    BOOST_CHECK_THROW( notANumber.parseScaledInt( 1e6, limit ), IO_ERROR );
+}
+
+
+/**
+ * Check that DSNLEXER::SkipList() stops after the list it is in, whatever the list holds.
+ */
+BOOST_AUTO_TEST_CASE( SkipList )
+{
+    DSNLEXER lexer( "(a (b (xy 1 2)\n# comment )\n (c \"(\\\")\")) d) (e)\n", wxT( "test" ) );
+
+    lexer.NextTok();
+    lexer.NextTok();
+    lexer.NextTok();
+    lexer.NextTok();
+
+    BOOST_CHECK_EQUAL( std::string( lexer.CurText() ), std::string( "b" ) );
+
+    lexer.SkipList();
+
+    BOOST_CHECK_EQUAL( lexer.CurTok(), DSN_RIGHT );
+    BOOST_CHECK_EQUAL( lexer.NextTok(), DSN_SYMBOL );
+    BOOST_CHECK_EQUAL( std::string( lexer.CurText() ), std::string( "d" ) );
+    BOOST_CHECK_EQUAL( lexer.NextTok(), DSN_RIGHT );
+    BOOST_CHECK_EQUAL( lexer.NextTok(), DSN_LEFT );
+
+    lexer.NextTok();
+    BOOST_CHECK_EQUAL( std::string( lexer.CurText() ), std::string( "e" ) );
+
+    DSNLEXER unterminated( "(a (b (c)\n", wxT( "test" ) );
+
+    unterminated.NextTok();
+    unterminated.NextTok();
+    unterminated.NextTok();
+
+    BOOST_CHECK_THROW( unterminated.SkipList(), IO_ERROR );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
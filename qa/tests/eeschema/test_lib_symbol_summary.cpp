@@ -0,0 +1,164 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one at
+ * http://www.gnu.org/licenses/
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <filesystem>
+
+#include <wx/dir.h>
+
+#include <lib_symbol.h>
+#include <lib_symbol_summary.h>
+#include <paths.h>
+#include <sch_io/kicad_sexpr/sch_io_kicad_sexpr.h>
+#include <symbol_lib_table.h>
+
+
+/**
+ * Tell whether the plugin parsed a library, rather than reading its index.
+ */
+class TEST_SCH_IO_KICAD_SEXPR : public SCH_IO_KICAD_SEXPR
+{
+public:
+    bool LibraryParsed() const { return m_cache != nullptr; }
+};
+
+
+static void checkSummary( LIB_SYMBOL_SUMMARY& aSummary, LIB_SYMBOL& aSymbol )
+{
+    BOOST_CHECK( aSummary.GetName() == aSymbol.GetName() );
+    BOOST_CHECK( aSummary.GetDesc() == aSymbol.GetDesc() );
+    BOOST_CHECK( aSummary.GetFootprint() == aSymbol.GetFootprint() );
+    BOOST_CHECK_EQUAL( aSummary.GetPinCount(), aSymbol.GetPinCount() );
+    BOOST_CHECK_EQUAL( aSummary.GetSubUnitCount(), aSymbol.GetSubUnitCount() );
+    BOOST_CHECK_EQUAL( aSummary.IsRoot(), aSymbol.IsRoot() );
+    BOOST_CHECK_EQUAL( aSummary.IsPower(), aSymbol.IsPower() );
+
+    for( int unit = 1; unit <= aSymbol.GetSubUnitCount(); ++unit )
+        BOOST_CHECK( aSummary.GetUnitDisplayName( unit ) == aSymbol.GetUnitDisplayName( unit ) );
+
+    std::map<wxString, wxString> summaryFields;
+    std::map<wxString, wxString> symbolFields;
+
+    aSummary.GetChooserFields( summaryFields );
+    aSymbol.GetChooserFields( symbolFields );
+
+    BOOST_CHECK( summaryFields == symbolFields );
+
+    std::vector<SEARCH_TERM> summaryTerms = aSummary.GetSearchTerms();
+    std::vector<SEARCH_TERM> symbolTerms = aSymbol.GetSearchTerms();
+
+    BOOST_REQUIRE_EQUAL( summaryTerms.size(), symbolTerms.size() );
+
+    for( size_t ii = 0; ii < summaryTerms.size(); ++ii )
+    {
+        BOOST_CHECK( summaryTerms[ii].Text == symbolTerms[ii].Text );
+        BOOST_CHECK_EQUAL( summaryTerms[ii].Score, symbolTerms[ii].Score );
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE( LibSymbolSummary )
+
+
+BOOST_AUTO_TEST_CASE( IndexMatchesSymbols )
+{
+    std::filesystem::path libPath = std::filesystem::temp_directory_path() / "SymIndex.kicad_sym";
+    std::filesystem::path cachePath = std::filesystem::temp_directory_path() / "SymIndexCache";
+
+    std::filesystem::remove_all( cachePath );
+    std::filesystem::copy_file( KI_TEST::GetEeschemaTestDataDir()
+                                        + "spice_netlists/legacy_pspice/schematic_libspice.kicad_sym",
+                                libPath, std::filesystem::copy_options::overwrite_existing );
+
+    // Keep the index out of the user's cache, also when a check below fails
+    struct CACHE_HOME_OVERRIDE
+    {
+        CACHE_HOME_OVERRIDE( const wxString& aPath )
+        {
+            m_hadCacheHome = wxGetEnv( wxT( "KICAD_CACHE_HOME" ), &m_oldCacheHome );
+            wxSetEnv( wxT( "KICAD_CACHE_HOME" ), aPath );
+        }
+
+        ~CACHE_HOME_OVERRIDE()
+        {
+            if( m_hadCacheHome )
+                wxSetEnv( wxT( "KICAD_CACHE_HOME" ), m_oldCacheHome );
+            else
+                wxUnsetEnv( wxT( "KICAD_CACHE_HOME" ) );
+        }
+
+        bool     m_hadCacheHome;
+        wxString m_oldCacheHome;
+    } cacheHomeOverride( cachePath.string() );
+
+    // Parses the library and writes its index
+    TEST_SCH_IO_KICAD_SEXPR         parsingPlugin;
+    std::vector<LIB_SYMBOL_SUMMARY> parsedSummaries;
+
+    parsingPlugin.EnumerateSymbolSummaries( parsedSummaries, libPath.string() );
+
+    BOOST_CHECK( parsingPlugin.LibraryParsed() );
+
+    wxFileName indexDir = wxFileName::DirName( PATHS::GetUserCachePath() );
+
+    indexDir.AppendDir( wxT( "symbol-index" ) );
+
+    BOOST_CHECK( indexDir.GetPath().StartsWith( wxString( cachePath.string() ) ) );
+    BOOST_REQUIRE( wxDir( indexDir.GetPath() ).HasFiles( wxT( "*.json" ) ) );
+
+    // Reads the index without parsing the library
+    TEST_SCH_IO_KICAD_SEXPR         indexedPlugin;
+    std::vector<LIB_SYMBOL_SUMMARY> indexedSummaries;
+
+    indexedPlugin.EnumerateSymbolSummaries( indexedSummaries, libPath.string() );
+
+    BOOST_CHECK( !indexedPlugin.LibraryParsed() );
+    BOOST_REQUIRE( !indexedSummaries.empty() );
+    BOOST_CHECK_EQUAL( indexedSummaries.size(), parsedSummaries.size() );
+
+    for( LIB_SYMBOL_SUMMARY& summary : indexedSummaries )
+    {
+        BOOST_TEST_CONTEXT( summary.GetName() )
+        {
+            LIB_SYMBOL* symbol = parsingPlugin.LoadSymbol( libPath.string(), summary.GetName() );
+
+            BOOST_REQUIRE( symbol );
+            checkSummary( summary, *symbol );
+        }
+    }
+
+    // Power symbols only
+    std::map<std::string, UTF8>     powerOnly = { { SYMBOL_LIB_TABLE::PropPowerSymsOnly, "" } };
+    std::vector<LIB_SYMBOL_SUMMARY> powerSummaries;
+
+    indexedPlugin.EnumerateSymbolSummaries( powerSummaries, libPath.string(), &powerOnly );
+
+    for( const LIB_SYMBOL_SUMMARY& summary : powerSummaries )
+        BOOST_CHECK( summary.IsPower() );
+
+    BOOST_CHECK( !indexedPlugin.LibraryParsed() );
+
+    std::filesystem::remove( libPath );
+    std::filesystem::remove_all( cachePath );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
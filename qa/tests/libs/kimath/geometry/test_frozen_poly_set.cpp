@@ -0,0 +1,102 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <geometry/frozen_poly_set.h>
+
+#include "fixtures_geometry.h"
+
+
+static void checkSame( const SHAPE_POLY_SET& aA, const SHAPE_POLY_SET& aB )
+{
+    BOOST_REQUIRE_EQUAL( aA.OutlineCount(), aB.OutlineCount() );
+
+    for( int ii = 0; ii < aA.OutlineCount(); ii++ )
+    {
+        BOOST_REQUIRE_EQUAL( aA.CPolygon( ii ).size(), aB.CPolygon( ii ).size() );
+
+        for( size_t jj = 0; jj < aA.CPolygon( ii ).size(); jj++ )
+        {
+            const SHAPE_LINE_CHAIN& chainA = aA.CPolygon( ii )[jj];
+            const SHAPE_LINE_CHAIN& chainB = aB.CPolygon( ii )[jj];
+
+            BOOST_CHECK( chainA.CPoints() == chainB.CPoints() );
+            BOOST_CHECK( chainA.CShapes() == chainB.CShapes() );
+            BOOST_CHECK( chainA.CArcs() == chainB.CArcs() );
+            BOOST_CHECK( chainB.IsClosed() );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE( FrozenPolySet )
+
+
+BOOST_AUTO_TEST_CASE( RoundTrip )
+{
+    KI_TEST::CommonTestData testData;
+
+    for( FROZEN_POLY_SET::ENCODING encoding : { FROZEN_POLY_SET::ENCODING::PLAIN,
+                                                FROZEN_POLY_SET::ENCODING::DELTA_VARINT } )
+    {
+        for( const SHAPE_POLY_SET& polySet : { testData.emptyPolySet,
+                                               testData.uniqueVertexPolySet,
+                                               testData.holeyPolySet,
+                                               testData.holeyCurvedPolyMulti } )
+        {
+            FROZEN_POLY_SET frozen( polySet, encoding );
+
+            BOOST_CHECK_EQUAL( frozen.OutlineCount(), polySet.OutlineCount() );
+            BOOST_CHECK_EQUAL( frozen.TotalVertices(), polySet.TotalVertices() );
+            BOOST_CHECK( frozen.BBox() == polySet.BBox() );
+
+            checkSame( polySet, frozen.Thaw() );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( DeltaEncodingIsSmaller )
+{
+    // A fill-like outline: many short edges, far from the origin, with extreme coordinates
+    SHAPE_POLY_SET polySet;
+    polySet.NewOutline();
+
+    for( int ii = 0; ii < 10000; ii++ )
+        polySet.Append( 100000000 + ii * 50, 200000000 + ( ii % 7 ) * 9 );
+
+    polySet.Append( std::numeric_limits<int>::max(), std::numeric_limits<int>::lowest() );
+    polySet.Append( std::numeric_limits<int>::lowest(), std::numeric_limits<int>::max() );
+
+    FROZEN_POLY_SET plain( polySet, FROZEN_POLY_SET::ENCODING::PLAIN );
+    FROZEN_POLY_SET delta( polySet, FROZEN_POLY_SET::ENCODING::DELTA_VARINT );
+
+    checkSame( polySet, delta.Thaw() );
+    checkSame( polySet, plain.Thaw() );
+
+    BOOST_CHECK_LT( delta.MemoryUsage(), plain.MemoryUsage() / 2 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
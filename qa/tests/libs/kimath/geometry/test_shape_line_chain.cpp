@@ -1247,4 +1247,216 @@ BOOST_AUTO_TEST_CASE( ReplaceChain )
 }
 
 
+
+/**
+ * The point queries specialised for SHAPE_LINE_CHAIN must agree with the generic
+ * SHAPE_LINE_CHAIN_BASE implementations.
+ */
+BOOST_AUTO_TEST_CASE( PointQueriesMatchBase )
+{
+    SHAPE_LINE_CHAIN chain;
+
+    // A star-like, non-convex outline with horizontal and vertical edges thrown in
+    for( int i = 0; i < 24; i++ )
+    {
+        int r = ( i % 2 ) ? 40000 : 100000;
+
+        VECTOR2I p( r, 0 );
+        RotatePoint( p, EDA_ANGLE( 15.0 * i, DEGREES_T ) );
+        chain.Append( p );
+
+        if( i % 6 == 0 )
+            chain.Append( p.x, p.y + 20000 );
+    }
+
+    for( bool closed : { true, false } )
+    {
+        chain.SetClosed( closed );
+        chain.GenerateBBoxCache();
+
+        const SHAPE_LINE_CHAIN_BASE& base = chain;
+
+        for( int x = -120000; x <= 120000; x += 7919 )
+        {
+            for( int y = -120000; y <= 120000; y += 7717 )
+            {
+                const VECTOR2I pt( x, y );
+
+                BOOST_CHECK_EQUAL( chain.PointInside( pt ),
+                                   base.SHAPE_LINE_CHAIN_BASE::PointInside( pt ) );
+                BOOST_CHECK_EQUAL( chain.PointInside( pt, 5000, true ),
+                                   base.SHAPE_LINE_CHAIN_BASE::PointInside( pt, 5000, true ) );
+                BOOST_CHECK_EQUAL( chain.SquaredDistance( pt ),
+                                   base.SHAPE_LINE_CHAIN_BASE::SquaredDistance( pt ) );
+
+                int      actual = -1, baseActual = -1;
+                VECTOR2I location, baseLocation;
+
+                BOOST_CHECK_EQUAL( chain.Collide( pt, 10000, &actual, &location ),
+                                   base.SHAPE_LINE_CHAIN_BASE::Collide( pt, 10000, &baseActual,
+                                                                        &baseLocation ) );
+                BOOST_CHECK_EQUAL( actual, baseActual );
+                BOOST_CHECK_EQUAL( location, baseLocation );
+            }
+        }
+    }
+}
+
+
+/**
+ * PointInside() on a large chain with its caches built goes through the edge index, which
+ * must give the same answers as the plain scan.
+ */
+BOOST_AUTO_TEST_CASE( IndexedPointInside )
+{
+    SHAPE_LINE_CHAIN chain;
+
+    // A jagged star with 720 vertices, including horizontal steps
+    for( int i = 0; i < 360; i++ )
+    {
+        VECTOR2I p( ( i % 3 ) ? 100000 : 60000, 0 );
+        RotatePoint( p, EDA_ANGLE( i, DEGREES_T ) );
+        chain.Append( p );
+        chain.Append( p.x + 3000, p.y );
+    }
+
+    chain.SetClosed( true );
+
+    SHAPE_LINE_CHAIN uncached = chain;
+    chain.GenerateBBoxCache();
+
+    for( int x = -110000; x <= 110000; x += 1777 )
+    {
+        for( int y = -110000; y <= 110000; y += 1913 )
+        {
+            const VECTOR2I pt( x, y );
+
+            BOOST_CHECK_EQUAL( chain.PointInside( pt, 0, true ), uncached.PointInside( pt ) );
+            BOOST_CHECK_EQUAL( chain.PointInside( pt, 2500, true ),
+                               uncached.PointInside( pt, 2500 ) );
+        }
+    }
+
+    // Vertices and edges themselves
+    for( int i = 0; i < chain.PointCount(); i += 7 )
+    {
+        const VECTOR2I pt = chain.CPoint( i );
+
+        BOOST_CHECK_EQUAL( chain.PointInside( pt, 0, true ), uncached.PointInside( pt ) );
+        BOOST_CHECK_EQUAL( chain.PointInside( pt, 10, true ), uncached.PointInside( pt, 10 ) );
+    }
+
+    // Editing the chain drops the index
+    chain.Move( VECTOR2I( 50000, 0 ) );
+    uncached.Move( VECTOR2I( 50000, 0 ) );
+
+    BOOST_CHECK_EQUAL( chain.PointInside( VECTOR2I( 50000, 0 ), 0, true ),
+                       uncached.PointInside( VECTOR2I( 50000, 0 ) ) );
+}
+
+
+/**
+ * A comb whose teeth run over its whole height: the edges of the teeth span every band of the
+ * edge index and are kept in its long edge list, which must give the same answers.
+ */
+BOOST_AUTO_TEST_CASE( IndexedPointInsideLongEdges )
+{
+    SHAPE_LINE_CHAIN chain;
+
+    for( int i = 0; i < 100; i++ )
+    {
+        chain.Append( i * 2000, 0 );
+        chain.Append( i * 2000, 100000 );
+        chain.Append( i * 2000 + 1000, 100000 );
+        chain.Append( i * 2000 + 1000, 1000 );
+    }
+
+    chain.Append( 200000, 1000 );
+    chain.Append( 200000, -1000 );
+    chain.Append( 0, -1000 );
+    chain.SetClosed( true );
+
+    SHAPE_LINE_CHAIN uncached = chain;
+    chain.GenerateBBoxCache();
+
+    for( int x = -1100; x <= 201000; x += 333 )
+    {
+        for( int y = -2000; y <= 101000; y += 4999 )
+        {
+            const VECTOR2I pt( x, y );
+
+            BOOST_CHECK_EQUAL( chain.PointInside( pt, 0, true ), uncached.PointInside( pt ) );
+            BOOST_CHECK_EQUAL( chain.PointInside( pt, 200, true ),
+                               uncached.PointInside( pt, 200 ) );
+        }
+    }
+}
+
+
+/**
+ * Edits which keep the number of points must drop the edge index too.
+ */
+BOOST_AUTO_TEST_CASE( IndexedPointInsideAfterEdit )
+{
+    SHAPE_LINE_CHAIN star;
+
+    for( int i = 0; i < 360; i++ )
+    {
+        VECTOR2I p( ( i % 3 ) ? 100000 : 60000, 0 );
+        RotatePoint( p, EDA_ANGLE( i, DEGREES_T ) );
+        star.Append( p );
+        star.Append( p.x + 3000, p.y );
+    }
+
+    star.SetClosed( true );
+
+    auto checkIndex =
+            []( const SHAPE_LINE_CHAIN& aChain )
+            {
+                for( int x = -110000; x <= 110000; x += 1777 )
+                {
+                    for( int y = -110000; y <= 110000; y += 1913 )
+                    {
+                        const VECTOR2I pt( x, y );
+
+                        BOOST_CHECK_EQUAL( aChain.PointInside( pt, 0, true ),
+                                           aChain.PointInside( pt ) );
+                    }
+                }
+            };
+
+    // A vertex replaced by a point closer to the centre, which notches the outline but stays
+    // within the cached bounding box
+    SHAPE_LINE_CHAIN chain = star;
+    VECTOR2I         pt = chain.CPoint( 30 );
+
+    chain.GenerateBBoxCache();
+    chain.Replace( 30, 30, VECTOR2I( pt.x / 4, pt.y / 4 ) );
+
+    BOOST_REQUIRE_EQUAL( chain.PointCount(), star.PointCount() );
+    checkIndex( chain );
+
+    // Two vertices replaced by a line of two points
+    chain = star;
+    chain.GenerateBBoxCache();
+
+    SHAPE_LINE_CHAIN notch( { VECTOR2I( chain.CPoint( 60 ).x / 4, chain.CPoint( 60 ).y / 4 ),
+                              VECTOR2I( chain.CPoint( 61 ).x / 4, chain.CPoint( 61 ).y / 4 ) } );
+
+    chain.Replace( 60, 61, notch );
+
+    BOOST_REQUIRE_EQUAL( chain.PointCount(), star.PointCount() );
+    checkIndex( chain );
+
+    // A duplicate point removed, then another point appended
+    chain = star;
+    chain.Insert( 90, chain.CPoint( 90 ) );
+    chain.GenerateBBoxCache();
+    chain.RemoveDuplicatePoints();
+    chain.Append( VECTOR2I( 0, 0 ) );
+
+    BOOST_REQUIRE_EQUAL( chain.PointCount(), star.PointCount() + 1 );
+    checkIndex( chain );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
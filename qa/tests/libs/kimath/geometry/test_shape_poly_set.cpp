@@ -15,6 +15,7 @@
  *
  */
 
+#include <bs_thread_pool.hpp>
 #include <geometry/shape_poly_set.h>
 #include <trigo.h>
 
@@ -163,4 +164,310 @@ BOOST_AUTO_TEST_CASE( GetNeighbourIndexes_MultiOutline )
     BOOST_TEST( !ok );
 }
 
+
+/**
+ * The parallel boolean engine must give the same polygons as the single threaded one.
+ */
+BOOST_AUTO_TEST_CASE( ParallelBooleans )
+{
+    auto addSquare =
+            []( SHAPE_POLY_SET& aSet, int aX, int aY, int aSize )
+            {
+                aSet.NewOutline();
+                aSet.Append( aX, aY );
+                aSet.Append( aX + aSize, aY );
+                aSet.Append( aX + aSize, aY + aSize );
+                aSet.Append( aX, aY + aSize );
+            };
+
+    SHAPE_POLY_SET base;
+    SHAPE_POLY_SET knockouts;
+
+    // Separate tiles, each holding a group of overlapping and touching squares
+    for( int x = 0; x < 40; x++ )
+    {
+        for( int y = 0; y < 40; y++ )
+        {
+            addSquare( base, x * 1000 - 100, y * 1000 - 100, 900 );
+            addSquare( knockouts, x * 1000, y * 1000, 400 );
+            addSquare( knockouts, x * 1000 + 200, y * 1000 + 200, 400 );
+            addSquare( knockouts, x * 1000 + 600, y * 1000 + 200, 100 );
+        }
+    }
+
+    BS::thread_pool tp( 4 );
+
+    SHAPE_POLY_SET serialAdd, parallelAdd;
+    serialAdd.BooleanAdd( knockouts );
+    parallelAdd.BooleanAdd( knockouts, tp );
+
+    BOOST_CHECK_EQUAL( parallelAdd.OutlineCount(), serialAdd.OutlineCount() );
+    BOOST_CHECK_EQUAL( parallelAdd.FullPointCount(), serialAdd.FullPointCount() );
+    BOOST_CHECK_CLOSE( parallelAdd.Area(), serialAdd.Area(), 1e-9 );
+
+    SHAPE_POLY_SET serialSub = base;
+    SHAPE_POLY_SET parallelSub = base;
+    serialSub.BooleanSubtract( knockouts );
+    parallelSub.BooleanSubtract( knockouts, tp );
+
+    BOOST_CHECK_EQUAL( parallelSub.OutlineCount(), serialSub.OutlineCount() );
+    BOOST_CHECK_EQUAL( parallelSub.FullPointCount(), serialSub.FullPointCount() );
+    BOOST_CHECK_CLOSE( parallelSub.Area(), serialSub.Area(), 1e-9 );
+}
+
+
+/**
+ * A single pour with thousands of knockouts forms one cluster, which the parallel engine cuts
+ * into strips.  Once stitched back, the result must match the single threaded one to within
+ * the rounding of the points added on the strip boundaries.
+ */
+BOOST_AUTO_TEST_CASE( ParallelBooleansSingleCluster )
+{
+    auto addPolygon =
+            []( SHAPE_POLY_SET& aSet, int aX, int aY, int aRadius, int aSides )
+            {
+                aSet.NewOutline();
+
+                for( int ii = 0; ii < aSides; ii++ )
+                {
+                    double angle = 2.0 * M_PI * ( ii + 0.5 ) / aSides;
+                    aSet.Append( aX + KiROUND( aRadius * cos( angle ) ),
+                                 aY + KiROUND( aRadius * sin( angle ) ) );
+                }
+            };
+
+    SHAPE_POLY_SET pour;
+    SHAPE_POLY_SET knockouts;
+
+    pour.NewOutline();
+    pour.Append( -1000, -1000 );
+    pour.Append( 43000, -1000 );
+    pour.Append( 43000, 43000 );
+    pour.Append( -1000, 43000 );
+
+    // Overlapping knockouts, all chained together
+    for( int x = 0; x < 60; x++ )
+    {
+        for( int y = 0; y < 60; y++ )
+            addPolygon( knockouts, x * 700 + ( y % 3 ) * 100, y * 700, 400, 16 );
+    }
+
+    BS::thread_pool tp( 4 );
+
+    auto checkSame =
+            []( SHAPE_POLY_SET& aSerial, SHAPE_POLY_SET& aParallel )
+            {
+                int serialHoles = 0;
+                int parallelHoles = 0;
+
+                for( int ii = 0; ii < aSerial.OutlineCount(); ii++ )
+                    serialHoles += aSerial.HoleCount( ii );
+
+                for( int ii = 0; ii < aParallel.OutlineCount(); ii++ )
+                    parallelHoles += aParallel.HoleCount( ii );
+
+                BOOST_CHECK_EQUAL( aParallel.OutlineCount(), aSerial.OutlineCount() );
+                BOOST_CHECK_EQUAL( parallelHoles, serialHoles );
+                BOOST_CHECK_CLOSE( aParallel.Area(), aSerial.Area(), 1e-4 );
+
+                SHAPE_POLY_SET difference;
+                difference.BooleanXor( aSerial, aParallel );
+
+                BOOST_CHECK_LT( difference.Area(), 1e-6 * aSerial.Area() );
+            };
+
+    SHAPE_POLY_SET serialSub = pour;
+    SHAPE_POLY_SET parallelSub = pour;
+    serialSub.BooleanSubtract( knockouts );
+    parallelSub.BooleanSubtract( knockouts, tp );
+
+    checkSame( serialSub, parallelSub );
+
+    SHAPE_POLY_SET serialAdd, parallelAdd;
+    serialAdd.BooleanAdd( knockouts );
+    parallelAdd.BooleanAdd( knockouts, tp );
+
+    checkSame( serialAdd, parallelAdd );
+
+    // The strips don't depend on the thread count
+    BS::thread_pool tp2( 2 );
+    SHAPE_POLY_SET  otherSub = pour;
+    otherSub.BooleanSubtract( knockouts, tp2 );
+
+    BOOST_CHECK_EQUAL( otherSub.FullPointCount(), parallelSub.FullPointCount() );
+    BOOST_CHECK_EQUAL( otherSub.Area(), parallelSub.Area() );
+}
+
+
+BOOST_AUTO_TEST_CASE( ParallelTriangulation )
+{
+    auto square =
+            []( int aX, int aY, int aSize, bool aHole = false )
+            {
+                SHAPE_LINE_CHAIN chain( std::vector<VECTOR2I>{ VECTOR2I( aX, aY ),
+                                                               VECTOR2I( aX + aSize, aY ),
+                                                               VECTOR2I( aX + aSize, aY + aSize ),
+                                                               VECTOR2I( aX, aY + aSize ) },
+                                        true );
+
+                if( aHole )
+                    chain = chain.Reverse();
+
+                return chain;
+            };
+
+    auto checkSame =
+            []( const SHAPE_POLY_SET& aExpected, const SHAPE_POLY_SET& aActual )
+            {
+                BOOST_REQUIRE( aActual.IsTriangulationUpToDate() );
+                BOOST_REQUIRE_EQUAL( aActual.TriangulatedPolyCount(),
+                                     aExpected.TriangulatedPolyCount() );
+
+                for( unsigned ii = 0; ii < aExpected.TriangulatedPolyCount(); ii++ )
+                {
+                    const auto* expected = aExpected.TriangulatedPolygon( ii );
+                    const auto* actual = aActual.TriangulatedPolygon( ii );
+
+                    BOOST_CHECK_EQUAL( actual->GetSourceOutlineIndex(),
+                                       expected->GetSourceOutlineIndex() );
+                    BOOST_CHECK( actual->Vertices() == expected->Vertices() );
+                    BOOST_REQUIRE_EQUAL( actual->GetTriangleCount(),
+                                         expected->GetTriangleCount() );
+
+                    for( size_t jj = 0; jj < expected->GetTriangleCount(); jj++ )
+                    {
+                        BOOST_CHECK_EQUAL( actual->Triangles()[jj].a, expected->Triangles()[jj].a );
+                        BOOST_CHECK_EQUAL( actual->Triangles()[jj].b, expected->Triangles()[jj].b );
+                        BOOST_CHECK_EQUAL( actual->Triangles()[jj].c, expected->Triangles()[jj].c );
+                    }
+                }
+            };
+
+    // Large enough to be split into a few dozen cells of the 1cm triangulation grid
+    SHAPE_POLY_SET fill( square( 0, 0, 60000000 ) );
+
+    for( int x = 0; x < 6; x++ )
+    {
+        for( int y = 0; y < 6; y++ )
+            fill.AddHole( square( x * 10000000 + 3000000, y * 10000000 + 3000000, 2000000, true ) );
+    }
+
+    fill.AddOutline( square( 70000000, 0, 5000000 ) );
+
+    BS::thread_pool tp( 4 );
+
+    SHAPE_POLY_SET serial = fill.CloneDropTriangulation();
+    SHAPE_POLY_SET parallel = fill.CloneDropTriangulation();
+    serial.CacheTriangulation();
+    parallel.CacheTriangulation( tp );
+
+    BOOST_CHECK_GT( serial.TriangulatedPolyCount(), 30u );
+    checkSame( serial, parallel );
+
+    // Nothing changed: every partition is taken from the previous triangulation
+    SHAPE_POLY_SET unchanged = fill.CloneDropTriangulation();
+
+    BOOST_CHECK_EQUAL( unchanged.CacheTriangulation( tp, &parallel ),
+                       (size_t) parallel.TriangulatedPolyCount() );
+    checkSame( serial, unchanged );
+
+    // An edit to one corner: the cells elsewhere are taken from the previous triangulation
+    SHAPE_POLY_SET edited = fill.CloneDropTriangulation();
+    edited.AddHole( square( 500000, 500000, 1000000, true ), 0 );
+
+    SHAPE_POLY_SET editedSerial = edited.CloneDropTriangulation();
+    editedSerial.CacheTriangulation();
+    size_t editedReused = edited.CacheTriangulation( tp, &parallel );
+
+    BOOST_CHECK_GT( editedReused, 0u );
+    BOOST_CHECK_LT( editedReused, (size_t) edited.TriangulatedPolyCount() );
+    checkSame( editedSerial, edited );
+
+    // Unchanged polygons are taken over whole, wherever they are in the set
+    SHAPE_POLY_SET reordered( square( 80000000, 0, 5000000 ) );
+    reordered.AddPolygon( fill.CPolygon( 0 ) );
+
+    SHAPE_POLY_SET reorderedSerial = reordered.CloneDropTriangulation();
+    reorderedSerial.CacheTriangulation();
+
+    size_t reorderedReused = reordered.CacheTriangulation( tp, &parallel );
+    size_t movedPartitions = 0;
+
+    for( unsigned ii = 0; ii < reordered.TriangulatedPolyCount(); ii++ )
+    {
+        if( reordered.TriangulatedPolygon( ii )->GetSourceOutlineIndex() == 1 )
+            movedPartitions++;
+    }
+
+    BOOST_CHECK_EQUAL( reorderedReused, movedPartitions );
+    checkSame( reorderedSerial, reordered );
+}
+
+
+BOOST_AUTO_TEST_CASE( FractureAlgorithms )
+{
+    using FRACTURE_ALGO = SHAPE_POLY_SET::FRACTURE_ALGO;
+
+    SHAPE_POLY_SET poly;
+
+    // Two outlines with staggered rows of holes, so that holes get bridged to other holes as
+    // well as to the outline
+    for( int outline = 0; outline < 2; outline++ )
+    {
+        int x0 = outline * 2000000;
+
+        poly.NewOutline();
+        poly.Append( x0, 0 );
+        poly.Append( x0 + 1500000, 0 );
+        poly.Append( x0 + 1500000, 1500000 );
+        poly.Append( x0, 1500000 );
+
+        for( int x = 0; x < 12; x++ )
+        {
+            for( int y = 0; y < 12; y++ )
+            {
+                int cx = x0 + 100000 + x * 110000 + ( y % 2 ) * 40000;
+                int cy = 100000 + y * 110000;
+
+                SHAPE_LINE_CHAIN hole;
+
+                for( int ii = 5; ii >= 0; ii-- )
+                {
+                    VECTOR2I pt( 30000, 0 );
+                    RotatePoint( pt, EDA_ANGLE( 60.0 * ii + x + y, DEGREES_T ) );
+                    hole.Append( pt + VECTOR2I( cx, cy ) );
+                }
+
+                hole.SetClosed( true );
+                poly.AddHole( hole, outline );
+            }
+        }
+    }
+
+    SHAPE_POLY_SET linear = poly;
+    SHAPE_POLY_SET indexed = poly;
+    SHAPE_POLY_SET slow = poly;
+    SHAPE_POLY_SET parallel = poly;
+    BS::thread_pool tp( 4 );
+
+    linear.Fracture( FRACTURE_ALGO::LINEAR );
+    indexed.Fracture( FRACTURE_ALGO::INDEXED );
+    slow.Fracture( FRACTURE_ALGO::SLOW );
+    parallel.Fracture( tp );
+
+    BOOST_REQUIRE_EQUAL( linear.OutlineCount(), 2 );
+    BOOST_CHECK( !linear.HasHoles() );
+    BOOST_CHECK_CLOSE( linear.Area(), slow.Area(), 1e-6 );
+
+    // The indexed bridging must pick exactly the same edges as the linear scan
+    BOOST_REQUIRE_EQUAL( indexed.OutlineCount(), linear.OutlineCount() );
+    BOOST_REQUIRE_EQUAL( parallel.OutlineCount(), linear.OutlineCount() );
+
+    for( int ii = 0; ii < linear.OutlineCount(); ii++ )
+    {
+        BOOST_CHECK( indexed.COutline( ii ).CPoints() == linear.COutline( ii ).CPoints() );
+        BOOST_CHECK( parallel.COutline( ii ).CPoints() == linear.COutline( ii ).CPoints() );
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
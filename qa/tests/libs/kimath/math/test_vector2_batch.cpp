@@ -0,0 +1,122 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+// Code under test
+#include <math/vector2_batch.h>
+
+#include <random>
+#include <trigo.h>
+
+
+/**
+ * Random points, in a number which exercises both the vector kernels and the scalar tails.
+ */
+static std::vector<VECTOR2I> randomPoints( size_t aCount, int aRange, unsigned aSeed )
+{
+    std::mt19937                       rng( aSeed );
+    std::uniform_int_distribution<int> coord( -aRange, aRange );
+    std::vector<VECTOR2I>              points;
+
+    for( size_t ii = 0; ii < aCount; ii++ )
+        points.emplace_back( coord( rng ), coord( rng ) );
+
+    return points;
+}
+
+
+BOOST_AUTO_TEST_SUITE( VECTOR2_BATCH )
+
+
+BOOST_AUTO_TEST_CASE( BoundingBoxMatchesCompute )
+{
+    BOOST_CHECK( BoundingBox( nullptr, 0 ) == BOX2I() );
+
+    for( size_t count : { 1, 2, 3, 4, 5, 17, 1000 } )
+    {
+        std::vector<VECTOR2I> points = randomPoints( count, 1000000000, count );
+        BOX2I                 expected;
+
+        expected.Compute( points );
+
+        BOOST_CHECK( BoundingBox( points.data(), points.size() ) == expected );
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( TransformsMatchScalar )
+{
+    const VECTOR2I centre( 12345, -67890 );
+
+    for( size_t count : { 1, 2, 7, 256 } )
+    {
+        std::vector<VECTOR2I> points = randomPoints( count, 100000000, 7 * count );
+
+        std::vector<VECTOR2I> moved = points;
+        MovePoints( moved.data(), moved.size(), centre );
+
+        std::vector<VECTOR2I> mirrored = points;
+        MirrorPoints( mirrored.data(), mirrored.size(), centre, FLIP_DIRECTION::TOP_BOTTOM );
+
+        for( size_t ii = 0; ii < count; ii++ )
+        {
+            BOOST_CHECK( moved[ii] == points[ii] + centre );
+            BOOST_CHECK( mirrored[ii] == VECTOR2I( points[ii].x, 2 * centre.y - points[ii].y ) );
+        }
+
+        for( double degrees : { 0.0, 90.0, 180.0, -90.0, 30.0, 45.0, 123.4, -0.1, 720.0 } )
+        {
+            EDA_ANGLE             angle( degrees, DEGREES_T );
+            std::vector<VECTOR2I> rotated = points;
+
+            RotatePoints( rotated.data(), rotated.size(), centre, angle );
+
+            for( size_t ii = 0; ii < count; ii++ )
+            {
+                VECTOR2I expected = points[ii];
+                RotatePoint( expected, centre, angle );
+
+                BOOST_CHECK( rotated[ii] == expected );
+            }
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( NearestPointFindsTheLastClosest )
+{
+    std::vector<VECTOR2I> points = { { 10, 0 }, { 0, 5 }, { -5, 0 }, { 100, 100 } };
+    int64_t               distSq = std::numeric_limits<int64_t>::max();
+
+    BOOST_CHECK_EQUAL( NearestPoint( points.data(), points.size(), { 0, 0 }, distSq ), 2 );
+    BOOST_CHECK_EQUAL( distSq, 25 );
+
+    // Nothing closer than what was already found
+    distSq = 24;
+    BOOST_CHECK_EQUAL( NearestPoint( points.data(), points.size(), { 0, 0 }, distSq ), -1 );
+    BOOST_CHECK_EQUAL( distSq, 24 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,114 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <bs_thread_pool.hpp>
+#include <convert_basic_shapes_to_polygon.h>
+
+
+/**
+ * Build a set of pad-like shapes at various positions and rotations.
+ */
+static SHAPE_POLY_SET buildShapes( int aSeed )
+{
+    SHAPE_POLY_SET   shapes;
+    SHAPE_LINE_CHAIN circle;
+
+    for( int ii = 0; ii < 40; ii++ )
+    {
+        VECTOR2I  pos( 1000000 * ii + aSeed, -700000 * ii );
+        EDA_ANGLE rot( 15.0 * ( ii % 7 ), DEGREES_T );
+        ERROR_LOC errorLoc = ii % 2 ? ERROR_INSIDE : ERROR_OUTSIDE;
+        int       size = 500000 + 100000 * ( ii % 3 );
+
+        TransformCircleToPolygon( circle, pos, size / 2, 5000, errorLoc );
+        TransformCircleToPolygon( shapes, pos, size / 2, 5000, errorLoc, 16 );
+        TransformOvalToPolygon( shapes, pos, pos + VECTOR2I( 300000, 200000 * ( ii % 3 - 1 ) ),
+                                size, 5000, errorLoc );
+        TransformTrapezoidToPolygon( shapes, pos, VECTOR2I( size, 2 * size ), rot, 0, size / 4,
+                                     ii % 4 * 10000, 5000, errorLoc );
+        TransformRoundChamferedRectToPolygon( shapes, pos, VECTOR2I( 2 * size, size ), rot,
+                                              size / 5, 0.25, ii % 16, ii % 3 * 10000, 5000,
+                                              errorLoc );
+    }
+
+    shapes.AddOutline( circle );
+    return shapes;
+}
+
+
+static void checkSame( const SHAPE_POLY_SET& aA, const SHAPE_POLY_SET& aB )
+{
+    BOOST_REQUIRE_EQUAL( aA.OutlineCount(), aB.OutlineCount() );
+
+    for( int ii = 0; ii < aA.OutlineCount(); ii++ )
+    {
+        BOOST_REQUIRE_EQUAL( aA.CPolygon( ii ).size(), aB.CPolygon( ii ).size() );
+        BOOST_CHECK( aA.COutline( ii ).CPoints() == aB.COutline( ii ).CPoints() );
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE( ConvertBasicShapesToPolygon )
+
+
+/**
+ * The approximations served from the cache must be identical to freshly built ones.
+ */
+BOOST_AUTO_TEST_CASE( ApproximationCache )
+{
+    SetApproximationCacheSize( 0 );
+    SHAPE_POLY_SET reference = buildShapes( 0 );
+
+    SetApproximationCacheSize( 4096 );
+    SHAPE_POLY_SET cold = buildShapes( 0 );
+    SHAPE_POLY_SET hot = buildShapes( 0 );
+
+    checkSame( cold, reference );
+    checkSame( hot, reference );
+
+    // A cache too small for the shapes keeps evicting them
+    SetApproximationCacheSize( 3 );
+    checkSame( buildShapes( 0 ), reference );
+
+    // Concurrent lookups
+    SetApproximationCacheSize( 4096 );
+    BS::thread_pool             tp( 4 );
+    std::vector<SHAPE_POLY_SET> results( 16 );
+
+    for( size_t ii = 0; ii < results.size(); ii++ )
+        tp.push_task( [&, ii]() { results[ii] = buildShapes( 0 ); } );
+
+    tp.wait_for_tasks();
+
+    for( const SHAPE_POLY_SET& result : results )
+        checkSame( result, reference );
+
+    // Moved shapes are the reference shapes, moved
+    SHAPE_POLY_SET moved = buildShapes( 123 );
+    reference.Move( VECTOR2I( 123, 0 ) );
+    checkSame( moved, reference );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
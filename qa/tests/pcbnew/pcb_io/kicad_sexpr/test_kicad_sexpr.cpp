@@ -21,7 +21,12 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <algorithm>
 #include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <set>
 #include <string>
 
 #include <pcbnew_utils/board_test_utils.h>
@@ -29,10 +34,21 @@
 #include <qa_utils/wx_utils/unit_test_utils.h>
 
 #include <pcbnew/pcb_io/kicad_sexpr/pcb_io_kicad_sexpr.h>
+#include <pcbnew/pcb_io/kicad_sexpr/pcb_io_kicad_sexpr_fill_cache.h>
+#include <pcbnew/pcb_io/kicad_sexpr/pcb_io_kicad_sexpr_parser.h>
 
 #include <board.h>
+#include <font/font.h>
+#include <footprint.h>
+#include <paths.h>
+#include <pcb_track.h>
+#include <richio.h>
+#include <thread_pool.h>
 #include <zone.h>
 
+#include <wx/dir.h>
+#include <wx/filename.h>
+
 
 struct KICAD_SEXPR_FIXTURE
 {
@@ -100,4 +116,439 @@ BOOST_AUTO_TEST_CASE( Issue19775_ZoneLayerWildcards )
 }
 
 
+/**
+ * Check that the parallel loader builds the same board as the serial parser
+ */
+BOOST_AUTO_TEST_CASE( ParallelLoadMatchesSerial )
+{
+    // The parallel loader needs several threads, and is not used on small or old boards
+    if( GetKiCadThreadPool().get_thread_count() < 2 )
+        return;
+
+    for( const std::string name : { "issue5093", "issue5102" } )
+    {
+        BOOST_TEST_CONTEXT( name )
+        {
+            std::string   path = KI_TEST::GetPcbnewTestDataDir() + name + ".kicad_pcb";
+            std::ifstream file( path, std::ios::binary );
+            std::string   text( std::istreambuf_iterator<char>{ file }, {} );
+
+            std::unique_ptr<BOARD> parallelBoard(
+                    PCB_IO_KICAD_SEXPR_PARSER::ParseBoardInParallel( text, path, nullptr ) );
+
+            BOOST_REQUIRE( parallelBoard );
+
+            STRING_LINE_READER        reader( text, path );
+            PCB_IO_KICAD_SEXPR_PARSER parser( &reader, nullptr, nullptr );
+            std::unique_ptr<BOARD>    serialBoard( dynamic_cast<BOARD*>( parser.Parse() ) );
+
+            BOOST_REQUIRE( serialBoard );
+
+            kicadPlugin.Format( serialBoard.get() );
+            std::string serialText = kicadPlugin.GetStringOutput( true );
+
+            kicadPlugin.Format( parallelBoard.get() );
+            std::string parallelText = kicadPlugin.GetStringOutput( true );
+
+            BOOST_CHECK( serialText == parallelText );
+        }
+    }
+}
+
+
+/**
+ * Check that the items of a large board are formatted in parallel in the same order and with
+ * the same text as when they are formatted one after the other
+ */
+BOOST_AUTO_TEST_CASE( ParallelSaveMatchesSerial )
+{
+    std::string            path = KI_TEST::GetPcbnewTestDataDir() + "issue3812.kicad_pcb";
+    std::unique_ptr<BOARD> board( kicadPlugin.LoadBoard( path, nullptr ) );
+
+    BOOST_REQUIRE( board );
+
+    // Take the parallel path whatever the size of the thread pool, and with many small chunks
+    kicadPlugin.SetParallelSaveMinItems( 64 );
+    kicadPlugin.Format( board.get() );
+    std::string boardText = kicadPlugin.GetStringOutput( true );
+
+    std::set<BOARD_ITEM*, BOARD_ITEM::ptr_cmp> footprints( board->Footprints().begin(),
+                                                           board->Footprints().end() );
+    std::set<BOARD_ITEM*, BOARD_ITEM::ptr_cmp> drawings( board->Drawings().begin(),
+                                                         board->Drawings().end() );
+    std::set<PCB_TRACK*, PCB_TRACK::cmp_tracks> tracks( board->Tracks().begin(),
+                                                        board->Tracks().end() );
+    std::set<BOARD_ITEM*, BOARD_ITEM::ptr_cmp> zones( board->Zones().begin(),
+                                                      board->Zones().end() );
+
+    BOOST_REQUIRE_GE( footprints.size() + drawings.size() + tracks.size() + zones.size(), 2000 );
+
+    for( BOARD_ITEM* item : footprints )
+        kicadPlugin.Format( item );
+
+    for( BOARD_ITEM* item : drawings )
+        kicadPlugin.Format( item );
+
+    for( PCB_TRACK* track : tracks )
+        kicadPlugin.Format( track );
+
+    for( BOARD_ITEM* item : zones )
+        kicadPlugin.Format( item );
+
+    std::string itemsText = kicadPlugin.GetStringOutput( true );
+
+    BOOST_CHECK( boardText.find( itemsText ) != std::string::npos );
+}
+
+
+/**
+ * Check that a board loaded with the zone fills of its cache takes them from the cache, and
+ * that the cache is not used for another text
+ */
+BOOST_AUTO_TEST_CASE( FillCacheMatchesText )
+{
+    auto tmpBoard = std::filesystem::temp_directory_path() / "FillCache.kicad_pcb";
+
+    // The cache is written with shifted fills, which only a board read from the cache has
+    const VECTOR2I shift( pcbIUScale.mmToIU( 1 ), 0 );
+
+    auto shiftFills =
+            [&]( BOARD* aBoard )
+            {
+                for( ZONE* zone : aBoard->Zones() )
+                {
+                    for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+                    {
+                        if( zone->HasFilledPolysForLayer( layer ) )
+                            zone->GetFill( layer )->Move( shift );
+                    }
+                }
+            };
+
+    {
+        std::string            path = KI_TEST::GetPcbnewTestDataDir() + "issue5093.kicad_pcb";
+        std::unique_ptr<BOARD> board( kicadPlugin.LoadBoard( path, nullptr ) );
+
+        BOOST_REQUIRE( board );
+        kicadPlugin.SaveBoard( tmpBoard.string(), board.get() );
+
+        shiftFills( board.get() );
+        BOOST_REQUIRE( BOARD_FILL_CACHE::WriteForBoardFile( tmpBoard.string(), *board ) );
+    }
+
+    std::ifstream file( tmpBoard, std::ios::binary );
+    std::string   text( std::istreambuf_iterator<char>{ file }, {} );
+
+    BOARD_FILL_CACHE cache;
+
+    BOOST_CHECK( !cache.Open( tmpBoard.string(), BOARD_FILL_CACHE::HashText( text + " " ) ) );
+    BOOST_REQUIRE( cache.Open( tmpBoard.string(), BOARD_FILL_CACHE::HashText( text ) ) );
+
+    STRING_LINE_READER        serialReader( text, tmpBoard.string() );
+    PCB_IO_KICAD_SEXPR_PARSER serialParser( &serialReader, nullptr, nullptr );
+    std::unique_ptr<BOARD>    serialBoard( dynamic_cast<BOARD*>( serialParser.Parse() ) );
+
+    STRING_LINE_READER        cachedReader( text, tmpBoard.string() );
+    PCB_IO_KICAD_SEXPR_PARSER cachedParser( &cachedReader, nullptr, nullptr );
+
+    cachedParser.SetFillCache( &cache );
+
+    std::unique_ptr<BOARD> cachedBoard( dynamic_cast<BOARD*>( cachedParser.Parse() ) );
+
+    BOOST_REQUIRE( serialBoard && cachedBoard );
+    BOOST_REQUIRE( !serialBoard->Zones().empty() );
+
+    kicadPlugin.Format( serialBoard.get() );
+    std::string serialText = kicadPlugin.GetStringOutput( true );
+
+    kicadPlugin.Format( cachedBoard.get() );
+    std::string cachedText = kicadPlugin.GetStringOutput( true );
+
+    BOOST_CHECK( serialText != cachedText );
+
+    shiftFills( serialBoard.get() );
+
+    kicadPlugin.Format( serialBoard.get() );
+    std::string shiftedText = kicadPlugin.GetStringOutput( true );
+
+    BOOST_CHECK( shiftedText == cachedText );
+
+    std::filesystem::remove( tmpBoard );
+    std::filesystem::remove( BOARD_FILL_CACHE::GetCachePath( tmpBoard.string() ).ToStdString() );
+}
+
+
+/**
+ * Check that the footprints of a library read back from its index have the summary of the
+ * parsed footprints, and are parsed when needed
+ */
+BOOST_AUTO_TEST_CASE( FootprintIndex )
+{
+    std::filesystem::path libPath = std::filesystem::temp_directory_path() / "FpIndex.pretty";
+    std::filesystem::path cachePath = std::filesystem::temp_directory_path() / "FpIndexCache";
+
+    std::filesystem::remove_all( libPath );
+    std::filesystem::remove_all( cachePath );
+    std::filesystem::copy( KI_TEST::GetTestDataRootDir() + "libraries/Resistor_SMD.pretty",
+                           libPath );
+
+    // Keep the index out of the user's cache, also when a check below fails
+    struct CACHE_HOME_OVERRIDE
+    {
+        CACHE_HOME_OVERRIDE( const wxString& aPath )
+        {
+            m_hadCacheHome = wxGetEnv( wxT( "KICAD_CACHE_HOME" ), &m_oldCacheHome );
+            wxSetEnv( wxT( "KICAD_CACHE_HOME" ), aPath );
+        }
+
+        ~CACHE_HOME_OVERRIDE()
+        {
+            if( m_hadCacheHome )
+                wxSetEnv( wxT( "KICAD_CACHE_HOME" ), m_oldCacheHome );
+            else
+                wxUnsetEnv( wxT( "KICAD_CACHE_HOME" ) );
+        }
+
+        bool     m_hadCacheHome;
+        wxString m_oldCacheHome;
+    } cacheHomeOverride( cachePath.string() );
+
+    wxArrayString                         names;
+    std::map<wxString, FOOTPRINT_SUMMARY> expected;
+
+    // Parses the library and writes its index
+    kicadPlugin.FootprintEnumerate( names, libPath.string(), false );
+
+    BOOST_REQUIRE( !names.empty() );
+
+    wxFileName indexDir = wxFileName::DirName( PATHS::GetUserCachePath() );
+
+    indexDir.AppendDir( wxT( "footprint-index" ) );
+
+    BOOST_CHECK( indexDir.GetPath().StartsWith( wxString( cachePath.string() ) ) );
+    BOOST_CHECK( wxDir( indexDir.GetPath() ).HasFiles( wxT( "*.json" ) ) );
+
+    for( const wxString& name : names )
+    {
+        const FOOTPRINT* footprint = kicadPlugin.GetEnumeratedFootprint( libPath.string(), name );
+
+        BOOST_REQUIRE( footprint );
+        expected[name] = FOOTPRINT_SUMMARY( *footprint );
+    }
+
+    PCB_IO_KICAD_SEXPR indexedPlugin;
+    wxArrayString      indexedNames;
+
+    indexedPlugin.FootprintEnumerate( indexedNames, libPath.string(), false );
+
+    BOOST_CHECK_EQUAL( indexedNames.size(), names.size() );
+
+    for( const wxString& name : indexedNames )
+    {
+        BOOST_TEST_CONTEXT( name )
+        {
+            FOOTPRINT_SUMMARY summary;
+
+            BOOST_REQUIRE( expected.count( name ) );
+            BOOST_REQUIRE( indexedPlugin.GetFootprintSummary( libPath.string(), name, summary ) );
+
+            BOOST_CHECK( summary.m_Description == expected[name].m_Description );
+            BOOST_CHECK( summary.m_Keywords == expected[name].m_Keywords );
+            BOOST_CHECK_EQUAL( summary.m_PadCount, expected[name].m_PadCount );
+            BOOST_CHECK_EQUAL( summary.m_UniquePadCount, expected[name].m_UniquePadCount );
+
+            std::unique_ptr<FOOTPRINT> footprint( indexedPlugin.FootprintLoad( libPath.string(),
+                                                                               name ) );
+
+            BOOST_REQUIRE( footprint );
+            BOOST_CHECK( footprint->GetFPID().GetLibItemName() == name );
+        }
+    }
+
+    // Deleted files leave the index
+    std::filesystem::remove( libPath / ( names[0].ToStdString() + ".kicad_mod" ) );
+
+    PCB_IO_KICAD_SEXPR updatedPlugin;
+    wxArrayString      updatedNames;
+
+    updatedPlugin.FootprintEnumerate( updatedNames, libPath.string(), false );
+
+    BOOST_CHECK_EQUAL( updatedNames.size(), names.size() - 1 );
+    BOOST_CHECK( updatedNames.Index( names[0] ) == wxNOT_FOUND );
+
+    std::filesystem::remove_all( libPath );
+    std::filesystem::remove_all( cachePath );
+}
+
+
+/**
+ * Check that a footprint library loaded and saved on the thread pool gives the same files as
+ * when it is loaded and saved on one thread
+ */
+BOOST_AUTO_TEST_CASE( ParallelLibraryUpgradeMatchesSerial )
+{
+    std::filesystem::path tmpPath = std::filesystem::temp_directory_path();
+    std::filesystem::path libPath = tmpPath / "FpParallel.pretty";
+    std::filesystem::path serialPath = tmpPath / "FpParallelSerial.pretty";
+    std::filesystem::path parallelPath = tmpPath / "FpParallelParallel.pretty";
+
+    std::filesystem::remove_all( libPath );
+    std::filesystem::remove_all( serialPath );
+    std::filesystem::remove_all( parallelPath );
+    std::filesystem::create_directory( libPath );
+
+    // Enough footprints to be saved in parallel
+    std::filesystem::path srcPath = KI_TEST::GetTestDataRootDir() + "libraries/Resistor_SMD.pretty";
+
+    for( int ii = 0; ii < 20; ++ii )
+    {
+        for( const std::filesystem::directory_entry& entry :
+             std::filesystem::directory_iterator( srcPath ) )
+        {
+            std::string name = entry.path().stem().string() + "_" + std::to_string( ii );
+            std::filesystem::copy_file( entry.path(), libPath / ( name + ".kicad_mod" ) );
+        }
+    }
+
+    // Parses the library in parallel, and writes its index
+    PCB_IO_KICAD_SEXPR parallelPlugin( CTL_FOR_LIBRARY );
+    FP_CACHE           parallelLib( &parallelPlugin, libPath.string() );
+
+    parallelLib.SetParallel( true );
+    parallelLib.Load();
+    parallelLib.SetPath( parallelPath.string() );
+    parallelLib.Save();
+
+    // Reads the library from its index
+    PCB_IO_KICAD_SEXPR serialPlugin( CTL_FOR_LIBRARY );
+    FP_CACHE           serialLib( &serialPlugin, libPath.string() );
+
+    serialLib.Load();
+    serialLib.SetPath( serialPath.string() );
+    serialLib.Save();
+
+    auto readFile =
+            []( const std::filesystem::path& aPath )
+            {
+                std::ifstream stream( aPath, std::ios::binary );
+
+                return std::string( std::istreambuf_iterator<char>( stream ),
+                                    std::istreambuf_iterator<char>() );
+            };
+
+    size_t fileCount = 0;
+
+    for( const std::filesystem::directory_entry& entry :
+         std::filesystem::directory_iterator( serialPath ) )
+    {
+        BOOST_TEST_CONTEXT( entry.path().filename().string() )
+        {
+            std::filesystem::path parallelFile = parallelPath / entry.path().filename();
+
+            BOOST_REQUIRE( std::filesystem::exists( parallelFile ) );
+            BOOST_CHECK( readFile( entry.path() ) == readFile( parallelFile ) );
+        }
+
+        fileCount++;
+    }
+
+    BOOST_CHECK_EQUAL( fileCount, parallelLib.GetFootprints().size() );
+
+    std::filesystem::remove_all( libPath );
+    std::filesystem::remove_all( serialPath );
+    std::filesystem::remove_all( parallelPath );
+}
+
+
+/**
+ * Check that the outline fonts of a footprint library parsed on the thread pool are resolved,
+ * back on the calling thread, to the same fonts as when it is parsed on one thread
+ */
+BOOST_AUTO_TEST_CASE( ParallelLibraryLoadResolvesFonts )
+{
+    std::filesystem::path libPath = std::filesystem::temp_directory_path() / "FpFonts.pretty";
+    std::filesystem::path srcPath = KI_TEST::GetTestDataRootDir() + "libraries/Resistor_SMD.pretty";
+
+    std::filesystem::remove_all( libPath );
+    std::filesystem::create_directory( libPath );
+
+    // Give every text of the footprints an outline font
+    for( int ii = 0; ii < 10; ++ii )
+    {
+        for( const std::filesystem::directory_entry& entry :
+             std::filesystem::directory_iterator( srcPath ) )
+        {
+            std::ifstream in( entry.path(), std::ios::binary );
+            std::string   text( std::istreambuf_iterator<char>{ in }, {} );
+
+            for( size_t pos = text.find( "(font" ); pos != std::string::npos;
+                 pos = text.find( "(font", pos + 1 ) )
+            {
+                text.insert( pos + 5, " (face \"DejaVu Sans\")" );
+            }
+
+            std::string   name = entry.path().stem().string() + "_" + std::to_string( ii );
+            std::ofstream out( libPath / ( name + ".kicad_mod" ), std::ios::binary );
+
+            out << text;
+        }
+    }
+
+    PCB_IO_KICAD_SEXPR parallelPlugin( CTL_FOR_LIBRARY );
+    FP_CACHE           parallelLib( &parallelPlugin, libPath.string() );
+
+    parallelLib.SetParallel( true );
+    parallelLib.Load();
+
+    PCB_IO_KICAD_SEXPR serialPlugin( CTL_FOR_LIBRARY );
+    FP_CACHE           serialLib( &serialPlugin, libPath.string() );
+
+    serialLib.Load();
+    serialLib.ParseFootprints();
+
+    BOOST_REQUIRE_EQUAL( parallelLib.GetFootprints().size(), serialLib.GetFootprints().size() );
+
+    auto textFonts =
+            []( FOOTPRINT* aFootprint )
+            {
+                std::vector<KIFONT::FONT*> fonts;
+
+                aFootprint->RunOnDescendants(
+                        [&]( BOARD_ITEM* aChild )
+                        {
+                            if( EDA_TEXT* text = dynamic_cast<EDA_TEXT*>( aChild ) )
+                            {
+                                // Nothing is left unresolved
+                                BOOST_CHECK( !text->ResolveFont( nullptr ) );
+                                fonts.push_back( text->GetFont() );
+                            }
+                        } );
+
+                return fonts;
+            };
+
+    for( const auto& entry : parallelLib.GetFootprints() )
+    {
+        const wxString& name = entry.first;
+
+        BOOST_TEST_CONTEXT( name )
+        {
+            FOOTPRINT* parallelFootprint = entry.second->GetFootprint().get();
+            FOOTPRINT* serialFootprint = serialLib.GetFootprints().at( name ).GetFootprint().get();
+
+            BOOST_REQUIRE( parallelFootprint );
+            BOOST_REQUIRE( serialFootprint );
+
+            std::vector<KIFONT::FONT*> fonts = textFonts( parallelFootprint );
+
+            BOOST_CHECK( !fonts.empty() );
+            BOOST_CHECK( std::find( fonts.begin(), fonts.end(), nullptr ) == fonts.end() );
+            BOOST_CHECK( fonts == textFonts( serialFootprint ) );
+        }
+    }
+
+    std::filesystem::remove_all( libPath );
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,115 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <pcbnew_utils/board_test_utils.h>
+
+#include <board.h>
+#include <board_connected_item.h>
+#include <connectivity/connectivity_data.h>
+#include <netinfo.h>
+#include <pcb_track.h>
+#include <ratsnest/ratsnest_data.h>
+#include <settings/settings_manager.h>
+
+#include <router/pns_autorouter.h>
+#include <router/pns_kicad_iface.h>
+#include <router/pns_router.h>
+#include <router/pns_routing_settings.h>
+
+
+struct PNS_AUTOROUTER_FIXTURE
+{
+    PNS_AUTOROUTER_FIXTURE() :
+            m_settingsManager( true /* headless */ )
+    { }
+
+    SETTINGS_MANAGER       m_settingsManager;
+    std::unique_ptr<BOARD> m_board;
+};
+
+
+BOOST_FIXTURE_TEST_CASE( AutorouteBasic, PNS_AUTOROUTER_FIXTURE )
+{
+    // Four connections: two which can be routed (SMD pads on the same layer, through-hole
+    // pads), one between pads on opposite sides of the board, and one to a zone.
+    KI_TEST::LoadBoard( m_settingsManager, "autoroute_basic", m_board );
+
+    m_board->BuildConnectivity();
+
+    std::shared_ptr<CONNECTIVITY_DATA> connectivity = m_board->GetConnectivity();
+
+    // The interface must outlive the router
+    PNS_KICAD_IFACE_BATCH iface;
+    PNS::ROUTER           router;
+    PNS::ROUTING_SETTINGS settings( nullptr, "" );
+
+    iface.SetBoard( m_board.get() );
+    router.SetInterface( &iface );
+    router.ClearWorld();
+    router.SyncWorld();
+
+    settings.SetMode( PNS::RM_Walkaround );
+    router.LoadSettings( &settings );
+    router.SetMode( PNS::PNS_MODE_ROUTE_SINGLE );
+
+    PNS::AUTOROUTER autorouter( &router );
+
+    for( NETINFO_ITEM* net : m_board->GetNetInfo() )
+    {
+        if( net->GetNetCode() > 0 )
+            autorouter.AddRatsnest( connectivity->GetRatsnestForNet( net->GetNetCode() ) );
+    }
+
+    BOOST_REQUIRE_EQUAL( autorouter.Connections().size(), 4 );
+
+    int failed = autorouter.Run();
+
+    BOOST_CHECK_EQUAL( failed, 2 );
+
+    // The shove passes work on a copy of the settings
+    BOOST_CHECK( settings.Mode() == PNS::RM_Walkaround );
+
+    for( const PNS::AUTOROUTER::CONNECTION& connection : autorouter.Connections() )
+    {
+        const BOARD_CONNECTED_ITEM* start =
+                static_cast<const BOARD_CONNECTED_ITEM*>( connection.m_startParent );
+        wxString netname = start->GetNetname();
+
+        BOOST_TEST_CONTEXT( netname )
+        {
+            bool routable = netname == wxS( "smd_pair" ) || netname == wxS( "tht_pair" );
+
+            BOOST_CHECK_EQUAL( connection.m_routed, routable );
+        }
+    }
+
+    std::set<wxString> routedNets;
+
+    for( PCB_TRACK* track : m_board->Tracks() )
+        routedNets.insert( track->GetNetname() );
+
+    BOOST_CHECK_EQUAL( routedNets.size(), 2 );
+    BOOST_CHECK( routedNets.count( wxS( "smd_pair" ) ) );
+    BOOST_CHECK( routedNets.count( wxS( "tht_pair" ) ) );
+}
@@ -140,3 +140,52 @@ BOOST_FIXTURE_TEST_CASE( BoardAndFootprintPrettifier, PRETTIFIER_TEST_FIXTURE )
 
     std::filesystem::remove_all( tempLibPath );
 }
+
+
+BOOST_AUTO_TEST_CASE( StreamingPrettifier )
+{
+    std::vector<std::string> cases = {
+        "Reverb_BTDR-1V.kicad_mod",
+        "group_and_image.kicad_pcb"
+    };
+
+    for( const std::string& testCase : cases )
+    {
+        BOOST_TEST_CONTEXT( testCase )
+        {
+            std::ifstream inFp( fmt::format( "{}prettifier/{}", KI_TEST::GetPcbnewTestDataDir(),
+                                             testCase ) );
+            BOOST_REQUIRE( inFp.is_open() );
+
+            std::stringstream inBuf;
+            inBuf << inFp.rdbuf();
+            const std::string inData = inBuf.str();
+
+            for( bool compact : { false, true } )
+            {
+                std::string expected = inData;
+                KICAD_FORMAT::Prettify( expected, compact );
+
+                // Chunk sizes which split the lookahead of whitespace runs and list keywords
+                for( size_t chunkSize : { 1, 2, 3, 7, 4096 } )
+                {
+                    KICAD_FORMAT::PRETTIFIER prettifier( compact );
+                    std::string              streamed;
+
+                    for( size_t pos = 0; pos < inData.length(); pos += chunkSize )
+                    {
+                        prettifier.Process( inData.data() + pos,
+                                            std::min( chunkSize, inData.length() - pos ),
+                                            streamed );
+                    }
+
+                    prettifier.Finish( streamed );
+
+                    BOOST_CHECK_MESSAGE( streamed == expected,
+                                         fmt::format( "chunk size {}, compact {}", chunkSize,
+                                                      compact ) );
+                }
+            }
+        }
+    }
+}
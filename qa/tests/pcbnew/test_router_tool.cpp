@@ -0,0 +1,162 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <pcbnew_utils/board_test_utils.h>
+
+#include <board.h>
+#include <pcb_track.h>
+#include <settings/settings_manager.h>
+#include <tool/tool_manager.h>
+
+#include <router/pns_kicad_iface.h>
+#include <router/pns_node.h>
+#include <router/pns_router.h>
+#include <router/router_tool.h>
+
+
+/**
+ * Expose the world synchronization which the router tool runs before each routing action.
+ */
+class TEST_ROUTER_TOOL : public ROUTER_TOOL
+{
+public:
+    using ROUTER_TOOL::syncWorld;
+};
+
+
+struct ROUTER_TOOL_FIXTURE
+{
+    ROUTER_TOOL_FIXTURE() :
+            m_settingsManager( true /* headless */ )
+    { }
+
+    SETTINGS_MANAGER       m_settingsManager;
+    std::unique_ptr<BOARD> m_board;
+};
+
+
+static PCB_TRACK* firstSegment( BOARD* aBoard )
+{
+    for( PCB_TRACK* track : aBoard->Tracks() )
+    {
+        if( track->Type() == PCB_TRACE_T && track->GetNetCode() > 0 && !track->IsLocked() )
+            return track;
+    }
+
+    return nullptr;
+}
+
+
+static void startRouting( TEST_ROUTER_TOOL* aTool, PCB_TRACK* aTrack )
+{
+    PNS::ROUTER* router = aTool->Router();
+    PNS::ITEM*   startItem = router->GetWorld()->FindItemByParent( aTrack );
+    int          layer = aTool->GetInterface()->GetPNSLayerFromBoardLayer( aTrack->GetLayer() );
+
+    BOOST_REQUIRE( startItem );
+
+    PNS::SIZES_SETTINGS sizes;
+    aTool->GetInterface()->ImportSizes( sizes, startItem, nullptr, aTrack->GetEnd() );
+    router->UpdateSizes( sizes );
+
+    BOOST_REQUIRE( router->StartRouting( aTrack->GetEnd(), startItem, layer ) );
+
+    router->Move( aTrack->GetEnd() + VECTOR2I( pcbIUScale.mmToIU( 1 ), 0 ), nullptr );
+
+    BOOST_REQUIRE( router->RoutingInProgress() );
+}
+
+
+/**
+ * A model reload must only drop the router world: it is rebuilt for the new board by the next
+ * routing action.  The router itself is kept, as a suspended routing loop may still use it.
+ */
+BOOST_FIXTURE_TEST_CASE( RouterWorldRebuiltAfterReload, ROUTER_TOOL_FIXTURE )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "tuning_generators_load_save", m_board );
+
+    TOOL_MANAGER      toolMgr;
+    TEST_ROUTER_TOOL* tool = new TEST_ROUTER_TOOL; // TOOL_MANAGER owns the tools
+
+    toolMgr.SetEnvironment( m_board.get(), nullptr, nullptr, nullptr, nullptr );
+    toolMgr.RegisterTool( tool );
+    tool->Reset( TOOL_BASE::MODEL_RELOAD );
+
+    PNS::ROUTER* router = tool->Router();
+
+    BOOST_REQUIRE( router );
+    BOOST_CHECK( !router->GetWorld() );
+
+    tool->syncWorld();
+
+    BOOST_REQUIRE( router->GetWorld() );
+
+    PCB_TRACK* track = firstSegment( m_board.get() );
+    BOOST_REQUIRE( track );
+
+    // Reload during routing: the route is dropped along with the world
+    startRouting( tool, track );
+
+    std::unique_ptr<BOARD> oldBoard = std::move( m_board );
+    KI_TEST::LoadBoard( m_settingsManager, "tuning_generators_load_save", m_board );
+
+    toolMgr.SetEnvironment( m_board.get(), nullptr, nullptr, nullptr, nullptr );
+    tool->Reset( TOOL_BASE::MODEL_RELOAD );
+
+    BOOST_CHECK( tool->Router() == router );
+    BOOST_CHECK( !router->RoutingInProgress() );
+    BOOST_CHECK( !router->GetWorld() );
+
+    // The tool no longer listens to the old board
+    oldBoard.reset();
+
+    tool->syncWorld();
+
+    BOOST_REQUIRE( router->GetWorld() );
+
+    track = firstSegment( m_board.get() );
+    BOOST_REQUIRE( track );
+    BOOST_CHECK( router->GetWorld()->FindItemByParent( track ) );
+
+    // Reload after routing, keeping the board
+    startRouting( tool, track );
+    router->StopRouting();
+
+    tool->Reset( TOOL_BASE::MODEL_RELOAD );
+
+    BOOST_CHECK( !router->GetWorld() );
+
+    // Changes made while the world is dropped are picked up by the rebuild...
+    m_board->Remove( track );
+    tool->syncWorld();
+
+    BOOST_REQUIRE( router->GetWorld() );
+    BOOST_CHECK( !router->GetWorld()->FindItemByParent( track ) );
+
+    // ... and later ones through the board listener, which is attached again
+    m_board->Add( track );
+    tool->syncWorld();
+
+    BOOST_CHECK( router->GetWorld()->FindItemByParent( track ) );
+}
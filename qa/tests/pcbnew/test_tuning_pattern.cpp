@@ -0,0 +1,201 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <pcbnew_utils/board_test_utils.h>
+
+#include <board.h>
+#include <board_commit.h>
+#include <kiid.h>
+#include <pcb_generator.h>
+#include <pcb_track.h>
+#include <settings/settings_manager.h>
+#include <string_any_map.h>
+#include <tool/tool_manager.h>
+#include <tools/generator_tool.h>
+
+
+struct TUNING_PATTERN_FIXTURE
+{
+    TUNING_PATTERN_FIXTURE() :
+            m_settingsManager( true /* headless */ )
+    { }
+
+    SETTINGS_MANAGER       m_settingsManager;
+    std::unique_ptr<BOARD> m_board;
+};
+
+
+static std::set<BOARD_ITEM*> meanderTracks( PCB_GENERATOR* aPattern )
+{
+    std::set<BOARD_ITEM*> tracks;
+
+    for( BOARD_ITEM* item : aPattern->GetItems() )
+    {
+        if( item->Type() == PCB_TRACE_T || item->Type() == PCB_ARC_T )
+            tracks.insert( item );
+    }
+
+    return tracks;
+}
+
+
+static BOX2I meanderBBox( PCB_GENERATOR* aPattern )
+{
+    BOX2I bbox;
+
+    for( BOARD_ITEM* track : meanderTracks( aPattern ) )
+        bbox.Merge( track->GetBoundingBox() );
+
+    return bbox;
+}
+
+
+static wxString tuningStatus( PCB_GENERATOR* aPattern )
+{
+    wxString status;
+    aPattern->GetProperties().get_to( "last_status", status );
+    return status;
+}
+
+
+/**
+ * Regenerate \a aPattern the way the move tool edits it: \a aEdit runs between the start of
+ * the edit and the update of the meanders.
+ */
+static void regenerate( GENERATOR_TOOL* aTool, BOARD* aBoard, PCB_GENERATOR* aPattern,
+                        const std::function<void()>& aEdit = nullptr )
+{
+    BOARD_COMMIT commit( aTool );
+
+    aPattern->EditStart( aTool, aBoard, &commit );
+
+    if( aEdit )
+        aEdit();
+
+    aPattern->Update( aTool, aBoard, &commit );
+    aPattern->EditPush( aTool, aBoard, &commit, wxS( "Regenerate" ) );
+}
+
+
+/**
+ * Check that the meanders of a tuned pattern are left alone when nothing changed, but are
+ * regenerated when the pattern is moved or rotated, even if it was up to date when the edit
+ * started.
+ */
+BOOST_FIXTURE_TEST_CASE( TuningPatternRegeneratedAfterMove, TUNING_PATTERN_FIXTURE )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "tuning_generators_load_save", m_board );
+
+    PCB_GENERATOR* pattern = static_cast<PCB_GENERATOR*>( &KI_TEST::RequireBoardItemWithTypeAndId(
+            *m_board, PCB_GENERATOR_T, KIID( "4f22a815-3048-42b3-86fa-eb71720d35ae" ) ) );
+
+    TOOL_MANAGER    toolMgr;
+    GENERATOR_TOOL* tool = new GENERATOR_TOOL; // TOOL_MANAGER owns the tools
+
+    toolMgr.SetEnvironment( m_board.get(), nullptr, nullptr, nullptr, nullptr );
+    toolMgr.RegisterTool( tool );
+    tool->Reset( TOOL_BASE::MODEL_RELOAD );
+
+    // Aim for a length which the pattern can reach: the net without meanders plus 10mm
+    NETINFO_ITEM* net = nullptr;
+    double        meanderLength = 0.0;
+    double        netLength = 0.0;
+
+    for( BOARD_ITEM* item : meanderTracks( pattern ) )
+    {
+        net = static_cast<PCB_TRACK*>( item )->GetNet();
+        meanderLength += static_cast<PCB_TRACK*>( item )->GetLength();
+    }
+
+    BOOST_REQUIRE( net );
+
+    for( PCB_TRACK* track : m_board->Tracks() )
+    {
+        if( track->GetNet() == net )
+            netLength += track->GetLength();
+    }
+
+    STRING_ANY_MAP props = pattern->GetProperties();
+    VECTOR2I       end;
+
+    props.get_to( "end", end );
+
+    long long target = KiROUND( netLength - meanderLength
+                                + ( end - pattern->GetPosition() ).EuclideanNorm() )
+                       + pcbIUScale.mmToIU( 10 );
+
+    for( const char* key : { "override_custom_rules", "target_length", "target_length_min",
+                             "target_length_max" } )
+    {
+        props.erase( key );
+    }
+
+    props.set( "override_custom_rules", true );
+    props.set_iu( "target_length", target );
+    props.set_iu( "target_length_min", target - pcbIUScale.mmToIU( 0.1 ) );
+    props.set_iu( "target_length_max", target + pcbIUScale.mmToIU( 0.1 ) );
+    pattern->SetProperties( props );
+
+    regenerate( tool, m_board.get(), pattern );
+
+    BOOST_REQUIRE_EQUAL( tuningStatus( pattern ), wxS( "tuned" ) );
+
+    // Nothing changed: the meanders are kept
+    std::set<BOARD_ITEM*> tuned = meanderTracks( pattern );
+
+    regenerate( tool, m_board.get(), pattern );
+
+    BOOST_CHECK( meanderTracks( pattern ) == tuned );
+
+    // Moved along its track after the edit started, as the move tool does
+    const int offset = pcbIUScale.mmToIU( 5 );
+    BOX2I     before = meanderBBox( pattern );
+
+    regenerate( tool, m_board.get(), pattern,
+                [&]()
+                {
+                    pattern->Move( VECTOR2I( offset, 0 ) );
+                } );
+
+    BOX2I moved = meanderBBox( pattern );
+
+    BOOST_CHECK( meanderTracks( pattern ) != tuned );
+    BOOST_CHECK_GT( moved.GetLeft(), before.GetLeft() + offset / 2 );
+    BOOST_CHECK_EQUAL( tuningStatus( pattern ), wxS( "tuned" ) );
+
+    // Rotated: the regenerated meanders follow the (now vertical) base line
+    BOOST_REQUIRE_GT( moved.GetWidth(), moved.GetHeight() );
+
+    pattern->Rotate( pattern->GetPosition(), ANGLE_90 );
+
+    std::set<BOARD_ITEM*> rotated = meanderTracks( pattern );
+
+    regenerate( tool, m_board.get(), pattern );
+
+    BOX2I regenerated = meanderBBox( pattern );
+
+    BOOST_CHECK( !meanderTracks( pattern ).empty() );
+    BOOST_CHECK( meanderTracks( pattern ) != rotated );
+    BOOST_CHECK_GT( regenerated.GetHeight(), regenerated.GetWidth() );
+}
@@ -22,18 +22,21 @@
  */
 
 #include <wx/wx.h>
+#include <dsnlexer.h>
 #include <richio.h>
 
 #include <chrono>
 #include <ios>
 #include <functional>
 #include <iostream>
+#include <limits>
 
 #include <fstream>
 
 #include <wx/wfstream.h>
 #include <wx/filename.h>
 
+#include <math/util.h>
 #include <qa_utils/stdstream_line_reader.h>
 #include <qa_utils/utility_registry.h>
 
@@ -303,6 +306,80 @@ static void bench_wxbis_reuse( const wxFileName& aFile, int aReps, BENCH_REPORT&
     }
 }
 
+/**
+ * A lexer collecting the numbers of an s-expression file, which can then convert them again
+ * and again without the cost of lexing.
+ */
+class NUMBER_BENCH_LEXER : public DSNLEXER
+{
+public:
+    NUMBER_BENCH_LEXER( const wxFileName& aFile ) :
+            DSNLEXER( nullptr, 0, nullptr ),
+            m_reader( aFile.GetFullPath() )
+    {
+        PushReader( &m_reader );
+
+        for( int tok = NextTok(); tok != DSN_EOF; tok = NextTok() )
+        {
+            if( tok == DSN_NUMBER )
+                m_numbers.push_back( CurStr() );
+        }
+    }
+
+    /// Convert the numbers to nanometres as the board parser used to
+    void ConvertWithDouble( BENCH_REPORT& report )
+    {
+        for( const std::string& number : m_numbers )
+        {
+            curText = number;
+            report.linesRead++;
+            report.charAcc += (unsigned) KiROUND( parseDouble() * 1e6 );
+        }
+    }
+
+    /// Convert the numbers to nanometres with the fixed point path
+    void ConvertScaled( BENCH_REPORT& report )
+    {
+        for( const std::string& number : m_numbers )
+        {
+            curText = number;
+            report.linesRead++;
+            report.charAcc += (unsigned) parseScaledInt( 1e6, std::numeric_limits<int>::max() );
+        }
+    }
+
+private:
+    MMAP_LINE_READER         m_reader;
+    std::vector<std::string> m_numbers;
+};
+
+
+/**
+ * Benchmark the conversion of the numbers of an s-expression file (in mm) to nanometres,
+ * going through a double.  "Lines" are the numbers converted.
+ */
+static void bench_numbers_double( const wxFileName& aFile, int aReps, BENCH_REPORT& report )
+{
+    NUMBER_BENCH_LEXER lexer( aFile );
+
+    for( int i = 0; i < aReps; ++i )
+        lexer.ConvertWithDouble( report );
+}
+
+
+/**
+ * Benchmark the conversion of the numbers of an s-expression file (in mm) to nanometres,
+ * with DSNLEXER::parseScaledInt().  "Lines" are the numbers converted.
+ */
+static void bench_numbers_scaled( const wxFileName& aFile, int aReps, BENCH_REPORT& report )
+{
+    NUMBER_BENCH_LEXER lexer( aFile );
+
+    for( int i = 0; i < aReps; ++i )
+        lexer.ConvertScaled( report );
+}
+
+
 /**
  * List of available benchmarks
  */
@@ -324,6 +401,8 @@ static std::vector<BENCHMARK> benchmarkList =
     { 'B', bench_wxbis_reuse<wxFileInputStream>, "wxFileIStream, buf'd, reused" },
     { 'c', bench_wxbis<wxFFileInputStream>, "wxFFileIStream. buf'd" },
     { 'C', bench_wxbis_reuse<wxFFileInputStream>, "wxFFileIStream, buf'd, reused" },
+    { 'd', bench_numbers_double, "Numbers, double" },
+    { 'i', bench_numbers_scaled, "Numbers, fixed point" },
 };
 
 
@@ -23,7 +23,9 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <geometry/shape_arc.h>
 #include <geometry/shape_file_io.h>
+#include <geometry/shape_index.h>
 #include <geometry/shape_line_chain.h>
 #include <geometry/shape_poly_set.h>
 
@@ -32,11 +34,30 @@
 #include <qa_utils/utility_registry.h>
 
 #include <board.h>
+#include <board_design_settings.h>
+#include <build_version.h>
 #include <footprint.h>
 #include <pad.h>
+#include <pcb_shape.h>
 #include <pcb_track.h>
+#include <thread_pool.h>
 #include <zone.h>
 
+#include <nlohmann/json.hpp>
+
+#include <wx/filename.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
 
 void process( const BOARD_CONNECTED_ITEM* item, int net )
 {
@@ -55,24 +76,669 @@ void process( const BOARD_CONNECTED_ITEM* item, int net )
 enum POLY_GEN_RET_CODES
 {
     LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+    RESULT_MISMATCH,
+    WRITE_FAILED,
+};
+
+
+/**
+ * Passed to the benchmark bodies, to exclude their setup from the timing and to report how
+ * much work an iteration does.
+ */
+class BENCH_STATE
+{
+public:
+    void PauseTiming()
+    {
+        m_pauseStart = std::chrono::steady_clock::now();
+        m_pauseCpuStart = std::clock();
+    }
+
+    void ResumeTiming()
+    {
+        m_paused += std::chrono::steady_clock::now() - m_pauseStart;
+        m_pausedCpu += std::clock() - m_pauseCpuStart;
+    }
+
+    /// Number of items (vertices, queries...) processed by one iteration
+    void SetItemsPerIteration( int64_t aItems ) { m_items = aItems; }
+
+    /// Keep a result alive, so that the work producing it isn't optimized out
+    void KeepResult( int64_t aValue ) { m_sink += aValue; }
+
+private:
+    friend class BENCH_RUNNER;
+
+    std::chrono::steady_clock::time_point    m_pauseStart;
+    std::chrono::steady_clock::duration      m_paused{};
+    std::clock_t                             m_pauseCpuStart = 0;
+    std::clock_t                             m_pausedCpu = 0;
+    int64_t                                  m_items = 0;
+    int64_t                                  m_sink = 0;
+};
+
+
+struct BENCH_RESULT
+{
+    std::string m_name;
+    int64_t     m_iterations;
+    double      m_realTimeNs;       ///< per iteration
+    double      m_cpuTimeNs;        ///< per iteration
+    int64_t     m_items;            ///< per iteration
+};
+
+
+/**
+ * Runs each benchmark until it has taken the minimum time, and records the mean time per
+ * iteration.  The JSON report uses the Google Benchmark layout, so that the usual comparison
+ * scripts can be used to track regressions between versions.
+ */
+class BENCH_RUNNER
+{
+public:
+    BENCH_RUNNER( std::chrono::milliseconds aMinTime ) :
+            m_minTime( aMinTime )
+    {
+    }
+
+    /**
+     * Run \a aBody repeatedly, doubling the iteration count until the minimum time is reached,
+     * and record the time per iteration of the last batch.
+     */
+    void Run( const std::string& aName, const std::function<void( BENCH_STATE& )>& aBody )
+    {
+        // Warm up the caches and the allocator
+        BENCH_STATE warmUp;
+        aBody( warmUp );
+
+        for( int64_t iterations = 1; ; iterations *= 2 )
+        {
+            BENCH_STATE state;
+
+            auto         start = std::chrono::steady_clock::now();
+            std::clock_t cpuStart = std::clock();
+
+            for( int64_t ii = 0; ii < iterations; ii++ )
+                aBody( state );
+
+            auto real = std::chrono::steady_clock::now() - start - state.m_paused;
+            auto cpu = std::clock() - cpuStart - state.m_pausedCpu;
+
+            if( real < m_minTime && iterations < ( int64_t( 1 ) << 30 ) )
+                continue;
+
+            BENCH_RESULT result;
+            result.m_name = aName;
+            result.m_iterations = iterations;
+            result.m_realTimeNs = std::chrono::duration<double, std::nano>( real ).count()
+                                  / iterations;
+            result.m_cpuTimeNs = 1e9 * cpu / CLOCKS_PER_SEC / iterations;
+            result.m_items = state.m_items;
+
+            std::cout << std::left << std::setw( 60 ) << aName << std::right << std::setw( 14 )
+                      << std::fixed << std::setprecision( 0 ) << result.m_realTimeNs << " ns"
+                      << std::setw( 12 ) << iterations << std::endl;
+
+            m_results.push_back( result );
+            break;
+        }
+    }
+
+    bool WriteJson( const std::string& aFilename ) const
+    {
+        nlohmann::json report;
+
+        char        date[32];
+        std::time_t now = std::time( nullptr );
+        std::strftime( date, sizeof( date ), "%Y-%m-%dT%H:%M:%S", std::localtime( &now ) );
+
+        report["context"] = { { "date", date },
+                              { "executable", "qa_pcbnew_tools polygon_generator" },
+                              { "kicad_version", GetBuildVersion().ToStdString() },
+                              { "num_cpus", std::thread::hardware_concurrency() },
+#ifdef NDEBUG
+                              { "library_build_type", "release" }
+#else
+                              { "library_build_type", "debug" }
+#endif
+                            };
+
+        report["benchmarks"] = nlohmann::json::array();
+
+        for( const BENCH_RESULT& result : m_results )
+        {
+            nlohmann::json entry = { { "name", result.m_name },
+                                     { "run_name", result.m_name },
+                                     { "run_type", "iteration" },
+                                     { "iterations", result.m_iterations },
+                                     { "real_time", result.m_realTimeNs },
+                                     { "cpu_time", result.m_cpuTimeNs },
+                                     { "time_unit", "ns" } };
+
+            if( result.m_items > 0 && result.m_realTimeNs > 0 )
+                entry["items_per_second"] = result.m_items * 1e9 / result.m_realTimeNs;
+
+            report["benchmarks"].push_back( entry );
+        }
+
+        std::ofstream out( aFilename );
+        out << std::setw( 2 ) << report << std::endl;
+
+        return out.good();
+    }
+
+private:
+    std::chrono::milliseconds m_minTime;
+    std::vector<BENCH_RESULT> m_results;
 };
 
 
+/**
+ * Time \a aOperation on a copy of \a aInput; the copy is not timed.  The result of the last
+ * run is left in \a aResult, if given.
+ */
+static void benchPoly( BENCH_RUNNER& aRunner, const std::string& aName,
+                       const SHAPE_POLY_SET& aInput,
+                       const std::function<void( SHAPE_POLY_SET& )>& aOperation,
+                       SHAPE_POLY_SET* aResult = nullptr )
+{
+    SHAPE_POLY_SET poly;
+
+    aRunner.Run( aName,
+            [&]( BENCH_STATE& aState )
+            {
+                aState.PauseTiming();
+                poly = aInput.CloneDropTriangulation();
+                aState.ResumeTiming();
+
+                aOperation( poly );
+
+                aState.SetItemsPerIteration( aInput.TotalVertices() );
+                aState.KeepResult( poly.OutlineCount() );
+            } );
+
+    if( aResult )
+        *aResult = std::move( poly );
+}
+
+
+/**
+ * Compare the single threaded and the parallel boolean engines on the copper of each layer,
+ * in the same way the zone filler knocks out items from a zone.
+ */
+static int benchmarkBooleans( BENCH_RUNNER& aRunner, BOARD* aBoard, const std::string& aName )
+{
+    thread_pool& tp = GetKiCadThreadPool();
+    bool         mismatch = false;
+
+    std::cout << "Boolean benchmark using " << tp.get_thread_count() << " threads" << std::endl;
+
+    for( PCB_LAYER_ID layer : aBoard->GetEnabledLayers().CuStack() )
+    {
+        SHAPE_POLY_SET knockouts;
+
+        for( PCB_TRACK* track : aBoard->Tracks() )
+        {
+            if( track->IsOnLayer( layer ) )
+            {
+                track->TransformShapeToPolygon( knockouts, layer, pcbIUScale.mmToIU( 0.2 ),
+                                                ARC_HIGH_DEF, ERROR_OUTSIDE );
+            }
+        }
+
+        for( FOOTPRINT* fp : aBoard->Footprints() )
+        {
+            for( PAD* pad : fp->Pads() )
+            {
+                if( pad->IsOnLayer( layer ) )
+                {
+                    pad->TransformShapeToPolygon( knockouts, layer, pcbIUScale.mmToIU( 0.2 ),
+                                                  ARC_HIGH_DEF, ERROR_OUTSIDE );
+                }
+            }
+        }
+
+        if( knockouts.IsEmpty() )
+            continue;
+
+        BOX2I          bbox = aBoard->GetBoardEdgesBoundingBox();
+        SHAPE_POLY_SET pour;
+
+        pour.NewOutline();
+        pour.Append( bbox.GetLeft(), bbox.GetTop() );
+        pour.Append( bbox.GetRight(), bbox.GetTop() );
+        pour.Append( bbox.GetRight(), bbox.GetBottom() );
+        pour.Append( bbox.GetLeft(), bbox.GetBottom() );
+
+        const std::string suffix = "/" + aName + "/" + LayerName( layer ).ToStdString();
+
+        SHAPE_POLY_SET serialAdd, parallelAdd, serialSub, parallelSub;
+
+        benchPoly( aRunner, "boolean_add/serial" + suffix, SHAPE_POLY_SET(),
+                   [&]( SHAPE_POLY_SET& aPoly ) { aPoly.BooleanAdd( knockouts ); },
+                   &serialAdd );
+
+        benchPoly( aRunner, "boolean_add/parallel" + suffix, SHAPE_POLY_SET(),
+                   [&]( SHAPE_POLY_SET& aPoly ) { aPoly.BooleanAdd( knockouts, tp ); },
+                   &parallelAdd );
+
+        benchPoly( aRunner, "boolean_subtract/serial" + suffix, pour,
+                   [&]( SHAPE_POLY_SET& aPoly ) { aPoly.BooleanSubtract( knockouts ); },
+                   &serialSub );
+
+        benchPoly( aRunner, "boolean_subtract/parallel" + suffix, pour,
+                   [&]( SHAPE_POLY_SET& aPoly ) { aPoly.BooleanSubtract( knockouts, tp ); },
+                   &parallelSub );
+
+        auto same =
+                []( SHAPE_POLY_SET& aA, SHAPE_POLY_SET& aB )
+                {
+                    // The outlines may come out in a different order, and a pour cut into
+                    // strips gets extra points on the strip boundaries, so compare the areas
+                    // covered
+                    SHAPE_POLY_SET difference;
+                    difference.BooleanXor( aA, aB );
+
+                    return aA.OutlineCount() == aB.OutlineCount()
+                           && difference.Area() <= 1e-6 * std::abs( aA.Area() );
+                };
+
+        bool ok = same( serialAdd, parallelAdd ) && same( serialSub, parallelSub );
+        mismatch |= !ok;
+
+        std::cout << LayerName( layer ).ToStdString() << ": " << knockouts.OutlineCount()
+                  << " outlines" << ( ok ? "" : ", RESULTS DIFFER" ) << std::endl;
+    }
+
+    return mismatch ? POLY_GEN_RET_CODES::RESULT_MISMATCH : KI_TEST::RET_CODES::OK;
+}
+
+
+/**
+ * Compare the fracture implementations on the zone fills of the board: the fills are
+ * unfractured again and each implementation times how long it takes to put the holes back.
+ */
+static int benchmarkFracture( BENCH_RUNNER& aRunner, BOARD* aBoard, const std::string& aName )
+{
+    using FRACTURE_ALGO = SHAPE_POLY_SET::FRACTURE_ALGO;
+
+    thread_pool& tp = GetKiCadThreadPool();
+    bool         mismatch = false;
+    int          zoneIndex = 0;
+
+    std::cout << "Fracture benchmark using " << tp.get_thread_count() << " threads" << std::endl;
+
+    for( ZONE* zone : aBoard->Zones() )
+    {
+        zoneIndex++;
+
+        for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+        {
+            if( !zone->HasFilledPolysForLayer( layer ) )
+                continue;
+
+            SHAPE_POLY_SET fill = zone->GetFilledPolysList( layer )->CloneDropTriangulation();
+            fill.Unfracture();
+
+            if( fill.IsEmpty() )
+                continue;
+
+            int holes = 0;
+
+            for( int ii = 0; ii < fill.OutlineCount(); ii++ )
+                holes += fill.HoleCount( ii );
+
+            // Zone names need not be unique, the benchmark names must be
+            const std::string suffix = "/" + aName + "/zone" + std::to_string( zoneIndex ) + "/"
+                                       + LayerName( layer ).ToStdString();
+
+            SHAPE_POLY_SET linear, indexed, parallel;
+
+            benchPoly( aRunner, "fracture/slow" + suffix, fill,
+                       []( SHAPE_POLY_SET& aPoly ) { aPoly.Fracture( FRACTURE_ALGO::SLOW ); } );
+
+            benchPoly( aRunner, "fracture/linear" + suffix, fill,
+                       []( SHAPE_POLY_SET& aPoly ) { aPoly.Fracture( FRACTURE_ALGO::LINEAR ); },
+                       &linear );
+
+            benchPoly( aRunner, "fracture/indexed" + suffix, fill,
+                       []( SHAPE_POLY_SET& aPoly ) { aPoly.Fracture( FRACTURE_ALGO::INDEXED ); },
+                       &indexed );
+
+            benchPoly( aRunner, "fracture/parallel" + suffix, fill,
+                       [&]( SHAPE_POLY_SET& aPoly ) { aPoly.Fracture( tp ); },
+                       &parallel );
+
+            // The slow implementation bridges the holes differently, but the indexed and the
+            // parallel ones must come up with exactly the same outlines as the linear scan
+            auto same =
+                    []( const SHAPE_POLY_SET& aA, const SHAPE_POLY_SET& aB )
+                    {
+                        if( aA.OutlineCount() != aB.OutlineCount() )
+                            return false;
+
+                        for( int ii = 0; ii < aA.OutlineCount(); ii++ )
+                        {
+                            if( aA.COutline( ii ).CPoints() != aB.COutline( ii ).CPoints() )
+                                return false;
+                        }
+
+                        return true;
+                    };
+
+            bool ok = same( linear, indexed ) && same( linear, parallel );
+            mismatch |= !ok;
+
+            std::cout << zone->GetFriendlyName().ToStdString() << " on "
+                      << LayerName( layer ).ToStdString() << ": " << fill.OutlineCount()
+                      << " outlines, " << holes << " holes" << ( ok ? "" : ", RESULTS DIFFER" )
+                      << std::endl;
+        }
+    }
+
+    return mismatch ? POLY_GEN_RET_CODES::RESULT_MISMATCH : KI_TEST::RET_CODES::OK;
+}
+
+
+/**
+ * The shapes of a board used by the primitive benchmarks.  Polygons are taken from the copper
+ * layer with the largest fill.
+ */
+struct BOARD_GEOMETRY
+{
+    int                                 m_maxError = 0;
+    int                                 m_clearance = 0;
+    SHAPE_POLY_SET                      m_fills;
+    SHAPE_POLY_SET                      m_obstacles;
+    std::vector<SHAPE_LINE_CHAIN>       m_chains;
+    std::vector<SHAPE_ARC>              m_arcs;
+    std::vector<std::shared_ptr<SHAPE>> m_shapes;
+};
+
+
+static BOARD_GEOMETRY collectGeometry( BOARD& aBoard )
+{
+    BOARD_GEOMETRY geom;
+
+    geom.m_maxError = aBoard.GetDesignSettings().m_MaxError;
+    geom.m_clearance = aBoard.GetDesignSettings().m_MinClearance;
+
+    PCB_LAYER_ID layer = F_Cu;
+    int          mostVertices = -1;
+
+    for( PCB_LAYER_ID candidate : LSET::AllCuMask().Seq() )
+    {
+        int vertices = 0;
+
+        for( ZONE* zone : aBoard.Zones() )
+        {
+            if( zone->HasFilledPolysForLayer( candidate ) )
+                vertices += zone->GetFilledPolysList( candidate )->TotalVertices();
+        }
+
+        if( vertices > mostVertices )
+        {
+            mostVertices = vertices;
+            layer = candidate;
+        }
+    }
+
+    for( ZONE* zone : aBoard.Zones() )
+    {
+        if( zone->IsOnLayer( layer ) && zone->HasFilledPolysForLayer( layer ) )
+            geom.m_fills.Append( *zone->GetFilledPolysList( layer ) );
+    }
+
+    // The inputs are linearized, so that no benchmark times the arc bookkeeping
+    geom.m_fills.ClearArcs();
+
+    for( int ii = 0; ii < geom.m_fills.OutlineCount(); ii++ )
+        geom.m_chains.push_back( geom.m_fills.COutline( ii ) );
+
+    for( FOOTPRINT* footprint : aBoard.Footprints() )
+    {
+        for( PAD* pad : footprint->Pads() )
+        {
+            if( !pad->IsOnLayer( layer ) )
+                continue;
+
+            pad->TransformShapeToPolygon( geom.m_obstacles, layer, geom.m_clearance,
+                                          geom.m_maxError, ERROR_OUTSIDE );
+            geom.m_shapes.push_back( pad->GetEffectiveShape( layer ) );
+        }
+    }
+
+    for( PCB_TRACK* track : aBoard.Tracks() )
+    {
+        if( track->Type() == PCB_ARC_T )
+        {
+            PCB_ARC* arc = static_cast<PCB_ARC*>( track );
+            geom.m_arcs.emplace_back( arc->GetStart(), arc->GetMid(), arc->GetEnd(),
+                                      arc->GetWidth() );
+        }
+
+        if( !track->IsOnLayer( layer ) )
+            continue;
+
+        track->TransformShapeToPolygon( geom.m_obstacles, layer, geom.m_clearance,
+                                        geom.m_maxError, ERROR_OUTSIDE );
+        geom.m_shapes.push_back( track->GetEffectiveShape( layer ) );
+    }
+
+    geom.m_obstacles.ClearArcs();
+
+    for( BOARD_ITEM* item : aBoard.Drawings() )
+    {
+        PCB_SHAPE* shape = dynamic_cast<PCB_SHAPE*>( item );
+
+        if( shape && shape->GetShape() == SHAPE_T::ARC )
+        {
+            geom.m_arcs.emplace_back( shape->GetStart(), shape->GetArcMid(), shape->GetEnd(),
+                                      shape->GetWidth() );
+        }
+    }
+
+    return geom;
+}
+
+
+/**
+ * Time the kimath primitives not covered by the boolean and fracture benchmarks: polygon
+ * inflate and triangulation, line chain collisions and intersections, arc approximations and
+ * shape index queries.
+ */
+static int benchmarkPrimitives( BENCH_RUNNER& aRunner, BOARD* aBoard, const std::string& aName )
+{
+    const BOARD_GEOMETRY geom = collectGeometry( *aBoard );
+    const std::string    suffix = "/" + aName;
+
+    if( !geom.m_fills.IsEmpty() )
+    {
+        benchPoly( aRunner, "poly/inflate" + suffix, geom.m_fills,
+                   [&]( SHAPE_POLY_SET& aPoly )
+                   {
+                       aPoly.Inflate( geom.m_clearance, CORNER_STRATEGY::ROUND_ALL_CORNERS,
+                                      geom.m_maxError );
+                   } );
+
+        benchPoly( aRunner, "poly/deflate" + suffix, geom.m_fills,
+                   [&]( SHAPE_POLY_SET& aPoly )
+                   {
+                       aPoly.Deflate( geom.m_clearance, CORNER_STRATEGY::ROUND_ALL_CORNERS,
+                                      geom.m_maxError );
+                   } );
+
+        benchPoly( aRunner, "poly/triangulate" + suffix, geom.m_fills,
+                   []( SHAPE_POLY_SET& aPoly ) { aPoly.CacheTriangulation(); } );
+    }
+
+    if( !geom.m_chains.empty() )
+    {
+        // A grid of points over the fills, as clearance tests probe them
+        const BOX2I           bbox = geom.m_fills.BBox();
+        std::vector<VECTOR2I> points;
+
+        for( int ii = 0; ii < 32; ii++ )
+        {
+            for( int jj = 0; jj < 32; jj++ )
+            {
+                points.emplace_back( bbox.GetX() + bbox.GetWidth() * ( ii + 0.5 ) / 32,
+                                     bbox.GetY() + bbox.GetHeight() * ( jj + 0.5 ) / 32 );
+            }
+        }
+
+        aRunner.Run( "chain/collide_point" + suffix,
+                [&]( BENCH_STATE& aState )
+                {
+                    int hits = 0;
+
+                    for( const SHAPE_LINE_CHAIN& chain : geom.m_chains )
+                    {
+                        for( const VECTOR2I& pt : points )
+                            hits += chain.Collide( pt, geom.m_clearance ) ? 1 : 0;
+                    }
+
+                    aState.SetItemsPerIteration( geom.m_chains.size() * points.size() );
+                    aState.KeepResult( hits );
+                } );
+
+        SHAPE_LINE_CHAIN::INTERSECTIONS intersections;
+
+        aRunner.Run( "chain/intersect" + suffix,
+                [&]( BENCH_STATE& aState )
+                {
+                    int64_t pairs = 0;
+
+                    for( const SHAPE_LINE_CHAIN& chain : geom.m_chains )
+                    {
+                        for( int ii = 0; ii < geom.m_obstacles.OutlineCount(); ii++ )
+                        {
+                            intersections.clear();
+                            chain.Intersect( geom.m_obstacles.COutline( ii ), intersections );
+                            pairs++;
+                        }
+                    }
+
+                    aState.SetItemsPerIteration( pairs );
+                    aState.KeepResult( intersections.size() );
+                } );
+    }
+
+    if( !geom.m_arcs.empty() )
+    {
+        aRunner.Run( "arc/approximate" + suffix,
+                [&]( BENCH_STATE& aState )
+                {
+                    int64_t vertices = 0;
+
+                    for( const SHAPE_ARC& arc : geom.m_arcs )
+                        vertices += arc.ConvertToPolyline( geom.m_maxError ).PointCount();
+
+                    aState.SetItemsPerIteration( geom.m_arcs.size() );
+                    aState.KeepResult( vertices );
+                } );
+    }
+
+    if( !geom.m_shapes.empty() )
+    {
+        aRunner.Run( "index/build" + suffix,
+                [&]( BENCH_STATE& aState )
+                {
+                    SHAPE_INDEX<int> index( 0 );
+
+                    for( size_t ii = 0; ii < geom.m_shapes.size(); ii++ )
+                        index.Add( static_cast<int>( ii ), geom.m_shapes[ii]->BBox() );
+
+                    aState.SetItemsPerIteration( geom.m_shapes.size() );
+                } );
+
+        SHAPE_INDEX<int> index( 0 );
+
+        for( size_t ii = 0; ii < geom.m_shapes.size(); ii++ )
+            index.Add( static_cast<int>( ii ), geom.m_shapes[ii]->BBox() );
+
+        aRunner.Run( "index/query" + suffix,
+                [&]( BENCH_STATE& aState )
+                {
+                    int64_t collisions = 0;
+
+                    for( const std::shared_ptr<SHAPE>& shape : geom.m_shapes )
+                    {
+                        auto visitor =
+                                [&]( int aIndex )
+                                {
+                                    if( shape->Collide( geom.m_shapes[aIndex].get(),
+                                                        geom.m_clearance ) )
+                                    {
+                                        collisions++;
+                                    }
+
+                                    return true;
+                                };
+
+                        index.Query( shape.get(), geom.m_clearance, visitor );
+                    }
+
+                    aState.SetItemsPerIteration( geom.m_shapes.size() );
+                    aState.KeepResult( collisions );
+                } );
+    }
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
 int polygon_gererator_main( int argc, char* argv[] )
 {
     if( argc < 2 )
         return KI_TEST::RET_CODES::BAD_CMDLINE;
 
-    std::string filename;
+    std::string filename = argv[1];
+    std::string benchmark;
+    std::string jsonFile;
+    long        minTime = 500;
 
-    if( argc > 1 )
-        filename = argv[1];
+    for( int ii = 2; ii < argc; ii++ )
+    {
+        if( !strcmp( argv[ii], "--json" ) && ii + 1 < argc )
+            jsonFile = argv[++ii];
+        else if( !strcmp( argv[ii], "--min-time" ) && ii + 1 < argc )
+            minTime = std::atol( argv[++ii] );
+        else if( !strncmp( argv[ii], "--benchmark-", 12 ) )
+            benchmark = argv[ii] + 12;
+        else
+            return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
 
     auto brd = KI_TEST::ReadBoardFromFileOrStream( filename );
 
     if( !brd )
         return POLY_GEN_RET_CODES::LOAD_FAILED;
 
+    if( !benchmark.empty() )
+    {
+        BENCH_RUNNER runner( std::chrono::milliseconds( minTime ) );
+        std::string  name = wxFileName( filename ).GetName().ToStdString();
+        int          ret;
+
+        if( benchmark == "booleans" )
+            ret = benchmarkBooleans( runner, brd.get(), name );
+        else if( benchmark == "fracture" )
+            ret = benchmarkFracture( runner, brd.get(), name );
+        else if( benchmark == "primitives" )
+            ret = benchmarkPrimitives( runner, brd.get(), name );
+        else
+            return KI_TEST::RET_CODES::BAD_CMDLINE;
+
+        if( !jsonFile.empty() && !runner.WriteJson( jsonFile ) )
+        {
+            std::cerr << "Could not write " << jsonFile << std::endl;
+            return POLY_GEN_RET_CODES::WRITE_FAILED;
+        }
+
+        return ret;
+    }
+
     for( unsigned net = 0; net < brd->GetNetCount(); net++ )
     {
         for( PCB_TRACK* track : brd->Tracks() )
@@ -94,6 +760,9 @@ int polygon_gererator_main( int argc, char* argv[] )
 
 static bool registered = UTILITY_REGISTRY::Register( {
         "polygon_generator",
-        "Dump board geometry as a set of polygons",
+        "Dump board geometry as a set of polygons, or time the geometry library on it with "
+        "--benchmark-booleans, --benchmark-fracture or --benchmark-primitives (options: "
+        "--json <file> writes a Google Benchmark style report, --min-time <ms> sets the "
+        "minimum time per benchmark)",
         polygon_gererator_main,
 } );